@@ -0,0 +1,89 @@
+#ifndef WOW_SIMULATOR_TASK_POOL_HPP
+#define WOW_SIMULATOR_TASK_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// runs independent tasks on n_threads worker threads. every worker has a deque of its own: it runs the newest of its
+// tasks and, once it has none left, steals the oldest task of another worker. tasks submitted from outside are dealt
+// out round-robin, tasks submitted by a task go to the deque of its worker.
+// a thread which waits for a result runs queued tasks in the meantime, so tasks can wait for tasks they submitted, and
+// a pool without threads runs every task in the thread waiting for it (e.g. without thread support).
+class Task_pool
+{
+public:
+    explicit Task_pool(int n_threads);
+
+    // runs the tasks which are still queued
+    ~Task_pool();
+
+    Task_pool(const Task_pool&) = delete;
+    Task_pool& operator=(const Task_pool&) = delete;
+
+    template <typename F>
+    std::future<std::invoke_result_t<F>> submit(F&& f)
+    {
+        using Result = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(f));
+        auto future = task->get_future();
+        push([task]() { (*task)(); });
+        return future;
+    }
+
+    // future.get(), running queued tasks until it's ready. deferred futures are run right away. with nothing to run,
+    // the thread sleeps until a task is queued or finishes, so the future has to be one of submit (or deferred)
+    template <typename T>
+    T wait(std::future<T>& future)
+    {
+        auto ready = [&future]() { return future.wait_for(std::chrono::seconds(0)) != std::future_status::timeout; };
+        while (!ready())
+        {
+            if (run_one()) continue;
+
+            std::unique_lock<std::mutex> lock(idle_mutex_);
+            ++n_waiting_;
+            changed_.wait(lock, [&]() { return n_queued_ > 0 || ready(); });
+            --n_waiting_;
+        }
+        return future.get();
+    }
+
+    [[nodiscard]] int n_threads() const { return static_cast<int>(threads_.size()); }
+
+private:
+    using Task = std::function<void()>;
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void push(Task task);
+
+    // runs a task of the calling worker (or steals one), false if all queues were empty
+    bool run_one();
+
+    void work(size_t index);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_t> next_queue_{0};
+    std::atomic<int> n_queued_{0};
+
+    std::mutex idle_mutex_;
+    std::condition_variable idle_; // workers without tasks
+    std::condition_variable changed_; // threads in wait, woken when a task is queued or finishes
+    int n_waiting_{};
+    bool stop_{};
+};
+
+#endif // WOW_SIMULATOR_TASK_POOL_HPP
@@ -0,0 +1,111 @@
+#include "task_pool.hpp"
+
+#include <algorithm>
+
+namespace
+{
+// the pool and the queue of the calling thread, if it's a worker
+thread_local const Task_pool* current_pool = nullptr;
+thread_local size_t current_queue = 0;
+} // namespace
+
+Task_pool::Task_pool(int n_threads)
+{
+    const auto n_queues = static_cast<size_t>(std::max(n_threads, 1));
+    queues_.reserve(n_queues);
+    for (size_t i = 0; i < n_queues; ++i)
+    {
+        queues_.emplace_back(std::make_unique<Queue>());
+    }
+    threads_.reserve(static_cast<size_t>(std::max(n_threads, 0)));
+    for (int i = 0; i < n_threads; ++i)
+    {
+        threads_.emplace_back([this, i]() { work(static_cast<size_t>(i)); });
+    }
+}
+
+Task_pool::~Task_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        stop_ = true;
+    }
+    idle_.notify_all();
+    for (auto& thread : threads_)
+    {
+        thread.join();
+    }
+    while (run_one())
+    {
+    }
+}
+
+void Task_pool::push(Task task)
+{
+    const auto index = current_pool == this ? current_queue : next_queue_++ % queues_.size();
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    ++n_queued_;
+    bool waiting = false;
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        waiting = n_waiting_ > 0;
+    }
+    idle_.notify_one();
+    if (waiting) changed_.notify_all();
+}
+
+bool Task_pool::run_one()
+{
+    const bool is_worker = current_pool == this;
+    const auto home = is_worker ? current_queue : 0;
+
+    Task task;
+    for (size_t i = 0; i < queues_.size() && !task; ++i)
+    {
+        auto& queue = *queues_[(home + i) % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+
+        // the newest own task is likely to share data with the last one, stolen tasks are the oldest
+        if (is_worker && i == 0)
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+    if (!task) return false;
+
+    --n_queued_;
+    task();
+
+    // the future of the task is ready now, a thread in wait may be waiting for it
+    bool waiting = false;
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        waiting = n_waiting_ > 0;
+    }
+    if (waiting) changed_.notify_all();
+    return true;
+}
+
+void Task_pool::work(size_t index)
+{
+    current_pool = this;
+    current_queue = index;
+    while (true)
+    {
+        if (run_one()) continue;
+
+        std::unique_lock<std::mutex> lock(idle_mutex_);
+        idle_.wait(lock, [this]() { return stop_ || n_queued_ > 0; });
+        if (stop_ && n_queued_ <= 0) return;
+    }
+}
@@ -1,4 +1,5 @@
 #include "find_values.hpp"
+#include "task_pool.hpp"
 
 #include "gtest/gtest.h"
 
@@ -44,4 +45,64 @@ TEST(TestSuite, test_find_value_class)
         EXPECT_TRUE(fv.find("destroyer_greaves") == 8.0);
         EXPECT_TRUE(fv.find("warboots_of_obliteration") == 9.0);
     }
-}
\ No newline at end of file
+}
+
+TEST(TestSuite, test_task_pool)
+{
+    for (int n_threads : {0, 1, 4})
+    {
+        Task_pool pool{n_threads};
+        std::vector<std::future<int>> results;
+        for (int i = 0; i < 100; ++i)
+        {
+            results.push_back(pool.submit([i]() { return i * i; }));
+        }
+        for (int i = 0; i < 100; ++i)
+        {
+            EXPECT_EQ(pool.wait(results[i]), i * i);
+        }
+    }
+}
+
+TEST(TestSuite, test_task_pool_nested)
+{
+    // tasks waiting for their own tasks don't block the pool, even with a single thread
+    for (int n_threads : {0, 1, 3})
+    {
+        Task_pool pool{n_threads};
+        std::vector<std::future<int>> sums;
+        for (int i = 0; i < 10; ++i)
+        {
+            sums.push_back(pool.submit([&pool, i]() {
+                std::vector<std::future<int>> parts;
+                for (int j = 0; j < 10; ++j)
+                {
+                    parts.push_back(pool.submit([i, j]() { return i * j; }));
+                }
+                int sum = 0;
+                for (auto& part : parts)
+                {
+                    sum += pool.wait(part);
+                }
+                return sum;
+            }));
+        }
+        for (int i = 0; i < 10; ++i)
+        {
+            EXPECT_EQ(pool.wait(sums[i]), 45 * i);
+        }
+    }
+}
+
+TEST(TestSuite, test_task_pool_wait_sleeps)
+{
+    // nothing to run meanwhile, the waiting thread is woken by the worker finishing the task
+    Task_pool pool{1};
+    auto slow = pool.submit([]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return 7;
+    });
+    auto blocked = pool.submit([]() { return 8; });
+    EXPECT_EQ(pool.wait(slow), 7);
+    EXPECT_EQ(pool.wait(blocked), 8);
+}
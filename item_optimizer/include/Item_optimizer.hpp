@@ -2,6 +2,21 @@
 #define WOW_SIMULATOR_ITEM_OPTIMIZER_HPP
 
 #include "Armory.hpp"
+#include "Character.hpp"
+#include "Config.hpp"
+#include "Distribution.hpp"
+
+#include <functional>
+
+class Task_pool;
+
+// a complete set of gear found by Item_optimizer::optimize_gear
+struct Gear_setup
+{
+    Character character;
+    double ap_equivalent; // see get_character_ap_equivalent
+    Distribution dps;
+};
 
 class Item_optimizer
 {
@@ -15,6 +30,18 @@ public:
 
     static std::vector<Armor> remove_weaker_items(const std::vector<Armor>& armors, const Special_stats& special_stats,
                                            std::string& debug_message, int keep_n_stronger_items, const std::function<bool(const Armor&)>& filter = no_armors);
+
+    // searches the items of all sockets at once (rings and trinkets as pairs, with set bonuses, hit and expertise caps
+    // and use and hit effects) for the n_setups setups with the highest get_character_ap_equivalent, then simulates them
+    // and returns them best first. the character keeps its weapon setup (dual wield or two-hand), enchants, gems and
+    // buffs. items are first thinned out per socket like in remove_weaker_items, then the search is a branch-and-bound:
+    // a branch is cut once even the most the remaining sockets can add (each socket on its own, see
+    // estimate_special_stats_upper_bound, or the most of every stat together under the caps) doesn't reach the n_setups
+    // best setups found so far. weapon setups are searched in parallel on the pool
+    static std::vector<Gear_setup> optimize_gear(const Armory& armory, const Character& character,
+                                                 const Combat_simulator_config& config, Task_pool& pool, int n_setups,
+                                                 int keep_n_stronger_items, std::string& debug_message, const std::function<bool(const Armor&)>& armor_filter,
+                                                 const std::function<bool(const Weapon&)>& weapon_filter);
 };
 
 #endif // WOW_SIMULATOR_ITEM_OPTIMIZER_HPP
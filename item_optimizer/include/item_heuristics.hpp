@@ -26,6 +26,12 @@ double estimate_special_stats_high(const Special_stats& special_stats);
 
 double estimate_special_stats_low(const Special_stats& special_stats);
 
+// the most special_stats can add to get_character_ap_equivalent with these weapons: hit and crit at their uncapped
+// weights, and hit and expertise also for the crit they move below the crit cap
+double estimate_special_stats_upper_bound(const Special_stats& special_stats, const Weapon& mh_wep, const Weapon& oh_wep);
+
+double estimate_special_stats_upper_bound(const Special_stats& special_stats, const Weapon& mh_wep);
+
 double estimate_stat_diff(Special_stats special_stats1, Special_stats special_stats2);
 
 #endif // WOW_SIMULATOR_INTERFACE_HELPER_H
@@ -1,7 +1,18 @@
 #include "Item_optimizer.hpp"
 
+#include "Combat_simulator.hpp"
+#include "Stat_composition.hpp"
+#include "Use_effects.hpp"
 #include "item_heuristics.hpp"
 #include "string_helpers.hpp"
+#include "task_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <sstream>
 
 struct Weapon_struct
 {
@@ -230,3 +241,640 @@ std::vector<Armor> Item_optimizer::remove_weaker_items(const std::vector<Armor>&
     }
     return filtered_armors;
 }
+
+double get_character_ap_equivalent(const Character& character, double sim_time)
+{
+    if (character.is_dual_wield())
+    {
+        return get_character_ap_equivalent(character.total_special_stats, character.weapons[0], character.weapons[1],
+                                           sim_time, character.use_effects);
+    }
+    return get_character_ap_equivalent(character.total_special_stats, character.weapons[0], sim_time,
+                                       character.use_effects);
+}
+
+// the stats get_character_ap_equivalent reads, each the larger (or smaller) one of a and b
+Special_stats upper_envelope(const Special_stats& a, const Special_stats& b)
+{
+    Special_stats ss{};
+    ss.critical_strike = std::max(a.critical_strike, b.critical_strike);
+    ss.hit = std::max(a.hit, b.hit);
+    ss.attack_power = std::max(a.attack_power, b.attack_power);
+    ss.bonus_damage = std::max(a.bonus_damage, b.bonus_damage);
+    ss.expertise = std::max(a.expertise, b.expertise);
+    ss.sword_expertise = std::max(a.sword_expertise, b.sword_expertise);
+    ss.mace_expertise = std::max(a.mace_expertise, b.mace_expertise);
+    ss.axe_expertise = std::max(a.axe_expertise, b.axe_expertise);
+    return ss;
+}
+
+Special_stats lower_envelope(const Special_stats& a, const Special_stats& b)
+{
+    Special_stats ss{};
+    ss.critical_strike = std::min(a.critical_strike, b.critical_strike);
+    ss.hit = std::min(a.hit, b.hit);
+    ss.attack_power = std::min(a.attack_power, b.attack_power);
+    ss.bonus_damage = std::min(a.bonus_damage, b.bonus_damage);
+    ss.expertise = std::min(a.expertise, b.expertise);
+    ss.sword_expertise = std::min(a.sword_expertise, b.sword_expertise);
+    ss.mace_expertise = std::min(a.mace_expertise, b.mace_expertise);
+    ss.axe_expertise = std::min(a.axe_expertise, b.axe_expertise);
+    return ss;
+}
+
+// get_character_ap_equivalent grows with every stat it reads, except that expertise stops counting once it removes
+// all dodges
+bool below_dodge_cap(const Special_stats& ss)
+{
+    const double expertise = ss.expertise + std::max({ss.sword_expertise, ss.mace_expertise, ss.axe_expertise});
+    return expertise < 26;
+}
+
+// the candidates of a socket of the character. rings and trinkets are two sockets next to each other, the second one
+// only takes the candidates after the one of the first (so every pair is tried once)
+struct Gear_socket
+{
+    Socket socket;
+    bool first_slot;
+    bool first_of_pair;
+    bool second_of_pair;
+    std::vector<Armor> items;
+};
+
+// an item in the search below a weapon setup. the most it adds to the ap equivalent is split up in what its stats can
+// add to the total attack power, what its set bonuses can add and the value of its use and hit effects, which grows
+// linearly with the total attack power. shared use effects are kept apart, only the best one counts
+struct Gear_option
+{
+    [[nodiscard]] double own_effects(double total_ap) const { return effects + effects_per_ap * total_ap; }
+    [[nodiscard]] double shared_effects(double total_ap) const { return shared + shared_per_ap * total_ap; }
+
+    const Armor* armor;
+    Special_stats special_stats;
+    Special_stats upper_stats; // with the set bonuses, only what the heuristic reads
+    double stats;
+    double set_bonus;
+    double effects;
+    double effects_per_ap;
+    double shared;
+    double shared_per_ap;
+    double bound; // at the highest total attack power of the weapon setup
+};
+
+// the sockets and their options (highest bound first) with a weapon setup
+struct Gear_tree
+{
+    Gear_tree(const Armory& armory, const Character& empty_character, const std::vector<Weapon>& weapons,
+              const std::vector<Gear_socket>& gear_sockets, double sim_time);
+
+    // what the character with these total stats is worth, without the armor's set bonuses and effects
+    [[nodiscard]] double ap_equivalent(const Special_stats& special_stats) const
+    {
+        if (character.is_dual_wield())
+        {
+            return get_character_ap_equivalent(special_stats, character.weapons[0], character.weapons[1], sim_time,
+                                               character.use_effects);
+        }
+        return get_character_ap_equivalent(special_stats, character.weapons[0], sim_time, character.use_effects);
+    }
+
+    // the total attack power the use and hit effects see
+    [[nodiscard]] double total_ap(const Special_stats& special_stats) const
+    {
+        if (plain_weapons.size() == 2)
+        {
+            return get_character_ap_equivalent(special_stats, plain_weapons[0], plain_weapons[1], sim_time, {});
+        }
+        return get_character_ap_equivalent(special_stats, plain_weapons[0], sim_time, {});
+    }
+
+    // the most a socket can add to the ap equivalent with the effects at total_ap, shared use effects not included
+    [[nodiscard]] double value(const Gear_option& option, double total_ap) const
+    {
+        return ap_factor * (option.stats + option.set_bonus) + option.own_effects(total_ap);
+    }
+
+    Character character; // wears the weapons and empty armor
+    std::vector<Weapon> plain_weapons;
+    double sim_time;
+    double ap_factor;
+    std::vector<std::vector<Gear_option>> options;
+    std::vector<double> remaining_stats; // the most options[i..] can add to the total attack power
+    std::vector<Special_stats> remaining_upper_stats; // the most options[i..] can add to each stat
+    std::vector<std::vector<Special_stats>> pair_upper_stats; // the most options[i][k..] add to each stat
+    std::vector<double> remaining_bound; // the most options[i..] can add at the highest total attack power
+    double root_bound;
+};
+
+Gear_tree::Gear_tree(const Armory& armory, const Character& empty_character, const std::vector<Weapon>& weapons,
+                     const std::vector<Gear_socket>& gear_sockets, double sim_time)
+    : character(empty_character), sim_time(sim_time)
+{
+    character.weapons = weapons;
+    armory.compute_total_stats(character);
+    const auto& special_stats = character.total_special_stats;
+    plain_weapons = character.weapons;
+    for (auto& weapon : plain_weapons)
+    {
+        weapon.hit_effects.clear();
+    }
+
+    auto stats_bound = [this](const Special_stats& ss) {
+        return character.is_dual_wield() ?
+                   estimate_special_stats_upper_bound(ss, character.weapons[0], character.weapons[1]) :
+                   estimate_special_stats_upper_bound(ss, character.weapons[0]);
+    };
+    auto hit_effect_ap = [this](const Hit_effect& hit_effect, double total_ap) {
+        double ap = 0;
+        for (size_t i = 0; i < character.weapons.size(); ++i)
+        {
+            ap += get_hit_effect_ap_equivalent(hit_effect, total_ap, character.weapons[i].swing_speed, i == 0 ? 1.0 : 0.5);
+        }
+        return ap;
+    };
+
+    // the use and hit effects which don't depend on the armor grow linearly with the total attack power, so every
+    // point of attack power the armor adds is worth ap_factor
+    ap_factor = (ap_equivalent(special_stats + Special_stats{0, 0, 1000}) - ap_equivalent(special_stats)) / 1000;
+
+    options.resize(gear_sockets.size());
+    for (size_t i = 0; i < gear_sockets.size(); ++i)
+    {
+        for (const auto& item : gear_sockets[i].items)
+        {
+            Gear_option option{&item, item.special_stats + item.attributes.to_special_stats(special_stats), {}, 0, 0, 0, 0, 0, 0, 0};
+            if (item.name == "braided_eternium_chain")
+            {
+                option.special_stats += armory.buffs.braided_eternium_chain.special_stats;
+            }
+            option.stats = stats_bound(option.special_stats);
+            option.upper_stats = upper_envelope(option.special_stats, {});
+
+            // effects are linear in the total attack power, so two points describe them
+            auto add_effects = [&](double& at_zero, double& per_ap, auto value) {
+                at_zero += value(0.0);
+                per_ap += (value(1000.0) - value(0.0)) / 1000;
+            };
+            for (const auto& use_effect : item.use_effects)
+            {
+                auto value = [&](double total_ap) {
+                    return Use_effects::get_use_effect_ap_equivalent(use_effect, special_stats, total_ap,
+                                                                     static_cast<int>(sim_time));
+                };
+                if (use_effect.effect_socket == Use_effect::Effect_socket::shared)
+                {
+                    add_effects(option.shared, option.shared_per_ap, value);
+                }
+                else
+                {
+                    add_effects(option.effects, option.effects_per_ap, value);
+                }
+            }
+            for (const auto& hit_effect : item.hit_effects)
+            {
+                add_effects(option.effects, option.effects_per_ap,
+                            [&](double total_ap) { return hit_effect_ap(hit_effect, total_ap); });
+            }
+            if (item.set_name != Set::none)
+            {
+                // every piece counts the whole set bonus
+                for (const auto& set_bonus : armory.set_bonuses)
+                {
+                    if (set_bonus.set != item.set_name) continue;
+                    const auto set_stats = set_bonus.special_stats + set_bonus.attributes.to_special_stats(special_stats);
+                    option.set_bonus += stats_bound(set_stats);
+                    option.upper_stats += upper_envelope(set_stats, {});
+                    if (set_bonus.hit_effect.type != Hit_effect::Type::none)
+                    {
+                        add_effects(option.effects, option.effects_per_ap,
+                                    [&](double total_ap) { return hit_effect_ap(set_bonus.hit_effect, total_ap); });
+                    }
+                }
+            }
+            options[i].push_back(option);
+        }
+    }
+
+    remaining_stats.assign(gear_sockets.size() + 1, 0);
+    remaining_upper_stats.assign(gear_sockets.size() + 1, {});
+    for (size_t i = gear_sockets.size(); i-- > 0;)
+    {
+        std::vector<double> stats;
+        for (const auto& option : options[i])
+        {
+            stats.push_back(option.stats + option.set_bonus);
+        }
+        std::sort(stats.begin(), stats.end(), std::greater<>());
+        remaining_stats[i] = remaining_stats[i + 1] + stats[gear_sockets[i].second_of_pair ? 1 : 0];
+
+        // the second of a pair adds the second most of each stat
+        Special_stats first{};
+        Special_stats second{};
+        for (const auto& option : options[i])
+        {
+            second = upper_envelope(second, lower_envelope(first, option.upper_stats));
+            first = upper_envelope(first, option.upper_stats);
+        }
+        remaining_upper_stats[i] = remaining_upper_stats[i + 1] + (gear_sockets[i].second_of_pair ? second : first);
+    }
+
+    const double max_total_ap = total_ap(special_stats) + remaining_stats[0];
+    for (auto& socket_options : options)
+    {
+        for (auto& option : socket_options)
+        {
+            option.bound = value(option, max_total_ap) + option.shared_effects(max_total_ap);
+        }
+        std::sort(socket_options.begin(), socket_options.end(), [](const auto& a, const auto& b) { return a.bound > b.bound; });
+    }
+
+    pair_upper_stats.resize(gear_sockets.size());
+    for (size_t i = 0; i < gear_sockets.size(); ++i)
+    {
+        if (!gear_sockets[i].first_of_pair) continue;
+        pair_upper_stats[i].assign(options[i].size() + 1, {});
+        for (size_t k = options[i].size(); k-- > 0;)
+        {
+            pair_upper_stats[i][k] = upper_envelope(pair_upper_stats[i][k + 1], options[i][k].upper_stats);
+        }
+    }
+
+    remaining_bound.assign(gear_sockets.size() + 1, 0);
+    for (size_t i = gear_sockets.size(); i-- > 0;)
+    {
+        remaining_bound[i] = remaining_bound[i + 1] + options[i][gear_sockets[i].second_of_pair ? 1 : 0].bound;
+    }
+    root_bound = ap_equivalent(special_stats) + remaining_bound[0];
+}
+
+struct Gear_candidate
+{
+    double ap_equivalent;
+    size_t weapon_setup;
+    std::vector<const Armor*> armor;
+};
+
+// the n_setups best setups found so far, shared by the searches below all weapon setups
+struct Gear_search
+{
+    // composition wears the chosen armor, character is dressed for the setups which can be among the best
+    void search(const Gear_tree& tree, size_t weapon_setup, size_t depth, const Special_stats& special_stats,
+                const Special_stats& upper_stats, size_t previous, std::vector<const Gear_option*>& chosen,
+                Stat_composition& composition, Character& character);
+
+    void offer(Gear_candidate candidate);
+
+    const Armory& armory;
+    const std::vector<Gear_socket>& gear_sockets;
+    size_t n_setups;
+    std::mutex mutex{};
+    std::vector<Gear_candidate> best{}; // highest ap equivalent first
+    std::atomic<double> threshold{std::numeric_limits<double>::lowest()};
+    std::atomic<long long> n_evaluated{};
+};
+
+void Gear_search::search(const Gear_tree& tree, size_t weapon_setup, size_t depth, const Special_stats& special_stats,
+                         const Special_stats& upper_stats, size_t previous, std::vector<const Gear_option*>& chosen,
+                         Stat_composition& composition, Character& character)
+{
+    if (depth == gear_sockets.size())
+    {
+        // the composition wears the chosen armor, its stats are exact. the effects are valued as in the bounds
+        n_evaluated++;
+        const auto total_special_stats = composition.total_special_stats();
+        const double total_ap = tree.total_ap(total_special_stats);
+        double estimate = tree.ap_equivalent(total_special_stats);
+        double shared_effects = 0;
+        for (const auto* option : chosen)
+        {
+            estimate += option->own_effects(total_ap);
+            shared_effects = std::max(shared_effects, option->shared_effects(total_ap));
+        }
+        if (estimate + shared_effects <= threshold) return;
+
+        // only a setup which can be among the best dresses the character of the search. every socket is overwritten
+        // and compute_total_stats reuses its buffers, only the buff of a braided eternium chain has to go
+        character.buffs.erase(character.buffs.begin() + static_cast<std::ptrdiff_t>(tree.character.buffs.size()),
+                              character.buffs.end());
+        for (size_t i = 0; i < chosen.size(); ++i)
+        {
+            Armory::change_armor(character.armor, *chosen[i]->armor, gear_sockets[i].first_slot);
+        }
+        armory.compute_total_stats(character);
+        const double ap_equivalent = get_character_ap_equivalent(character, tree.sim_time);
+        if (ap_equivalent <= threshold) return;
+
+        std::vector<const Armor*> armor;
+        armor.reserve(chosen.size());
+        for (const auto* option : chosen)
+        {
+            armor.push_back(option->armor);
+        }
+        offer({ap_equivalent, weapon_setup, std::move(armor)});
+        return;
+    }
+
+    // the effects are valued at the most total attack power which can be reached from here
+    const Special_stats& remaining = tree.remaining_upper_stats[depth];
+    const double total_ap = std::min(tree.total_ap(special_stats) + tree.remaining_stats[depth],
+                                     tree.total_ap(upper_stats + remaining));
+    const double node = tree.ap_equivalent(special_stats);
+    double chosen_set_bonus = 0;
+    double chosen_effects = 0;
+    double shared_effects = 0;
+    for (size_t i = 0; i < depth; ++i)
+    {
+        chosen_set_bonus += tree.ap_factor * chosen[i]->set_bonus;
+        chosen_effects += chosen[i]->own_effects(total_ap);
+        shared_effects = std::max(shared_effects, chosen[i]->shared_effects(total_ap));
+    }
+
+    // the sockets after this one (and its second ring or trinket)
+    const auto& socket = gear_sockets[depth];
+    const size_t next = depth + (socket.first_of_pair ? 2 : 1);
+    double rest = 0;
+    double rest_effects = 0;
+    for (size_t i = next; i < gear_sockets.size(); ++i)
+    {
+        const size_t n = gear_sockets[i].first_of_pair ? 2 : 1;
+        double best[2] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+        double best_effects[2] = {0, 0};
+        for (const auto& option : tree.options[i])
+        {
+            const double value = tree.value(option, total_ap);
+            if (value > best[1]) best[1] = value;
+            if (best[1] > best[0]) std::swap(best[0], best[1]);
+            const double effects = option.own_effects(total_ap);
+            if (effects > best_effects[1]) best_effects[1] = effects;
+            if (best_effects[1] > best_effects[0]) std::swap(best_effects[0], best_effects[1]);
+            shared_effects = std::max(shared_effects, option.shared_effects(total_ap));
+        }
+        for (size_t j = 0; j < n; ++j)
+        {
+            rest += best[j];
+            rest_effects += best_effects[j];
+        }
+        i += n - 1;
+    }
+
+    // with the first of a pair, the best second one after each option
+    const auto& options = tree.options[depth];
+    std::vector<double> pair_value;
+    std::vector<double> pair_effects;
+    std::vector<double> pair_shared;
+    if (socket.first_of_pair)
+    {
+        pair_value.assign(options.size() + 1, std::numeric_limits<double>::lowest());
+        pair_effects.assign(options.size() + 1, 0);
+        pair_shared.assign(options.size() + 1, 0);
+        for (size_t k = options.size(); k-- > 0;)
+        {
+            pair_value[k] = std::max(pair_value[k + 1], tree.value(options[k], total_ap));
+            pair_effects[k] = std::max(pair_effects[k + 1], options[k].own_effects(total_ap));
+            pair_shared[k] = std::max(pair_shared[k + 1], options[k].shared_effects(total_ap));
+        }
+    }
+
+    const double loose_node = node + chosen_set_bonus + chosen_effects + shared_effects;
+    const bool capped_bound = below_dodge_cap(upper_stats + remaining);
+    for (size_t k = socket.second_of_pair ? previous + 1 : 0; k < options.size(); ++k)
+    {
+        const auto& option = options[k];
+
+        // the options are sorted, so once one can't reach the best setups at the highest total attack power none of
+        // the rest can
+        double loose_bound = loose_node + option.bound + tree.remaining_bound[next];
+        if (socket.first_of_pair)
+        {
+            if (k + 1 == options.size()) break;
+            loose_bound += options[k + 1].bound;
+        }
+        if (loose_bound <= threshold) break;
+
+        // each stat summed up separately, or all of them together where the hit and crit caps apply
+        double bound = node + chosen_set_bonus + tree.value(option, total_ap) + rest;
+        double effects = option.own_effects(total_ap) + rest_effects;
+        double shared = std::max(shared_effects, option.shared_effects(total_ap));
+        Special_stats reachable = upper_stats + option.upper_stats + tree.remaining_upper_stats[next];
+        if (socket.first_of_pair)
+        {
+            bound += pair_value[k + 1];
+            effects += pair_effects[k + 1];
+            shared = std::max(shared, pair_shared[k + 1]);
+            reachable += tree.pair_upper_stats[depth][k + 1];
+        }
+        if (capped_bound) bound = std::min(bound, tree.ap_equivalent(reachable) + effects);
+        if (bound + chosen_effects + shared <= threshold) continue;
+
+        chosen[depth] = &option;
+        composition.add(*option.armor);
+        search(tree, weapon_setup, depth + 1, special_stats + option.special_stats, upper_stats + option.upper_stats, k,
+               chosen, composition, character);
+        composition.remove(*option.armor);
+    }
+}
+
+void Gear_search::offer(Gear_candidate candidate)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (best.size() == n_setups && candidate.ap_equivalent <= best.back().ap_equivalent) return;
+
+    auto it = std::upper_bound(best.begin(), best.end(), candidate.ap_equivalent,
+                               [](double ap, const auto& c) { return ap > c.ap_equivalent; });
+    best.insert(it, std::move(candidate));
+    if (best.size() > n_setups) best.pop_back();
+    if (best.size() == n_setups) threshold = best.back().ap_equivalent;
+}
+
+std::vector<Gear_setup> Item_optimizer::optimize_gear(const Armory& armory, const Character& character,
+                                                      const Combat_simulator_config& config, Task_pool& pool,
+                                                      int n_setups, int keep_n_stronger_items, std::string& debug_message,
+                                                      const std::function<bool(const Armor&)>& armor_filter,
+                                                      const std::function<bool(const Weapon&)>& weapon_filter)
+{
+    if (n_setups <= 0) return {};
+
+    // the armor is searched on a character without any
+    Character empty_character = character;
+    if (character.has_item("braided_eternium_chain"))
+    {
+        auto& buffs = empty_character.buffs;
+        buffs.erase(std::remove_if(buffs.begin(), buffs.end(),
+                                   [](const Buff& b) { return b.name == "braided_eternium_chain"; }),
+                    buffs.end());
+    }
+
+    std::string dummy;
+    std::vector<Gear_socket> gear_sockets;
+    double n_possible = 1;
+    for (size_t i = 0; i < character.armor.size(); ++i)
+    {
+        const auto socket = character.armor[i].socket;
+        const bool paired_socket = socket == Socket::ring || socket == Socket::trinket;
+        const bool second_slot = paired_socket && !gear_sockets.empty() && gear_sockets.back().socket == socket;
+        Armory::change_armor(empty_character.armor, Armor::empty(socket), !second_slot);
+        if (second_slot)
+        {
+            gear_sockets.back().first_of_pair = true;
+            gear_sockets.push_back({socket, false, false, true, gear_sockets.back().items});
+            continue;
+        }
+
+        const auto& items = armory.get_items_in_socket(socket);
+        const auto n = static_cast<double>(std::count_if(items.begin(), items.end(), [&](const Armor& a) { return !armor_filter(a); }));
+        n_possible *= paired_socket ? n * (n - 1) / 2 : n;
+
+        // a setup with an item which is weaker than one it could wear instead can't be the best
+        const int copies = paired_socket ? 2 : 1;
+        Gear_socket gear_socket{socket, true, false, false,
+                                remove_weaker_items(items, character.total_special_stats, dummy,
+                                                    keep_n_stronger_items + copies - 1, armor_filter)};
+        if (gear_socket.items.size() < static_cast<size_t>(copies))
+        {
+            // nothing to choose from, the socket stays as it is
+            Armory::change_armor(empty_character.armor, character.armor[i], true);
+            if (paired_socket && i + 1 < character.armor.size() && character.armor[i + 1].socket == socket)
+            {
+                Armory::change_armor(empty_character.armor, character.armor[++i], false);
+            }
+            continue;
+        }
+        gear_sockets.push_back(std::move(gear_socket));
+    }
+
+    // the sockets with the most candidates go first. those are the trinkets, whose use effects the bound can only
+    // guess until they are chosen
+    std::vector<std::vector<Gear_socket>> socket_groups;
+    for (auto& gear_socket : gear_sockets)
+    {
+        if (gear_socket.second_of_pair)
+        {
+            socket_groups.back().push_back(std::move(gear_socket));
+        }
+        else
+        {
+            socket_groups.push_back({std::move(gear_socket)});
+        }
+    }
+    std::stable_sort(socket_groups.begin(), socket_groups.end(),
+                     [](const auto& a, const auto& b) { return a[0].items.size() > b[0].items.size(); });
+    gear_sockets.clear();
+    for (auto& group : socket_groups)
+    {
+        for (auto& gear_socket : group)
+        {
+            gear_sockets.push_back(std::move(gear_socket));
+        }
+    }
+
+    auto count_weapons = [&weapon_filter](const std::vector<Weapon>& weapons) {
+        return static_cast<double>(std::count_if(weapons.begin(), weapons.end(), [&](const Weapon& w) { return !weapon_filter(w); }));
+    };
+    std::vector<std::vector<Weapon>> weapon_setups;
+    if (character.is_dual_wield())
+    {
+        const auto all_main_hands = armory.get_weapon_in_socket(Weapon_socket::main_hand);
+        const auto all_off_hands = armory.get_weapon_in_socket(Weapon_socket::off_hand);
+        n_possible *= count_weapons(all_main_hands) * count_weapons(all_off_hands);
+        const auto main_hands = remove_weaker_weapons(Weapon_socket::main_hand, all_main_hands, character.total_special_stats,
+                                                      dummy, keep_n_stronger_items, weapon_filter);
+        const auto off_hands = remove_weaker_weapons(Weapon_socket::off_hand, all_off_hands, character.total_special_stats,
+                                                     dummy, keep_n_stronger_items, weapon_filter);
+        for (const auto& main_hand : main_hands)
+        {
+            for (const auto& off_hand : off_hands)
+            {
+                auto weapons = character.weapons;
+                Armory::change_weapon(weapons, main_hand, Socket::main_hand);
+                Armory::change_weapon(weapons, off_hand, Socket::off_hand);
+                weapon_setups.push_back(std::move(weapons));
+            }
+        }
+    }
+    else
+    {
+        const auto all_two_hands = armory.get_weapon_in_socket(Weapon_socket::two_hand);
+        n_possible *= count_weapons(all_two_hands);
+        for (const auto& two_hand : remove_weaker_weapons(Weapon_socket::two_hand, all_two_hands,
+                                                          character.total_special_stats, dummy, keep_n_stronger_items,
+                                                          weapon_filter))
+        {
+            auto weapons = character.weapons;
+            Armory::change_weapon(weapons, two_hand, Socket::main_hand);
+            weapon_setups.push_back(std::move(weapons));
+        }
+    }
+    if (weapon_setups.empty()) weapon_setups.push_back(character.weapons);
+
+    // the most promising weapon setups are searched first, so the rest is cut early
+    std::vector<std::future<double>> root_bounds;
+    root_bounds.reserve(weapon_setups.size());
+    for (const auto& weapons : weapon_setups)
+    {
+        root_bounds.push_back(pool.submit([&, weapons]() {
+            return Gear_tree{armory, empty_character, weapons, gear_sockets, config.sim_time}.root_bound;
+        }));
+    }
+    std::vector<std::pair<double, size_t>> order;
+    order.reserve(weapon_setups.size());
+    for (size_t i = 0; i < weapon_setups.size(); ++i)
+    {
+        order.emplace_back(pool.wait(root_bounds[i]), i);
+    }
+    std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    Gear_search search{armory, gear_sockets, static_cast<size_t>(n_setups)};
+    std::atomic<int> n_searched{};
+    std::vector<std::future<void>> searches;
+    searches.reserve(order.size());
+    for (const auto& [root_bound, i] : order)
+    {
+        searches.push_back(pool.submit([&, root_bound = root_bound, i = i]() {
+            if (root_bound <= search.threshold) return;
+            n_searched++;
+            const Gear_tree tree{armory, empty_character, weapon_setups[i], gear_sockets, config.sim_time};
+            std::vector<const Gear_option*> chosen(gear_sockets.size());
+            Stat_composition composition{armory, tree.character};
+            composition.add_items(tree.character);
+            auto character = tree.character;
+            search.search(tree, i, 0, tree.character.total_special_stats, tree.character.total_special_stats, 0, chosen,
+                          composition, character);
+        }));
+    }
+    for (auto& s : searches)
+    {
+        pool.wait(s);
+    }
+
+    std::ostringstream stream;
+    stream << "Searched below " << n_searched << " of " << weapon_setups.size() << " weapon setups and estimated "
+           << search.n_evaluated << " of " << std::setprecision(3) << n_possible << " setups.<br>";
+    debug_message += stream.str();
+
+    // the best estimates are simulated
+    std::vector<Gear_setup> setups;
+    std::vector<std::future<Distribution>> dps;
+    setups.reserve(search.best.size());
+    dps.reserve(search.best.size());
+    for (const auto& candidate : search.best)
+    {
+        Character setup_character = empty_character;
+        setup_character.weapons = weapon_setups[candidate.weapon_setup];
+        for (size_t i = 0; i < candidate.armor.size(); ++i)
+        {
+            Armory::change_armor(setup_character.armor, *candidate.armor[i], gear_sockets[i].first_slot);
+        }
+        armory.compute_total_stats(setup_character);
+        dps.push_back(pool.submit([&config, setup_character]() {
+            return Combat_simulator::simulate(config, setup_character);
+        }));
+        setups.push_back({std::move(setup_character), candidate.ap_equivalent, {}});
+    }
+    for (size_t i = 0; i < setups.size(); ++i)
+    {
+        setups[i].dps = pool.wait(dps[i]);
+    }
+    std::stable_sort(setups.begin(), setups.end(),
+                     [](const auto& a, const auto& b) { return a.dps.mean() > b.dps.mean(); });
+    return setups;
+}
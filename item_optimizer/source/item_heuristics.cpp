@@ -3,6 +3,7 @@
 #include "Use_effects.hpp"
 
 #include <algorithm>
+#include <cmath>
 
 double get_character_ap_equivalent(const Special_stats& special_stats, const Weapon& mh_wep, const Weapon& oh_wep,
                                    double sim_time, const std::vector<Use_effect>& use_effects)
@@ -263,6 +264,27 @@ double estimate_special_stats_low(const Special_stats& special_stats)
     return low_estimation;
 }
 
+double estimate_special_stats_upper_bound(const Special_stats& special_stats, double bonus_damage_w)
+{
+    // expertise counts in whole points, so a fraction can complete one
+    double expertise_points = std::ceil(std::max(special_stats.expertise, 0.0));
+
+    return special_stats.attack_power + special_stats.bonus_damage * bonus_damage_w +
+           std::max(special_stats.hit, 0.0) * (hit_w + crit_w - crit_w_cap) +
+           std::max(special_stats.critical_strike, 0.0) * crit_w +
+           expertise_points * 0.25 * (expertise_w + crit_w - crit_w_cap);
+}
+
+double estimate_special_stats_upper_bound(const Special_stats& special_stats, const Weapon& mh_wep, const Weapon& oh_wep)
+{
+    return estimate_special_stats_upper_bound(special_stats, 14 / mh_wep.swing_speed + 0.625 * 14 / oh_wep.swing_speed);
+}
+
+double estimate_special_stats_upper_bound(const Special_stats& special_stats, const Weapon& mh_wep)
+{
+    return estimate_special_stats_upper_bound(special_stats, 14 / mh_wep.swing_speed);
+}
+
 bool estimate_special_stats_smart_no_skill(const Special_stats& special_stats1, const Special_stats& special_stats2)
 {
     Special_stats diff = special_stats2 - special_stats1;
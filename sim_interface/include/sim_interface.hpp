@@ -1,13 +1,22 @@
 #ifndef MODEL_INTERFACE_HPP
 #define MODEL_INTERFACE_HPP
 
+#include "Distribution.hpp"
 #include "sim_input.hpp"
 #include "sim_output.hpp"
 
+#include <vector>
+
 class Sim_interface
 {
 public:
     Sim_output simulate(const Sim_input &input);
+
+    // simulates many variants of base in one call, which share the armory and the worker threads. a variant is a delta
+    // against base: its non-empty fields replace the ones of base, armor and weapons slot by slot (an empty name keeps
+    // the item of base). the fight settings (options and float options) are the ones of base.
+    // returns the dps of each variant, in order
+    std::vector<Distribution> simulate_variants(const Sim_input& base, const std::vector<Sim_input>& variants);
 };
 
 #endif // INTERFACE_HPP
@@ -44,6 +44,7 @@ struct Sim_output
     std::vector<double> dmg_sources;
     std::vector<std::string> time_lapse_names;
     std::vector<std::vector<double>> damage_time_lapse;
+    double time_lapse_resolution{0.5}; // bucket size of damage_time_lapse (in s)
     std::vector<std::string> aura_uptimes;
     std::vector<std::string> use_effect_order_string;
     std::vector<std::string> proc_counter;
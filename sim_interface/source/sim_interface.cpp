@@ -3,45 +3,63 @@
 #include "Armory.hpp"
 #include "Combat_simulator.hpp"
 #include "Item_optimizer.hpp"
+#include "Result_cache.hpp"
+#include "Stat_composition.hpp"
 #include "Statistics.hpp"
 #include "item_heuristics.hpp"
+#include "task_pool.hpp"
 
+#include <cassert>
+#include <future>
+#include <optional>
 #include <sstream>
 
 static const double q95 = Statistics::find_cdf_quantile(Statistics::get_two_sided_p_value(0.95), 0.01);
 
+// the order in which damage sources are listed in the results
+static const std::vector<std::pair<Damage_source, std::string>> damage_source_labels = {
+    {Damage_source::white_mh, "white MH"},
+    {Damage_source::white_oh, "white OH"},
+    {Damage_source::bloodthirst, "bloodthirst"},
+    {Damage_source::mortal_strike, "mortal strike"},
+    {Damage_source::sweeping_strikes, "sweeping strikes"},
+    {Damage_source::overpower, "overpower"},
+    {Damage_source::slam, "slam"},
+    {Damage_source::execute, "execute"},
+    {Damage_source::heroic_strike, "heroic strike"},
+    {Damage_source::cleave, "cleave"},
+    {Damage_source::whirlwind, "whirlwind"},
+    {Damage_source::hamstring, "hamstring"},
+    {Damage_source::deep_wounds, "deep wounds"},
+    {Damage_source::item_hit_effects, "item effects"},
+};
+
 #ifdef TEST_VIA_CONFIG
-void print_results(const Combat_simulator& sim, bool print_uptimes_and_procs)
+void print_results(const Sim_result& result, const Combat_simulator_config& config, bool print_uptimes_and_procs)
 {
-    auto dd = sim.get_damage_distribution();
+    const auto& dd = result.damage_sources;
 
-    auto f = 1.0 / (sim.config.sim_time * sim.get_dps_distribution().samples());
+    auto f = 1.0 / (config.sim_time * result.dps.samples());
     auto g = 60 * f;
 
     std::cout << std::fixed << std::setprecision(2);
-    std::cout << "white (mh)    = " << f * dd.white_mh_damage << " (" << g * dd.white_mh_count << "x)" << std::endl;
-    if (dd.white_oh_count > 0) std::cout << "white (oh)    = " << f * dd.white_oh_damage << " (" << g * dd.white_oh_count << "x)" << std::endl;
-    if (dd.mortal_strike_count > 0) std::cout << "mortal strike = " << f * dd.mortal_strike_damage << " (" << g * dd.mortal_strike_count << "x)" << std::endl;
-    if (dd.cleave_count > 0) std::cout << "cleave        = " << f * dd.cleave_damage << " (" << g * dd.cleave_count << "x)" << std::endl;
-    if (dd.bloodthirst_count > 0) std::cout << "bloodthirst   = " << f * dd.bloodthirst_damage << " (" << g * dd.bloodthirst_count << "x)" << std::endl;
-    if (dd.whirlwind_count > 0) std::cout << "whirlwind     = " << f * dd.whirlwind_damage << " (" << g * dd.whirlwind_count << "x)" << std::endl;
-    if (dd.slam_count > 0) std::cout << "slam          = " << f * dd.slam_damage << " (" << g * dd.slam_count << "x)" << std::endl;
-    if (dd.heroic_strike_count > 0) std::cout << "heroic strike = " << f * dd.heroic_strike_damage << " (" << g * dd.heroic_strike_count << "x)" << std::endl;
-    if (dd.execute_count > 0) std::cout << "execute       = " << f * dd.execute_damage << " (" << g * dd.execute_count << "x)" << std::endl;
-    if (dd.deep_wounds_count > 0) std::cout << "deep wounds   = " << f * dd.deep_wounds_damage << " (" << g * dd.deep_wounds_count << "x)" << std::endl;
-    if (dd.overpower_count > 0) std::cout << "overpower     = " << f * dd.overpower_damage << " (" << g * dd.overpower_count << "x)" << std::endl;
-    if (dd.item_hit_effects_count > 0) std::cout << "hit effects   = " << f * dd.item_hit_effects_damage << " (" << g * dd.item_hit_effects_count << "x)" << std::endl;
+    for (const auto& [source, label] : damage_source_labels)
+    {
+        if (source != Damage_source::white_mh && dd.count_of(source) == 0) continue;
+        std::cout << std::left << std::setw(16) << label << std::right << "= " << f * dd.damage_of(source) << " ("
+                  << g * dd.count_of(source) << "x)" << std::endl;
+    }
     std::cout << "----------------------" << std::endl;
-    std::cout << "total         = " << f * dd.sum_damage_sources() << std::endl;
+    std::cout << "total           = " << f * dd.sum_damage_sources() << std::endl;
     std::cout << std::endl;
 
     if (print_uptimes_and_procs)
     {
-        for (const auto& e : sim.get_aura_uptimes_map()) {
+        for (const auto& e : result.aura_uptimes) {
             std::cout << e.first << " " << 100 * f * e.second << "%" << std::endl;
         }
         std::cout << std::endl;
-        for (const auto& e : sim.get_proc_data()) {
+        for (const auto& e : result.proc_data) {
             std::cout << e.first << " " << g * e.second << " procs/min" << std::endl;
         }
         std::cout << std::endl;
@@ -74,29 +92,132 @@ struct Item_upgrade {
     }
 };
 
-Item_upgrade compute_item_upgrade(const Combat_simulator_config& config, const Character& character,
-                                  const Distribution& base_dps, const std::string& item_name)
+// per-iteration differences of two runs with config.common_random_numbers. both setups saw the same rolls in the same
+// iteration, so most of the noise cancels and the difference converges much faster than two independent means. the
+// base run covers the iterations of every analysis (see simulate), a shorter one would cut the analysis short
+Distribution paired_difference(const std::vector<double>& samples, const std::vector<double>& base_samples)
 {
-    static const double q999 = Statistics::find_cdf_quantile(Statistics::get_two_sided_p_value(0.999), 0.01);
+    assert(samples.size() <= base_samples.size());
+    Distribution diff{};
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        diff.add_sample(samples[i] - base_samples[i]);
+    }
+    return diff;
+}
 
-    Combat_simulator sim(config);
+// text which is put together from the results of tasks, in order
+using Pending_text = std::vector<std::future<std::string>>;
+
+void append(Pending_text& text, std::string part)
+{
+    std::promise<std::string> promise;
+    text.push_back(promise.get_future());
+    promise.set_value(std::move(part));
+}
 
-    auto mean_diff = 0.0;
-    auto std_diff = 0.0;
-    sim.simulate(character, [base_dps, &mean_diff, &std_diff](const Distribution& d) {
-        if (d.samples() <= 500) return false;
-        mean_diff = d.mean() - base_dps.mean();
-        std_diff = std::sqrt(d.var_of_the_mean() + base_dps.var_of_the_mean());
-        if (d.samples() > 500 && mean_diff < 0 && mean_diff <= -std_diff * q999) return true;
-        if (d.samples() > 5000 && mean_diff >= 0 && mean_diff >= std_diff * q999) return true;
-        if (d.samples() >= 20000) return true;
-        return false;
+std::string wait_for_text(Task_pool& pool, Pending_text& text)
+{
+    std::string result;
+    for (auto& part : text)
+    {
+        result += pool.wait(part);
+    }
+    return result;
+}
+
+// simulates character against the iterations of base_samples until the paired differences satisfy the rule. without
+// early stops this is a regular (possibly parallel) run of n_batches
+Distribution simulate_difference(const Combat_simulator_config& config, const Character& character,
+                                 const std::vector<double>& base_samples, StoppingRule rule)
+{
+    if (!rule.stops_early())
+    {
+        return paired_difference(Combat_simulator::simulate_result(config, character)->dps_samples, base_samples);
+    }
+
+    // where the run stops depends on the base samples, so the difference is cached instead of the run
+    auto& cache = Result_cache::shared();
+    const auto key = Sim_hash{}.add(config).add(character).add(base_samples).add(rule).value();
+    if (auto result = cache.find(key)) return result->dps;
+
+    assert(rule.max_samples() <= static_cast<int>(base_samples.size()));
+    Distribution diff{};
+    Combat_simulator sim(config);
+    sim.simulate(character, [&base_samples, &rule, &diff](const Distribution& d) {
+        if (d.samples() > 0) diff.add_sample(d.last_sample() - base_samples[d.samples() - 1]);
+        return rule(diff);
     });
-    return {item_name, mean_diff, std_diff};
+    cache.insert(key, Sim_result{diff});
+    return diff;
+}
+
+// downgrades are dropped after 500 samples already, upgrades need 5000 to be trusted. so do items which are behind the
+// best one
+static const auto upgrade_rule = StoppingRule{20000, 500}.with_sign_test(0.999, 0, 5000);
+
+// the candidate items of a socket raced against each other (see Combat_simulator::simulate_race) and compared to the
+// current item
+std::vector<Item_upgrade> compute_item_upgrades(const Combat_simulator_config& config,
+                                                const std::vector<Character>& candidates,
+                                                const std::vector<std::string>& item_names,
+                                                const std::vector<double>& base_samples)
+{
+    // what a candidate gets depends on the others in the race, so the key covers all of them
+    auto& cache = Result_cache::shared();
+    Sim_hash race{};
+    race.add(config).add(base_samples).add(upgrade_rule);
+    for (const auto& candidate : candidates)
+    {
+        race.add(candidate);
+    }
+    std::vector<uint64_t> keys;
+    std::vector<Distribution> diffs;
+    for (size_t i = 0; i < candidates.size(); ++i)
+    {
+        keys.push_back(Sim_hash{race}.add(static_cast<int64_t>(i)).value());
+        if (auto result = cache.find(keys.back())) diffs.push_back(result->dps);
+    }
+    if (diffs.size() != candidates.size())
+    {
+        diffs = Combat_simulator::simulate_race(config, candidates, base_samples, upgrade_rule);
+        for (size_t i = 0; i < candidates.size(); ++i)
+        {
+            cache.insert(keys[i], Sim_result{diffs[i]});
+        }
+    }
+
+    std::vector<Item_upgrade> ius{};
+    ius.reserve(candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i)
+    {
+        ius.push_back({item_names[i], diffs[i].mean(), diffs[i].std_of_the_mean()});
+    }
+    return ius;
 }
 
-void item_upgrades(std::string& item_strengths_string, const Combat_simulator_config& config, Character character_new,
-                   Armory& armory, const Distribution& base_dps, Socket socket, bool first_item)
+// waits for the candidates of a socket and lists them, best first
+std::string list_upgrades(Task_pool& pool, const std::string& current, std::future<std::vector<Item_upgrade>>& upgrades)
+{
+    auto ius = pool.wait(upgrades);
+    std::sort(ius.begin(), ius.end(), [](const auto& a, const auto& b) { return a.mean_diff > b.mean_diff; });
+
+    std::string s = current;
+    if (ius.front().mean_diff < 0)
+    {
+        s += " is <b>BiS</b> in current configuration!";
+    }
+    for (const auto& iu : ius)
+    {
+        s += iu.to_string();
+    }
+    s += "<br><br>";
+    return s;
+}
+
+void item_upgrades(Pending_text& item_strengths, Task_pool& pool, const Combat_simulator_config& config,
+                   Character character_new, const Armory& armory, const std::vector<double>& base_samples, Socket socket,
+                   bool first_item)
 {
     std::string dummy;
     const auto& armor_vec = armory.get_items_in_socket(socket);
@@ -113,31 +234,32 @@ void item_upgrades(std::string& item_strengths_string, const Combat_simulator_co
 
     auto items = Item_optimizer::remove_weaker_items(armor_vec, character_new.total_special_stats, dummy, 4, filter);
 
-    std::vector<Item_upgrade> ius{};
-    ius.reserve(items.size());
+    std::vector<Character> candidates{};
+    std::vector<std::string> names{};
+    candidates.reserve(items.size());
+    names.reserve(items.size());
+    // each candidate is swapped in, only items with effects compute the character again
+    Stat_composition composition{armory, character_new};
+    composition.add_items(character_new);
     for (const auto& item : items)
     {
-        Armory::change_armor(character_new.armor, item, first_item);
-        armory.compute_total_stats(character_new);
-        ius.emplace_back(compute_item_upgrade(config, character_new, base_dps, item.name));
+        armory.change_armor(character_new, composition, item, first_item);
+        candidates.push_back(character_new);
+        names.push_back(item.name);
     }
-    std::sort(ius.begin(), ius.end(), [](const auto& a, const auto& b) { return a.mean_diff > b.mean_diff; });
+    auto upgrades = pool.submit([config, candidates = std::move(candidates), names = std::move(names), &base_samples]() {
+        return compute_item_upgrades(config, candidates, names, base_samples);
+    });
 
-    item_strengths_string += "Current " + friendly_name(socket) + ": <b>" + current_armor.name + "</b>";
-    if (ius.front().mean_diff < 0)
-    {
-        item_strengths_string += " is <b>BiS</b> in current configuration!";
-    }
-    for (const auto& iu : ius)
-    {
-        item_strengths_string += iu.to_string();
-    }
-    item_strengths_string += "<br><br>";
+    auto current = "Current " + friendly_name(socket) + ": <b>" + current_armor.name + "</b>";
+    item_strengths.emplace_back(std::async(std::launch::deferred, [&pool, current, upgrades = std::move(upgrades)]() mutable {
+        return list_upgrades(pool, current, upgrades);
+    }));
 }
 
-void wep_upgrades(std::string& item_strengths_string, const Combat_simulator_config& config,
-                       Character character_new, Armory& armory, const Distribution& base_dps,
-                       Weapon_socket weapon_socket)
+void wep_upgrades(Pending_text& item_strengths, Task_pool& pool, const Combat_simulator_config& config,
+                  Character character_new, const Armory& armory, const std::vector<double>& base_samples,
+                  Weapon_socket weapon_socket)
 {
     auto socket = (weapon_socket == Weapon_socket::main_hand || weapon_socket == Weapon_socket::two_hand) ? Socket::main_hand : Socket::off_hand;
 
@@ -152,26 +274,66 @@ void wep_upgrades(std::string& item_strengths_string, const Combat_simulator_con
 
     auto items = Item_optimizer::remove_weaker_weapons(weapon_socket, wep_vec, character_new.total_special_stats, dummy, 10, filter);
 
-    std::vector<Item_upgrade> ius{};
-    ius.reserve(items.size());
+    std::vector<Character> candidates{};
+    std::vector<std::string> names{};
+    candidates.reserve(items.size());
+    names.reserve(items.size());
+    Stat_composition composition{armory, character_new};
+    composition.add_items(character_new);
     for (const auto& item : items)
     {
-        Armory::change_weapon(character_new.weapons, item, socket);
-        armory.compute_total_stats(character_new);
-        ius.emplace_back(compute_item_upgrade(config, character_new, base_dps, item.name));
+        armory.change_weapon(character_new, composition, item, socket);
+        candidates.push_back(character_new);
+        names.push_back(item.name);
     }
-    std::sort(ius.begin(), ius.end(), [](const auto& a, const auto& b) { return a.mean_diff > b.mean_diff; });
+    auto upgrades = pool.submit([config, candidates = std::move(candidates), names = std::move(names), &base_samples]() {
+        return compute_item_upgrades(config, candidates, names, base_samples);
+    });
 
-    item_strengths_string += "Current " + friendly_name(socket) + ": " + "<b>" + current_weapon.name + "</b>";
-    if (ius.front().mean_diff < 0)
-    {
-        item_strengths_string += " is <b>BiS</b> in current configuration!";
-    }
-    for (const auto& iu : ius)
+    auto current = "Current " + friendly_name(socket) + ": " + "<b>" + current_weapon.name + "</b>";
+    item_strengths.emplace_back(std::async(std::launch::deferred, [&pool, current, upgrades = std::move(upgrades)]() mutable {
+        return list_upgrades(pool, current, upgrades);
+    }));
+}
+
+// the setups of all sockets at once with the highest simulated dps (see Item_optimizer::optimize_gear) and how they
+// differ from the current one
+std::string best_gear_setups(Task_pool& pool, const Combat_simulator_config& config, const Character& character,
+                             const Armory& armory, const std::vector<double>& base_samples)
+{
+    // Restrict Kael'thas Legendary weapons not to be suggested (see wep_upgrades)
+    auto armor_filter = [](const Armor&) { return false; };
+    auto weapon_filter = [](const Weapon& w) {
+        return w.name == "devastation" || w.name == "warp_slicer" || w.name == "infinity_blade";
+    };
+
+    std::string debug_message;
+    const auto setups =
+        Item_optimizer::optimize_gear(armory, character, config, pool, 5, 5, debug_message, armor_filter, weapon_filter);
+
+    std::string s = "<b>Best gear setups:</b><br>" + debug_message;
+    for (const auto& setup : setups)
     {
-        item_strengths_string += iu.to_string();
+        const auto diff = simulate_difference(config, setup.character, base_samples, StoppingRule{});
+        s += "<br>" + String_helpers::string_with_precision(setup.dps.mean(), 1) + " DPS ( " +
+             (diff.mean() >= 0 ? "+" : "") + String_helpers::string_with_precision(diff.mean(), 1) + " &plusmn " +
+             String_helpers::string_with_precision(q95 * diff.std_of_the_mean(), 1) + " DPS):";
+
+        std::string changes;
+        for (size_t i = 0; i < setup.character.armor.size(); ++i)
+        {
+            const auto& name = setup.character.armor[i].name;
+            if (name != character.armor[i].name) changes += " <b>" + name + "</b>";
+        }
+        for (size_t i = 0; i < setup.character.weapons.size(); ++i)
+        {
+            const auto& name = setup.character.weapons[i].name;
+            if (name != character.weapons[i].name) changes += " <b>" + name + "</b>";
+        }
+        s += changes.empty() ? " current gear" : changes;
     }
-    item_strengths_string += "<br><br>";
+    s += "<br><br>";
+    return s;
 }
 
 struct Stat_weight
@@ -183,12 +345,13 @@ struct Stat_weight
 
 Stat_weight compute_stat_weight(const Combat_simulator_config& config, Character& char_plus,
                                 double permute_amount, double permute_factor,
-                                const Distribution& base_dps)
+                                const std::vector<double>& base_samples)
 {
-    auto new_dps = Combat_simulator::simulate(config, char_plus);
+    auto rule = config.stopping_rule;
+    auto diff = simulate_difference(config, char_plus, base_samples, rule.with_max_samples(config.n_batches));
 
-    auto mean_diff = (new_dps.mean() - base_dps.mean()) / permute_factor;
-    auto std_of_the_mean_diff = std::sqrt(new_dps.var_of_the_mean() + base_dps.var_of_the_mean()) / permute_factor;
+    auto mean_diff = diff.mean() / permute_factor;
+    auto std_of_the_mean_diff = diff.std_of_the_mean() / permute_factor;
 
     return {mean_diff, q95 * std_of_the_mean_diff, permute_amount};
 }
@@ -197,22 +360,13 @@ std::vector<double> get_damage_sources(const Damage_sources& damage_sources_vect
 {
     const auto total_damage = damage_sources_vector.sum_damage_sources();
 
-    return {
-        damage_sources_vector.white_mh_damage / total_damage,
-        damage_sources_vector.white_oh_damage / total_damage,
-        damage_sources_vector.bloodthirst_damage / total_damage,
-        damage_sources_vector.execute_damage / total_damage,
-        damage_sources_vector.heroic_strike_damage / total_damage,
-        damage_sources_vector.cleave_damage / total_damage,
-        damage_sources_vector.whirlwind_damage / total_damage,
-        damage_sources_vector.hamstring_damage / total_damage,
-        damage_sources_vector.deep_wounds_damage / total_damage,
-        damage_sources_vector.item_hit_effects_damage / total_damage,
-        damage_sources_vector.overpower_damage / total_damage,
-        damage_sources_vector.slam_damage / total_damage,
-        damage_sources_vector.mortal_strike_damage / total_damage,
-        damage_sources_vector.sweeping_strikes_damage / total_damage,
-    };
+    std::vector<double> fractions;
+    fractions.reserve(Damage_sources::n_sources);
+    for (const auto damage : damage_sources_vector.damage)
+    {
+        fractions.push_back(damage / total_damage);
+    }
+    return fractions;
 }
 
 std::string print_stat(const std::string& stat_name, double amount, double bonus_amount = -1)
@@ -351,418 +505,418 @@ std::string get_character_stat(const Character& character)
 }
 
 std::string compute_talent_weight(const Combat_simulator_config& config, const Character& character,
-                                  const Distribution& init_dps, const std::string& talent_name,
+                                  const std::vector<double>& base_samples, const std::string& talent_name,
                                   int Character::talents_t::*talent, int n_points)
 {
-    Armory armory;
+    const auto& armory = Armory::shared();
 
-    auto without = init_dps;
-    if (character.talents.*talent > 0)
-    {
+    auto simulate_with_points = [&](int points) {
         auto copy = character;
-        copy.talents.*talent = 0;
+        copy.talents.*talent = points;
         armory.compute_total_stats(copy);
-        without = Combat_simulator::simulate(config, copy);
-    }
+        return Combat_simulator::simulate_result(config, copy)->dps_samples;
+    };
 
-    auto with = init_dps;
-    if (character.talents.*talent < n_points)
-    {
-        auto copy = character;
-        copy.talents.*talent = n_points;
-        armory.compute_total_stats(copy);
-        with = Combat_simulator::simulate(config, copy);
-    }
+    // the base run may be longer than the talent runs (see simulate)
+    assert(config.n_batches <= static_cast<int>(base_samples.size()));
+    const std::vector<double> base(base_samples.begin(), base_samples.begin() + config.n_batches);
+    auto without = character.talents.*talent > 0 ? simulate_with_points(0) : base;
+    auto with = character.talents.*talent < n_points ? simulate_with_points(n_points) : base;
+    auto diff = paired_difference(with, without);
 
-    auto mean_diff = (with.mean() - without.mean()) / n_points;
-    auto std_of_the_mean_diff = std::sqrt(with.var_of_the_mean() + without.var_of_the_mean()) / n_points;
+    auto mean_diff = diff.mean() / n_points;
+    auto std_of_the_mean_diff = diff.std_of_the_mean() / n_points;
 
     return "<br>Talent: <b>" + talent_name + "</b><br>Value: <b>" +
            String_helpers::string_with_precision(mean_diff, 4) + " &plusmn " +
            String_helpers::string_with_precision(q95 * std_of_the_mean_diff, 3) + " DPS</b><br>";
 }
 
-std::string compute_talent_weights(const Combat_simulator_config& config, const Character& character, const Distribution& base_dps)
+Pending_text compute_talent_weights(Task_pool& pool, const Combat_simulator_config& config, const Character& character,
+                                    const std::vector<double>& base_samples)
 {
-    std::string talents_info = "<br><b>Value per 1 talent point:</b>";
+    Pending_text talents_info;
+    append(talents_info, "<br><b>Value per 1 talent point:</b>");
+
+    auto add_talent = [&](const std::string& talent_name, int Character::talents_t::*talent, int n_points) {
+        talents_info.emplace_back(pool.submit([config, &character, &base_samples, talent_name, talent, n_points]() {
+            return compute_talent_weight(config, character, base_samples, talent_name, talent, n_points);
+        }));
+    };
 
     if (config.combat.use_heroic_strike)
     {
         if (config.number_of_extra_targets > 0 && config.combat.cleave_if_adds)
         {
-            talents_info += compute_talent_weight(config, character, base_dps, "Improved Cleave",
-                                                  &Character::talents_t::improved_cleave, 3);
+            add_talent("Improved Cleave", &Character::talents_t::improved_cleave, 3);
         }
         else
         {
-            talents_info += compute_talent_weight(config, character, base_dps, "Improved Heroic Strike",
-                                                  &Character::talents_t::improved_heroic_strike, 3);
+            add_talent("Improved Heroic Strike", &Character::talents_t::improved_heroic_strike, 3);
         }
     }
 
     if (config.combat.use_whirlwind)
     {
-        talents_info += compute_talent_weight(config, character, base_dps, "Improved Whirlwind",
-                                              &Character::talents_t::improved_whirlwind, 2);
+        add_talent("Improved Whirlwind", &Character::talents_t::improved_whirlwind, 2);
     }
 
     if (config.combat.use_mortal_strike)
     {
-        talents_info += compute_talent_weight(config, character, base_dps, "Improved Mortal Strike",
-                                              &Character::talents_t::improved_mortal_strike, 5);
+        add_talent("Improved Mortal Strike", &Character::talents_t::improved_mortal_strike, 5);
     }
 
     if (config.combat.use_slam)
     {
-        talents_info += compute_talent_weight(config, character, base_dps, "Improved Slam",
-                                              &Character::talents_t::improved_slam, 2);
+        add_talent("Improved Slam", &Character::talents_t::improved_slam, 2);
     }
 
     if (config.combat.use_overpower)
     {
-        talents_info += compute_talent_weight(config, character, base_dps, "Improved Overpower",
-                                              &Character::talents_t::improved_overpower, 2);
+        add_talent("Improved Overpower", &Character::talents_t::improved_overpower, 2);
     }
 
     if (config.execute_phase_percentage_ > 0)
     {
-        talents_info += compute_talent_weight(config, character, base_dps, "Improved Execute",
-                                              &Character::talents_t::improved_execute, 2);
+        add_talent("Improved Execute", &Character::talents_t::improved_execute, 2);
     }
 
     if (character.is_dual_wield())
     {
-        talents_info += compute_talent_weight(config, character, base_dps, "Dual Wield Specialization",
-                                              &Character::talents_t::dual_wield_specialization, 5);
+        add_talent("Dual Wield Specialization", &Character::talents_t::dual_wield_specialization, 5);
     }
 
     if (character.is_dual_wield())
     {
-        talents_info += compute_talent_weight(config, character, base_dps, "One-Handed Weapon Specialization",
-                                              &Character::talents_t::one_handed_weapon_specialization, 5);
+        add_talent("One-Handed Weapon Specialization", &Character::talents_t::one_handed_weapon_specialization, 5);
     }
 
     if (!character.is_dual_wield())
     {
-        talents_info += compute_talent_weight(config, character, base_dps, "Two-Handed Weapon Specialization",
-                                              &Character::talents_t::two_handed_weapon_specialization, 5);
+        add_talent("Two-Handed Weapon Specialization", &Character::talents_t::two_handed_weapon_specialization, 5);
     }
 
     if (config.use_death_wish)
     {
-        talents_info += compute_talent_weight(config, character, base_dps, "Death Wish",
-                                              &Character::talents_t::death_wish, 1);
+        add_talent("Death Wish", &Character::talents_t::death_wish, 1);
     }
 
     if (character.has_weapon_of_type(Weapon_type::sword))
     {
-        talents_info += compute_talent_weight(config, character, base_dps, "Sword Specialization",
-                                              &Character::talents_t::sword_specialization, 5);
+        add_talent("Sword Specialization", &Character::talents_t::sword_specialization, 5);
     }
 
     if (character.has_weapon_of_type(Weapon_type::mace))
     {
-        talents_info += compute_talent_weight(config, character, base_dps, "Mace Specialization",
-                                              &Character::talents_t::mace_specialization, 5);
+        add_talent("Mace Specialization", &Character::talents_t::mace_specialization, 5);
     }
 
     if (character.has_weapon_of_type(Weapon_type::axe))
     {
-        talents_info += compute_talent_weight(config, character, base_dps, "Poleaxe Specialization",
-                                              &Character::talents_t::poleaxe_specialization, 5);
+        add_talent("Poleaxe Specialization", &Character::talents_t::poleaxe_specialization, 5);
     }
 
-    talents_info += compute_talent_weight(config, character, base_dps, "Flurry",
-                                          &Character::talents_t::flurry, 5);
+    add_talent("Flurry", &Character::talents_t::flurry, 5);
 
-    talents_info += compute_talent_weight(config, character, base_dps, "Cruelty",
-                                          &Character::talents_t::cruelty, 5);
+    add_talent("Cruelty", &Character::talents_t::cruelty, 5);
 
-    talents_info += compute_talent_weight(config, character, base_dps, "Impale",
-                                          &Character::talents_t::impale, 2);
+    add_talent("Impale", &Character::talents_t::impale, 2);
 
-    talents_info += compute_talent_weight(config, character, base_dps, "Rampage",
-                                          &Character::talents_t::rampage, 1);
+    add_talent("Rampage", &Character::talents_t::rampage, 1);
 
-    talents_info += compute_talent_weight(config, character, base_dps, "Weapon Mastery",
-                                          &Character::talents_t::weapon_mastery, 2);
+    add_talent("Weapon Mastery", &Character::talents_t::weapon_mastery, 2);
 
-    talents_info += compute_talent_weight(config, character, base_dps, "Precision",
-                                          &Character::talents_t::precision, 3);
+    add_talent("Precision", &Character::talents_t::precision, 3);
 
-    talents_info += compute_talent_weight(config, character, base_dps, "Improved Berserker Stance",
-                                          &Character::talents_t::improved_berserker_stance, 5);
+    add_talent("Improved Berserker Stance", &Character::talents_t::improved_berserker_stance, 5);
 
-    talents_info += compute_talent_weight(config, character, base_dps, "Unbridled Wrath",
-                                          &Character::talents_t::unbridled_wrath, 5);
+    add_talent("Unbridled Wrath", &Character::talents_t::unbridled_wrath, 5);
 
-    talents_info += compute_talent_weight(config, character, base_dps, "Anger Management",
-                                          &Character::talents_t::anger_management, 1);
+    add_talent("Anger Management", &Character::talents_t::anger_management, 1);
 
-    talents_info += compute_talent_weight(config, character, base_dps, "Endless Rage",
-                                          &Character::talents_t::endless_rage, 1);
+    add_talent("Endless Rage", &Character::talents_t::endless_rage, 1);
 
     return talents_info;
 }
 
-void compute_dpr(const Character& character, const Combat_simulator& simulator,
-                 const Distribution& base_dps, const Damage_sources& dmg_dist, std::string& dpr_info)
+// all ablations run in a single task (see Combat_simulator::simulate_ablations), which pairs every iteration with the
+// same iteration of the unchanged rotation
+Pending_text compute_dpr(Task_pool& pool, const Character& character, const Sim_result& base,
+                         const Combat_simulator_config& base_config)
 {
-    auto config = simulator.config;
+    const auto& base_dps = base.dps;
+    const auto& dmg_dist = base.damage_sources;
+    auto config = base_config;
     config.n_batches = 10000;
+    config.stopping_rule = StoppingRule{}.with_min_samples(1000).with_precision(3); // dps lost within +-3 (95%)
+
+    std::vector<Combat_simulator_config::dpr_t> ablations;
+    std::vector<std::function<std::string(double)>> describe; // the text of each ablation, from the damage it lost
 
-    dpr_info = "<br><b>Ability damage per rage:</b><br>";
-    dpr_info += "DPR for ability X is computed as following:<br> "
-                "((Normal DPS) - (DPS where ability X costs rage but has no effect)) / (rage cost of ability "
-                "X)<br>";
+    Pending_text dpr_info;
+    append(dpr_info, "<br><b>Ability damage per rage:</b><br>"
+                     "DPR for ability X is computed as following:<br> "
+                     "((Normal DPS) - (DPS where ability X costs rage but has no effect)) / (rage cost of ability "
+                     "X)<br>");
     if (config.combat.use_bloodthirst)
     {
-        double avg_bt_casts = static_cast<double>(dmg_dist.bloodthirst_count) / base_dps.samples();
+        double avg_bt_casts = static_cast<double>(dmg_dist.count_of(Damage_source::bloodthirst)) / base_dps.samples();
         if (avg_bt_casts >= 1.0)
         {
             double bloodthirst_rage = 30 - 5 * character.has_set_bonus(Set::destroyer, 4);
-            config.dpr_settings.compute_dpr_bt_ = true;
-            auto dpr_dps = Combat_simulator::simulate(config, character);
-            double delta_dps = base_dps.mean() - dpr_dps.mean();
-            double dmg_tot = delta_dps * config.sim_time;
-            double dmg_per_hit = dmg_tot / avg_bt_casts;
-            double dmg_per_rage = dmg_per_hit / bloodthirst_rage;
-            dpr_info += "<b>Bloodthirst</b>: <br>Damage per cast: <b>" +
-                        String_helpers::string_with_precision(dmg_per_hit, 4) + "</b><br>Average rage cost: <b>" +
-                        String_helpers::string_with_precision(bloodthirst_rage, 3) + "</b><br>DPR: <b>" +
-                        String_helpers::string_with_precision(dmg_per_rage, 4) + "</b><br>";
-            config.dpr_settings.compute_dpr_bt_ = false;
+            ablations.emplace_back().compute_dpr_bt_ = true;
+            describe.emplace_back([=](double dmg_tot) {
+                double dmg_per_hit = dmg_tot / avg_bt_casts;
+                double dmg_per_rage = dmg_per_hit / bloodthirst_rage;
+                return "<b>Bloodthirst</b>: <br>Damage per cast: <b>" +
+                       String_helpers::string_with_precision(dmg_per_hit, 4) + "</b><br>Average rage cost: <b>" +
+                       String_helpers::string_with_precision(bloodthirst_rage, 3) + "</b><br>DPR: <b>" +
+                       String_helpers::string_with_precision(dmg_per_rage, 4) + "</b><br>";
+            });
         }
     }
     if (config.combat.use_mortal_strike)
     {
-        double avg_ms_casts = static_cast<double>(dmg_dist.mortal_strike_count) / base_dps.samples();
+        double avg_ms_casts = static_cast<double>(dmg_dist.count_of(Damage_source::mortal_strike)) / base_dps.samples();
         if (avg_ms_casts >= 1.0)
         {
             double mortal_strike_rage = 30 - 5 * character.has_set_bonus(Set::destroyer, 4);
-            config.dpr_settings.compute_dpr_ms_ = true;
-            auto dpr_dps = Combat_simulator::simulate(config, character);
-            double delta_dps = base_dps.mean() - dpr_dps.mean();
-            double dmg_tot = delta_dps * config.sim_time;
-            double dmg_per_hit = dmg_tot / avg_ms_casts;
-            double dmg_per_rage = dmg_per_hit / mortal_strike_rage;
-            dpr_info += "<b>Mortal Strike</b>: <br>Damage per cast: <b>" +
-                        String_helpers::string_with_precision(dmg_per_hit, 4) + "</b><br>Average rage cost: <b>" +
-                        String_helpers::string_with_precision(mortal_strike_rage, 3) + "</b><br>DPR: <b>" +
-                        String_helpers::string_with_precision(dmg_per_rage, 4) + "</b><br>";
-            config.dpr_settings.compute_dpr_ms_ = false;
+            ablations.emplace_back().compute_dpr_ms_ = true;
+            describe.emplace_back([=](double dmg_tot) {
+                double dmg_per_hit = dmg_tot / avg_ms_casts;
+                double dmg_per_rage = dmg_per_hit / mortal_strike_rage;
+                return "<b>Mortal Strike</b>: <br>Damage per cast: <b>" +
+                       String_helpers::string_with_precision(dmg_per_hit, 4) + "</b><br>Average rage cost: <b>" +
+                       String_helpers::string_with_precision(mortal_strike_rage, 3) + "</b><br>DPR: <b>" +
+                       String_helpers::string_with_precision(dmg_per_rage, 4) + "</b><br>";
+            });
         }
     }
     if (config.combat.use_whirlwind)
     {
-        double avg_ww_casts = static_cast<double>(dmg_dist.whirlwind_count) / base_dps.samples();
+        double avg_ww_casts = static_cast<double>(dmg_dist.count_of(Damage_source::whirlwind)) / base_dps.samples();
         if (avg_ww_casts >= 1.0)
         {
             double whirlwind_rage = 25 - 5 * character.has_set_bonus(Set::warbringer, 2);
-            config.dpr_settings.compute_dpr_ww_ = true;
-            auto dpr_dps = Combat_simulator::simulate(config, character);
-            double delta_dps = base_dps.mean() - dpr_dps.mean();
-            double dmg_tot = delta_dps * config.sim_time;
-            double dmg_per_hit = dmg_tot / avg_ww_casts;
-            double dmg_per_rage = dmg_per_hit / whirlwind_rage;
-            dpr_info += "<b>Whirlwind</b>: <br>Damage per cast: <b>" +
-                        String_helpers::string_with_precision(dmg_per_hit, 4) + "</b><br>Average rage cost: <b>" +
-                        String_helpers::string_with_precision(whirlwind_rage, 3) + "</b><br>DPR: <b>" +
-                        String_helpers::string_with_precision(dmg_per_rage, 4) + "</b><br>";
-            config.dpr_settings.compute_dpr_ww_ = false;
+            ablations.emplace_back().compute_dpr_ww_ = true;
+            describe.emplace_back([=](double dmg_tot) {
+                double dmg_per_hit = dmg_tot / avg_ww_casts;
+                double dmg_per_rage = dmg_per_hit / whirlwind_rage;
+                return "<b>Whirlwind</b>: <br>Damage per cast: <b>" +
+                       String_helpers::string_with_precision(dmg_per_hit, 4) + "</b><br>Average rage cost: <b>" +
+                       String_helpers::string_with_precision(whirlwind_rage, 3) + "</b><br>DPR: <b>" +
+                       String_helpers::string_with_precision(dmg_per_rage, 4) + "</b><br>";
+            });
         }
     }
     if (config.combat.use_slam)
     {
-        double avg_sl_casts = static_cast<double>(dmg_dist.slam_count) / base_dps.samples();
+        double avg_sl_casts = static_cast<double>(dmg_dist.count_of(Damage_source::slam)) / base_dps.samples();
         if (avg_sl_casts >= 1.0)
         {
-            config.dpr_settings.compute_dpr_sl_ = true;
-            auto dpr_dps = Combat_simulator::simulate(config, character);
-            double delta_dps = base_dps.mean() - dpr_dps.mean();
-            double dmg_tot = delta_dps * config.sim_time;
-            double avg_mh_dmg =
-                static_cast<double>(dmg_dist.white_mh_damage) / static_cast<double>(dmg_dist.white_mh_count);
-            double avg_mh_rage_lost = avg_mh_dmg * 3.75 / 274.7 + (3.5 * character.weapons[0].swing_speed / 2);
-            double sl_cast_time = 1.5 - 0.5 * character.talents.improved_slam + 0.001 * config.combat.slam_latency;
-            double dmg_per_hit = dmg_tot / avg_sl_casts;
-            double dmg_per_rage = dmg_per_hit / (15.0 + avg_mh_rage_lost * sl_cast_time / character.weapons[0].swing_speed);
-            dpr_info += "<b>Slam</b>: <br>Damage per cast: <b>" +
-                        String_helpers::string_with_precision(dmg_per_hit, 4) + "</b><br>Average rage cost: <b>" +
-                        String_helpers::string_with_precision(15.0 + avg_mh_rage_lost * sl_cast_time / character.weapons[0].swing_speed, 3) + "</b><br>DPR: <b>" +
-                        String_helpers::string_with_precision(dmg_per_rage, 4) + "</b><br>";
-            config.dpr_settings.compute_dpr_sl_ = false;
+            ablations.emplace_back().compute_dpr_sl_ = true;
+            describe.emplace_back([=, &character, &dmg_dist](double dmg_tot) {
+                double avg_mh_dmg =
+                    static_cast<double>(dmg_dist.damage_of(Damage_source::white_mh)) / static_cast<double>(dmg_dist.count_of(Damage_source::white_mh));
+                double avg_mh_rage_lost = avg_mh_dmg * 3.75 / 274.7 + (3.5 * character.weapons[0].swing_speed / 2);
+                double sl_cast_time = 1.5 - 0.5 * character.talents.improved_slam + 0.001 * config.combat.slam_latency;
+                double dmg_per_hit = dmg_tot / avg_sl_casts;
+                double dmg_per_rage = dmg_per_hit / (15.0 + avg_mh_rage_lost * sl_cast_time / character.weapons[0].swing_speed);
+                return "<b>Slam</b>: <br>Damage per cast: <b>" +
+                       String_helpers::string_with_precision(dmg_per_hit, 4) + "</b><br>Average rage cost: <b>" +
+                       String_helpers::string_with_precision(15.0 + avg_mh_rage_lost * sl_cast_time / character.weapons[0].swing_speed, 3) + "</b><br>DPR: <b>" +
+                       String_helpers::string_with_precision(dmg_per_rage, 4) + "</b><br>";
+            });
         }
     }
     if (config.combat.use_heroic_strike)
     {
-        double avg_hs_casts = static_cast<double>(dmg_dist.heroic_strike_count) / base_dps.samples();
+        double avg_hs_casts = static_cast<double>(dmg_dist.count_of(Damage_source::heroic_strike)) / base_dps.samples();
         if (avg_hs_casts >= 1.0)
         {
             double heroic_strike_rage = 15 - character.talents.improved_heroic_strike;
-            config.dpr_settings.compute_dpr_hs_ = true;
-            auto dpr_dps = Combat_simulator::simulate(config, character);
-            double delta_dps = base_dps.mean() - dpr_dps.mean();
-            double dmg_tot = delta_dps * config.sim_time;
-            double dmg_per_hs = dmg_tot / avg_hs_casts;
-            double avg_mh_dmg =
-                static_cast<double>(dmg_dist.white_mh_damage) / static_cast<double>(dmg_dist.white_mh_count);
-            double avg_mh_rage_lost = avg_mh_dmg * 3.75 / 274.7 + (3.5 * character.weapons[0].swing_speed / 2);
-            double dmg_per_rage = dmg_per_hs / (heroic_strike_rage + avg_mh_rage_lost);
-            dpr_info += "<b>Heroic Strike</b>: <br>Damage per cast: <b>" +
-                        String_helpers::string_with_precision(dmg_per_hs, 4) + "</b><br>Average rage cost: <b>" +
-                        String_helpers::string_with_precision((heroic_strike_rage + avg_mh_rage_lost), 3) + "</b><br>DPR: <b>" +
-                        String_helpers::string_with_precision(dmg_per_rage, 4) + "</b><br>";
-            config.dpr_settings.compute_dpr_hs_ = false;
+            ablations.emplace_back().compute_dpr_hs_ = true;
+            describe.emplace_back([=, &character, &dmg_dist](double dmg_tot) {
+                double dmg_per_hs = dmg_tot / avg_hs_casts;
+                double avg_mh_dmg =
+                    static_cast<double>(dmg_dist.damage_of(Damage_source::white_mh)) / static_cast<double>(dmg_dist.count_of(Damage_source::white_mh));
+                double avg_mh_rage_lost = avg_mh_dmg * 3.75 / 274.7 + (3.5 * character.weapons[0].swing_speed / 2);
+                double dmg_per_rage = dmg_per_hs / (heroic_strike_rage + avg_mh_rage_lost);
+                return "<b>Heroic Strike</b>: <br>Damage per cast: <b>" +
+                       String_helpers::string_with_precision(dmg_per_hs, 4) + "</b><br>Average rage cost: <b>" +
+                       String_helpers::string_with_precision((heroic_strike_rage + avg_mh_rage_lost), 3) + "</b><br>DPR: <b>" +
+                       String_helpers::string_with_precision(dmg_per_rage, 4) + "</b><br>";
+            });
         }
     }
     if (config.combat.cleave_if_adds)
     {
-        double avg_cl_casts = static_cast<double>(dmg_dist.cleave_count) / base_dps.samples();
+        double avg_cl_casts = static_cast<double>(dmg_dist.count_of(Damage_source::cleave)) / base_dps.samples();
         if (avg_cl_casts >= 1.0)
         {
-            config.dpr_settings.compute_dpr_cl_ = true;
-            auto dpr_dps = Combat_simulator::simulate(config, character);
-            double delta_dps = base_dps.mean() - dpr_dps.mean();
-            double dmg_tot = delta_dps * config.sim_time;
-            double dmg_per_hs = dmg_tot / avg_cl_casts;
-            double avg_mh_dmg =
-                static_cast<double>(dmg_dist.white_mh_damage) / static_cast<double>(dmg_dist.white_mh_count);
-            double avg_mh_rage_lost = avg_mh_dmg * 3.75 / 274.7 + (3.5 * character.weapons[0].swing_speed / 2);
-            double dmg_per_rage = dmg_per_hs / (20 + avg_mh_rage_lost);
-            dpr_info += "<b>Cleave</b>: <br>Damage per cast: <b>" +
-                        String_helpers::string_with_precision(dmg_per_hs, 4) + "</b><br>Average rage cost: <b>" +
-                        String_helpers::string_with_precision((20 + avg_mh_rage_lost), 3) + "</b><br>DPR: <b>" +
-                        String_helpers::string_with_precision(dmg_per_rage, 4) + "</b><br>";
-            config.dpr_settings.compute_dpr_cl_ = false;
+            ablations.emplace_back().compute_dpr_cl_ = true;
+            describe.emplace_back([=, &character, &dmg_dist](double dmg_tot) {
+                double dmg_per_hs = dmg_tot / avg_cl_casts;
+                double avg_mh_dmg =
+                    static_cast<double>(dmg_dist.damage_of(Damage_source::white_mh)) / static_cast<double>(dmg_dist.count_of(Damage_source::white_mh));
+                double avg_mh_rage_lost = avg_mh_dmg * 3.75 / 274.7 + (3.5 * character.weapons[0].swing_speed / 2);
+                double dmg_per_rage = dmg_per_hs / (20 + avg_mh_rage_lost);
+                return "<b>Cleave</b>: <br>Damage per cast: <b>" +
+                       String_helpers::string_with_precision(dmg_per_hs, 4) + "</b><br>Average rage cost: <b>" +
+                       String_helpers::string_with_precision((20 + avg_mh_rage_lost), 3) + "</b><br>DPR: <b>" +
+                       String_helpers::string_with_precision(dmg_per_rage, 4) + "</b><br>";
+            });
         }
     }
     if (config.combat.use_hamstring)
     {
-        double avg_ha_casts = static_cast<double>(dmg_dist.hamstring_count) / base_dps.samples();
+        double avg_ha_casts = static_cast<double>(dmg_dist.count_of(Damage_source::hamstring)) / base_dps.samples();
         if (avg_ha_casts >= 1.0)
         {
-            config.dpr_settings.compute_dpr_ha_ = true;
-            auto dpr_dps = Combat_simulator::simulate(config, character);
-            double delta_dps = base_dps.mean() - dpr_dps.mean();
-            double dmg_tot = delta_dps * config.sim_time;
-            double dmg_per_ha = dmg_tot / avg_ha_casts;
-            double dmg_per_rage = dmg_per_ha / 10;
-            dpr_info += "<b>Hamstring</b>: <br>Damage per cast: <b>" +
-                        String_helpers::string_with_precision(dmg_per_ha, 4) + "</b><br>Average rage cost: <b>" +
-                        String_helpers::string_with_precision(10, 3) + "</b><br>DPR: <b>" +
-                        String_helpers::string_with_precision(dmg_per_rage, 4) + "</b><br>";
-            config.dpr_settings.compute_dpr_ha_ = false;
+            ablations.emplace_back().compute_dpr_ha_ = true;
+            describe.emplace_back([=](double dmg_tot) {
+                double dmg_per_ha = dmg_tot / avg_ha_casts;
+                double dmg_per_rage = dmg_per_ha / 10;
+                return "<b>Hamstring</b>: <br>Damage per cast: <b>" +
+                       String_helpers::string_with_precision(dmg_per_ha, 4) + "</b><br>Average rage cost: <b>" +
+                       String_helpers::string_with_precision(10, 3) + "</b><br>DPR: <b>" +
+                       String_helpers::string_with_precision(dmg_per_rage, 4) + "</b><br>";
+            });
         }
     }
     if (config.combat.use_overpower)
     {
-        double avg_op_casts = static_cast<double>(dmg_dist.overpower_count) / base_dps.samples();
+        double avg_op_casts = static_cast<double>(dmg_dist.count_of(Damage_source::overpower)) / base_dps.samples();
         if (avg_op_casts >= 1.0)
         {
-            config.dpr_settings.compute_dpr_op_ = true;
-            auto dpr_dps = Combat_simulator::simulate(config, character);
-            double delta_dps = base_dps.mean() - dpr_dps.mean();
-            double dmg_tot = delta_dps * config.sim_time;
-            double dmg_per_hit = dmg_tot / avg_op_casts;
-            double overpower_cost =
-                simulator.get_rage_lost_stance() / double(base_dps.samples()) / avg_op_casts + 5.0;
-            double dmg_per_rage = dmg_per_hit / overpower_cost;
-            dpr_info += "<b>Overpower</b>: <br>Damage per cast: <b>" +
-                        String_helpers::string_with_precision(dmg_per_hit, 4) + "</b><br>Average rage cost: <b>" +
-                        String_helpers::string_with_precision(overpower_cost, 3) + "</b><br>DPR: <b>" +
-                        String_helpers::string_with_precision(dmg_per_rage, 4) + "</b><br>";
-            config.dpr_settings.compute_dpr_op_ = false;
+            ablations.emplace_back().compute_dpr_op_ = true;
+            describe.emplace_back([=, &base](double dmg_tot) {
+                double dmg_per_hit = dmg_tot / avg_op_casts;
+                double overpower_cost = base.rage_lost_stance / double(base.dps.samples()) / avg_op_casts + 5.0;
+                double dmg_per_rage = dmg_per_hit / overpower_cost;
+                return "<b>Overpower</b>: <br>Damage per cast: <b>" +
+                       String_helpers::string_with_precision(dmg_per_hit, 4) + "</b><br>Average rage cost: <b>" +
+                       String_helpers::string_with_precision(overpower_cost, 3) + "</b><br>DPR: <b>" +
+                       String_helpers::string_with_precision(dmg_per_rage, 4) + "</b><br>";
+            });
         }
     }
 
-    double avg_ex_casts = static_cast<double>(dmg_dist.execute_count) / base_dps.samples();
+    double avg_ex_casts = static_cast<double>(dmg_dist.count_of(Damage_source::execute)) / base_dps.samples();
     if (avg_ex_casts >= 1.0)
     {
-        config.dpr_settings.compute_dpr_ex_ = true;
-        auto dpr_dps = Combat_simulator::simulate(config, character);
-        double delta_dps = base_dps.mean() - dpr_dps.mean();
-        double dmg_tot = delta_dps * config.sim_time;
-        double dmg_per_hit = dmg_tot / avg_ex_casts;
-        double execute_rage_cost = std::vector<int>{15, 13, 10}[character.talents.improved_execute];
-        double execute_cost = simulator.get_avg_rage_spent_executing() / avg_ex_casts + execute_rage_cost;
-        double dmg_per_rage = dmg_per_hit / execute_cost;
-        dpr_info += "<b>Execute</b>: <br>Damage per cast: <b>" +
-                    String_helpers::string_with_precision(dmg_per_hit, 4) + "</b><br>Average rage cost: <b>" +
-                    String_helpers::string_with_precision(execute_cost, 3) + "</b><br>DPR: <b>" +
-                    String_helpers::string_with_precision(dmg_per_rage, 4) + "</b><br>";
-        config.dpr_settings.compute_dpr_ex_ = false;
+        ablations.emplace_back().compute_dpr_ex_ = true;
+        describe.emplace_back([=, &character, &base](double dmg_tot) {
+            double dmg_per_hit = dmg_tot / avg_ex_casts;
+            double execute_rage_cost = std::vector<int>{15, 13, 10}[character.talents.improved_execute];
+            double execute_cost = base.avg_rage_spent_executing / avg_ex_casts + execute_rage_cost;
+            double dmg_per_rage = dmg_per_hit / execute_cost;
+            return "<b>Execute</b>: <br>Damage per cast: <b>" +
+                   String_helpers::string_with_precision(dmg_per_hit, 4) + "</b><br>Average rage cost: <b>" +
+                   String_helpers::string_with_precision(execute_cost, 3) + "</b><br>DPR: <b>" +
+                   String_helpers::string_with_precision(dmg_per_rage, 4) + "</b><br>";
+        });
     }
+
+    if (!ablations.empty())
+    {
+        dpr_info.emplace_back(pool.submit([config, &character, ablations = std::move(ablations), describe = std::move(describe)]() {
+            const auto dps_lost = Combat_simulator::simulate_ablations(config, character, ablations);
+            std::string text;
+            for (size_t i = 0; i < ablations.size(); ++i)
+            {
+                text += describe[i](dps_lost[i].mean() * config.sim_time);
+            }
+            return text;
+        }));
+    }
+    return dpr_info;
 }
 
-std::vector<std::string> compute_stat_weights(const Combat_simulator_config& config, const Character& character, const Distribution& base_dps, const std::vector<std::string>& stat_weights)
+// one task per stat, which returns "stat:mean:std_of_the_mean"
+Pending_text compute_stat_weights(Task_pool& pool, const Combat_simulator_config& config, const Character& character,
+                                  const std::vector<double>& base_samples, const std::vector<std::string>& stat_weights)
 {
     const auto rating_factor = 52.0 / 82;
 
-    std::vector<std::string> sw_strings{};
+    Pending_text sw_strings{};
     sw_strings.reserve(stat_weights.size());
 
     for (const auto& stat_weight : stat_weights)
     {
         Character char_plus = character;
-        Stat_weight sw{};
+        double permute_amount{};
+        double permute_factor{};
         if (stat_weight == "strength")
         {
             char_plus.total_special_stats += Attributes{50, 0}.to_special_stats(char_plus.total_special_stats);
-            sw = compute_stat_weight(config, char_plus, 10, 5, base_dps);
+            permute_amount = 10;
+            permute_factor = 5;
         }
         else if (stat_weight == "agility")
         {
             char_plus.total_special_stats += Attributes{0, 50}.to_special_stats(char_plus.total_special_stats);
-            sw = compute_stat_weight(config, char_plus, 10, 5, base_dps);
+            permute_amount = 10;
+            permute_factor = 5;
         }
         else if (stat_weight == "ap")
         {
             char_plus.total_special_stats += {0, 0, 100};
-            sw = compute_stat_weight(config, char_plus, 10, 10, base_dps);
+            permute_amount = 10;
+            permute_factor = 10;
         }
         else if (stat_weight == "crit")
         {
             char_plus.total_special_stats.critical_strike += rating_factor / 14 * 50;
-            sw = compute_stat_weight(config, char_plus, 10, 5, base_dps);
+            permute_amount = 10;
+            permute_factor = 5;
         }
         else if (stat_weight == "hit")
         {
             char_plus.total_special_stats.hit += rating_factor / 10 * 25;
-            sw = compute_stat_weight(config, char_plus, 10, 2.5, base_dps);
+            permute_amount = 10;
+            permute_factor = 2.5;
         }
         else if (stat_weight == "expertise")
         {
             // to prevent truncation, we use 6 expertise here, slightly less than for hit (~23.65 expertise rating)
             char_plus.total_special_stats.expertise += 6;
-            sw = compute_stat_weight(config, char_plus, 10, 6 * 0.25 / rating_factor, base_dps);
+            permute_amount = 10;
+            permute_factor = 6 * 0.25 / rating_factor;
         }
         else if (stat_weight == "haste")
         {
             char_plus.total_special_stats.haste += rating_factor / 10 * 0.01 * 50;
-            sw = compute_stat_weight(config, char_plus, 10, 5, base_dps);
+            permute_amount = 10;
+            permute_factor = 5;
         }
         else if (stat_weight == "arpen")
         {
             char_plus.total_special_stats.gear_armor_pen += 350;
-            sw = compute_stat_weight(config, char_plus, 10, 35, base_dps);
+            permute_amount = 10;
+            permute_factor = 35;
         }
         else if (stat_weight == "bonus_damage")
         {
             char_plus.total_special_stats.bonus_damage += 17;
-            sw = compute_stat_weight(config, char_plus, 10, 1.7, base_dps);
+            permute_amount = 10;
+            permute_factor = 1.7;
         }
         else
         {
             std::cout << "stat_weight '" << stat_weight << "' is not supported, continuing" << std::endl;
             continue;
         }
-        sw_strings.emplace_back(stat_weight + ":" + std::to_string(sw.mean) + ":" + std::to_string(sw.std_of_the_mean));
+        sw_strings.emplace_back(pool.submit([config, char_plus, permute_amount, permute_factor, &base_samples, stat_weight]() mutable {
+            auto sw = compute_stat_weight(config, char_plus, permute_amount, permute_factor, base_samples);
+            return stat_weight + ":" + std::to_string(sw.mean) + ":" + std::to_string(sw.std_of_the_mean);
+        }));
     }
     return sw_strings;
 }
 
-std::vector<std::string> parse_buff_options(Armory& armory, const Sim_input& input)
+// sets the buff values of the options in buffs (a copy of the armory's) and returns the names of all buffs
+std::vector<std::string> parse_buff_options(Buffs& buffs, const Sim_input& input)
 {
     auto temp_buffs = input.buffs;
 
@@ -798,47 +952,134 @@ std::vector<std::string> parse_buff_options(Armory& armory, const Sim_input& inp
     if (String_helpers::find_string(input.options, "expose_weakness"))
     {
         auto expose_weakness_val = String_helpers::find_value(input.float_options_string, input.float_options_val, "expose_weakness_dd");
-        armory.buffs.expose_weakness.special_stats.bonus_attack_power = 0.25 * expose_weakness_val;
+        buffs.expose_weakness.special_stats.bonus_attack_power = 0.25 * expose_weakness_val;
         temp_buffs.emplace_back("expose_weakness");
     }
     if (String_helpers::find_string(input.options, "full_polarity"))
     {
         auto full_polarity_val = String_helpers::find_value(input.float_options_string, input.float_options_val, "full_polarity_dd");
-        armory.buffs.full_polarity.special_stats.damage_mod_physical = full_polarity_val / 100.0;
-        armory.buffs.full_polarity.special_stats.damage_mod_spell = full_polarity_val / 100.0;
+        buffs.full_polarity.special_stats.damage_mod_physical = full_polarity_val / 100.0;
+        buffs.full_polarity.special_stats.damage_mod_spell = full_polarity_val / 100.0;
         temp_buffs.emplace_back("full_polarity");
     }
     if (String_helpers::find_string(input.options, "ferocious_inspiration"))
     {
         auto ferocious_inspiration_val = String_helpers::find_value(input.float_options_string, input.float_options_val, "ferocious_inspiration_dd");
         auto damage_mod = std::pow(1.03, std::round(ferocious_inspiration_val / 3)) - 1;
-        armory.buffs.ferocious_inspiration.special_stats.damage_mod_physical = damage_mod;
-        armory.buffs.ferocious_inspiration.special_stats.damage_mod_spell = damage_mod;
+        buffs.ferocious_inspiration.special_stats.damage_mod_physical = damage_mod;
+        buffs.ferocious_inspiration.special_stats.damage_mod_spell = damage_mod;
         temp_buffs.emplace_back("ferocious_inspiration");
     }
     if (String_helpers::find_string(input.options, "battle_squawk"))
     {
         auto battle_squawk_val = String_helpers::find_value(input.float_options_string, input.float_options_val, "battle_squawk_dd");
         auto attack_speed = std::pow(1.05, std::round(battle_squawk_val / 5)) - 1;
-        armory.buffs.battle_squawk.special_stats.attack_speed = attack_speed;
+        buffs.battle_squawk.special_stats.attack_speed = attack_speed;
         temp_buffs.emplace_back("battle_squawk");
     }
 
     return temp_buffs;
 }
 
+// a non-empty delta replaces base
+template <typename T>
+void apply_delta(std::vector<T>& base, const std::vector<T>& delta)
+{
+    if (!delta.empty()) base = delta;
+}
+
+// items are replaced slot by slot, an empty name keeps the item
+void apply_item_delta(std::vector<std::string>& items, const std::vector<std::string>& delta)
+{
+    if (delta.size() != items.size())
+    {
+        apply_delta(items, delta);
+        return;
+    }
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        if (!delta[i].empty()) items[i] = delta[i];
+    }
+}
+
+std::vector<Distribution> Sim_interface::simulate_variants(const Sim_input& base, const std::vector<Sim_input>& variants)
+{
+    const auto& armory = Armory::shared();
+
+    auto base_buffs = armory.buffs;
+    const auto& temp_buffs = parse_buff_options(base_buffs, base);
+
+    std::vector<Character> characters;
+    characters.reserve(variants.size());
+    for (const auto& variant : variants)
+    {
+        auto input = base;
+        apply_delta(input.race, variant.race);
+        apply_item_delta(input.armor, variant.armor);
+        apply_item_delta(input.weapons, variant.weapons);
+        apply_delta(input.enchants, variant.enchants);
+        apply_delta(input.gems, variant.gems);
+        apply_delta(input.talent_string, variant.talent_string);
+        apply_delta(input.talent_val, variant.talent_val);
+
+        auto buffs = temp_buffs;
+        std::optional<Buffs> variant_buffs;
+        if (!variant.buffs.empty())
+        {
+            input.buffs = variant.buffs;
+            variant_buffs = armory.buffs;
+            buffs = parse_buff_options(*variant_buffs, input);
+        }
+
+        characters.emplace_back(character_setup(armory, variant_buffs ? *variant_buffs : base_buffs, input.race[0],
+                                                input.armor, input.weapons, buffs, input.talent_string,
+                                                input.talent_val, input.enchants, input.gems));
+    }
+
+    Combat_simulator_config config{base};
+    Task_pool pool{config.n_threads - 1};
+    return Combat_simulator::simulate(config, characters, pool);
+}
+
 Sim_output Sim_interface::simulate(const Sim_input& input)
 {
-    Armory armory;
+    const auto& armory = Armory::shared();
 
-    const auto& temp_buffs = parse_buff_options(armory, input);
+    auto buffs = armory.buffs;
+    const auto& temp_buffs = parse_buff_options(buffs, input);
 
-    const Character character = character_setup(armory, input.race[0], input.armor, input.weapons, temp_buffs,
+    const Character character = character_setup(armory, buffs, input.race[0], input.armor, input.weapons, temp_buffs,
                                                 input.talent_string, input.talent_val, input.enchants, input.gems);
 
     // Simulator & Combat settings
     Combat_simulator_config config{input};
-    Combat_simulator simulator(config);
+
+    // talent, stat and item weights pair their iterations with the ones of the base run, which then needs all of them:
+    // as many as the longest of the analyses takes
+    auto base_config = config;
+    const bool talent_weights = String_helpers::find_string(input.options, "talents_stat_weights");
+    const bool item_weights = String_helpers::find_string(input.options, "item_strengths") ||
+                              String_helpers::find_string(input.options, "wep_strengths");
+    if (talent_weights || item_weights || String_helpers::find_string(input.options, "gear_optimizer") ||
+        !input.stat_weights.empty())
+    {
+        base_config.stopping_rule = StoppingRule{};
+    }
+    if (talent_weights)
+    {
+        const auto n_batches = String_helpers::find_value(input.float_options_string, input.float_options_val, "n_simulations_talent_dd");
+        base_config.n_batches = std::max(base_config.n_batches, static_cast<int>(n_batches));
+    }
+    if (!input.stat_weights.empty())
+    {
+        const auto n_batches = String_helpers::find_value(input.float_options_string, input.float_options_val, "n_simulations_stat_dd");
+        base_config.n_batches = std::max(base_config.n_batches, static_cast<int>(n_batches));
+    }
+    if (item_weights)
+    {
+        base_config.n_batches = std::max(base_config.n_batches, upgrade_rule.max_samples());
+    }
+    Combat_simulator simulator(base_config);
 
     for (const auto& wep : character.weapons)
     {
@@ -851,23 +1092,29 @@ Sim_output Sim_interface::simulate(const Sim_input& input)
     const auto white_oh_ht = simulator.get_hit_probabilities_white_oh();
     const auto white_oh_ht_queued = simulator.get_hit_probabilities_white_oh_queued();
 
-    simulator.simulate(character, true);
+    // the main run goes through the result cache like the analyses, so repeating a request (e.g. with other output
+    // options) only runs what changed. the simulator above only computes the hit tables and the use effect schedule
+    const auto base = Combat_simulator::simulate_result(base_config, character, true);
 #ifdef TEST_VIA_CONFIG
-    print_results(simulator, true);
+    print_results(*base, base_config, true);
 #endif
 
-    const auto base_dps = simulator.get_dps_distribution();
+    const auto& base_dps = base->dps;
     std::vector<double> mean_dps_vec{base_dps.mean()};
     std::vector<double> sample_std_dps_vec{base_dps.std_of_the_mean()};
 
-    const auto& hist_x = simulator.get_hist_x();
-    const auto& hist_y = simulator.get_hist_y();
+    assert(base->dps_histogram);
+    const auto& dps_histogram = *base->dps_histogram;
+    const auto& hist_x = Combat_simulator::get_hist_x(dps_histogram);
+    const auto& hist_y = Combat_simulator::get_hist_y(dps_histogram);
 
-    const auto& dmg_dist = simulator.get_damage_distribution();
+    const auto& dmg_dist = base->damage_sources;
     const auto& dps_dist_raw = get_damage_sources(dmg_dist);
 
     std::vector<std::string> use_effects_schedule_string{};
     {
+        simulator.add_talent_effects(character);
+        simulator.add_use_effects(character);
         auto use_effects_schedule = simulator.compute_use_effects_schedule(character);
         for (auto it = use_effects_schedule.crbegin(); it != use_effects_schedule.crend(); ++it)
         {
@@ -878,9 +1125,9 @@ Sim_output Sim_interface::simulate(const Sim_input& input)
         }
     }
 
-    const auto& aura_uptimes = simulator.get_aura_uptimes();
-    const auto& proc_statistics = simulator.get_proc_statistics();
-    const auto& damage_time_lapse_raw = simulator.get_damage_time_lapse();
+    const auto& aura_uptimes = Combat_simulator::get_aura_uptimes(*base, base_config);
+    const auto& proc_statistics = Combat_simulator::get_proc_statistics(*base, base_config);
+    const auto& time_lapse = base->time_lapse;
     std::vector<std::string> time_lapse_names;
     std::vector<std::vector<double>> damage_time_lapse;
     std::vector<double> dps_dist;
@@ -888,17 +1135,13 @@ Sim_output Sim_interface::simulate(const Sim_input& input)
                                              "Heroic Strike", "Cleave",           "Whirlwind",   "Hamstring",
                                              "Deep Wounds",   "Item Hit Effects", "Overpower",   "Slam",
                                              "Mortal Strike", "Sweeping Strikes", "Sword Specialization"};
-    for (size_t i = 0; i < damage_time_lapse_raw.size(); i++)
+    for (size_t i = 0; i < Damage_sources::n_sources; i++)
     {
-        double total_damage = 0;
-        for (const auto& damage : damage_time_lapse_raw[i])
-        {
-            total_damage += damage;
-        }
-        if (total_damage > 0)
+        const auto source = static_cast<Damage_source>(i);
+        if (time_lapse.total(source) > 0)
         {
             time_lapse_names.push_back(damage_names[i]);
-            damage_time_lapse.push_back(damage_time_lapse_raw[i]);
+            damage_time_lapse.push_back(time_lapse.series(source));
             dps_dist.push_back(dps_dist_raw[i]);
         }
     }
@@ -909,9 +1152,9 @@ Sim_output Sim_interface::simulate(const Sim_input& input)
     std::string rage_info = "<b>Rage Statistics:</b><br>";
     rage_info += "(Average per simulation)<br>";
     rage_info += "Rage lost to rage cap (gaining rage when at 100): <b>" +
-                 String_helpers::string_with_precision(simulator.get_rage_lost_capped() / base_dps.samples(), 3) + "</b><br>";
+                 String_helpers::string_with_precision(base->rage_lost_capped / base_dps.samples(), 3) + "</b><br>";
     rage_info += "</b>Rage lost when changing stance: <b>" +
-                 String_helpers::string_with_precision(simulator.get_rage_lost_stance() / base_dps.samples(), 3) + "</b><br>";
+                 String_helpers::string_with_precision(base->rage_lost_stance / base_dps.samples(), 3) + "</b><br>";
 
     std::string extra_info_string = "<b>Fight stats vs. target:</b><br>";
     extra_info_string += "<b>Hit:</b><br>";
@@ -948,51 +1191,49 @@ Sim_output Sim_interface::simulate(const Sim_input& input)
     }
     extra_info_string += "<br><br>";
 
-    std::string dpr_info = "<br>(Hint: Ability damage per rage computations can be turned on under 'Simulation settings')";
+    // the analyses below are independent sub-simulations. they are all queued up front and run concurrently by the pool
+    // (config.n_threads threads, counting this one), so the slowest of them bounds the latency
+    Task_pool pool{config.n_threads - 1};
+    config.n_threads = 1;
+
+    Pending_text dpr_info;
     if (String_helpers::find_string(input.options, "compute_dpr"))
     {
-        compute_dpr(character, simulator, base_dps, dmg_dist, dpr_info);
+        dpr_info = compute_dpr(pool, character, *base, config);
+    }
+    else
+    {
+        append(dpr_info, "<br>(Hint: Ability damage per rage computations can be turned on under 'Simulation settings')");
     }
 
-    std::string talents_info = "<br>(Hint: Talent stat-weights can be activated under 'Simulation settings')";
+    Pending_text talents_info;
     if (String_helpers::find_string(input.options, "talents_stat_weights"))
     {
         config.n_batches = static_cast<int>(String_helpers::find_value(input.float_options_string, input.float_options_val, "n_simulations_talent_dd"));
-        talents_info = compute_talent_weights(config, character, base_dps);
+        talents_info = compute_talent_weights(pool, config, character, base->dps_samples);
     }
-#ifdef TEST_VIA_CONFIG
-    if (talents_info.find("Value per 1 talent point") != std::string::npos)
+    else
     {
-        for (size_t ppos = 0, pos = talents_info.find("<br>", ppos); pos != std::string::npos; ppos = pos + 4, pos = talents_info.find("<br>", ppos))
-        {
-            std::cout << talents_info.substr(ppos, pos - ppos) << std::endl;
-        }
+        append(talents_info, "<br>(Hint: Talent stat-weights can be activated under 'Simulation settings')");
     }
-    std::cout << std::endl;
-#endif
 
+    std::future<Distribution> compare_dps;
     if (input.compare_armor.size() == 15 && input.compare_weapons.size() == 2)
     {
-        Character character2 = character_setup(armory, input.race[0], input.compare_armor, input.compare_weapons,
+        Character character2 = character_setup(armory, buffs, input.race[0], input.compare_armor, input.compare_weapons,
                                                temp_buffs, input.talent_string, input.talent_val, input.enchants, input.gems);
 
-        auto compare_dps = Combat_simulator::simulate(config, character2);
-
-        double mean_init_2 = compare_dps.mean();
-        double sample_std_init_2 = compare_dps.std_of_the_mean();
+        compare_dps = pool.submit([config, character2]() { return Combat_simulator::simulate(config, character2); });
 
         character_stats = get_character_stat(character, character2);
-
-        mean_dps_vec.push_back(mean_init_2);
-        sample_std_dps_vec.push_back(sample_std_init_2);
     }
 
-    std::string item_strengths_string;
-    if (String_helpers::find_string(input.options, "suggestion_disclaimer") && (String_helpers::find_string(input.options, "item_strengths") || String_helpers::find_string(input.options, "wep_strengths")))
+    Pending_text item_strengths;
+    if (String_helpers::find_string(input.options, "suggestion_disclaimer") && (String_helpers::find_string(input.options, "item_strengths") || String_helpers::find_string(input.options, "wep_strengths") || String_helpers::find_string(input.options, "gear_optimizer")))
     {
-        item_strengths_string = "<b>Character items and proposed upgrades:</b><br>";
+        append(item_strengths, "<b>Character items and proposed upgrades:</b><br>");
 
-        Character character_new = character_setup(armory, input.race[0], input.armor, input.weapons, temp_buffs,
+        Character character_new = character_setup(armory, buffs, input.race[0], input.armor, input.weapons, temp_buffs,
                                                   input.talent_string, input.talent_val, input.enchants, input.gems);
         std::string dummy{};
         std::vector<Socket> all_sockets = {
@@ -1006,12 +1247,12 @@ Sim_output Sim_interface::simulate(const Sim_input& input)
             {
                 if (socket == Socket::ring || socket == Socket::trinket)
                 {
-                    item_upgrades(item_strengths_string, config, character_new, armory, base_dps, socket, true);
-                    item_upgrades(item_strengths_string, config, character_new, armory, base_dps, socket, false);
+                    item_upgrades(item_strengths, pool, config, character_new, armory, base->dps_samples, socket, true);
+                    item_upgrades(item_strengths, pool, config, character_new, armory, base->dps_samples, socket, false);
                 }
                 else
                 {
-                    item_upgrades(item_strengths_string, config, character_new, armory, base_dps, socket, true);
+                    item_upgrades(item_strengths, pool, config, character_new, armory, base->dps_samples, socket, true);
                 }
             }
         }
@@ -1020,37 +1261,33 @@ Sim_output Sim_interface::simulate(const Sim_input& input)
             const auto& tl = character_new.talents;
             if (tl.sword_specialization != tl.mace_specialization || tl.sword_specialization != tl.poleaxe_specialization)
             {
-                item_strengths_string += "Consider comparing weapons with all weapon specializations set to the same value (e.g. 5/5).<br><br>";
+                append(item_strengths, "Consider comparing weapons with all weapon specializations set to the same value (e.g. 5/5).<br><br>");
             }
 
             if (is_dual_wield)
             {
-                wep_upgrades(item_strengths_string, config, character_new, armory, base_dps, Weapon_socket::main_hand);
-                wep_upgrades(item_strengths_string, config, character_new, armory, base_dps, Weapon_socket::off_hand);
+                wep_upgrades(item_strengths, pool, config, character_new, armory, base->dps_samples, Weapon_socket::main_hand);
+                wep_upgrades(item_strengths, pool, config, character_new, armory, base->dps_samples, Weapon_socket::off_hand);
             }
             else
             {
-                wep_upgrades(item_strengths_string, config, character_new, armory, base_dps, Weapon_socket::two_hand);
+                wep_upgrades(item_strengths, pool, config, character_new, armory, base->dps_samples, Weapon_socket::two_hand);
             }
         }
-        item_strengths_string += "<br><br>";
-    }
-
-#ifdef TEST_VIA_CONFIG
-    if (!item_strengths_string.empty())
-    {
-        for (size_t ppos = 0, pos = item_strengths_string.find("<br>", ppos); pos != std::string::npos; ppos = pos + 4, pos = item_strengths_string.find("<br>", ppos))
+        if (String_helpers::find_string(input.options, "gear_optimizer"))
         {
-            std::cout << item_strengths_string.substr(ppos, pos - ppos) << std::endl;
+            item_strengths.emplace_back(pool.submit([&pool, config, character_new, &armory, &base]() {
+                return best_gear_setups(pool, config, character_new, armory, base->dps_samples);
+            }));
         }
+        append(item_strengths, "<br><br>");
     }
-#endif
 
-    std::vector<std::string> sw_strings{};
+    Pending_text stat_weights;
     if (!input.stat_weights.empty())
     {
         config.n_batches = static_cast<int>(String_helpers::find_value(input.float_options_string, input.float_options_val, "n_simulations_stat_dd"));
-        sw_strings = compute_stat_weights(config, character, base_dps, input.stat_weights);
+        stat_weights = compute_stat_weights(pool, config, character, base->dps_samples, input.stat_weights);
     }
 
     std::string debug_topic{};
@@ -1069,37 +1306,71 @@ Sim_output Sim_interface::simulate(const Sim_input& input)
 
         auto f = 1.0 / (config.sim_time * base_dps.samples());
         debug_topic += "DPS from sources:<br>";
-        debug_topic += "DPS white MH: " + String_helpers::string_with_precision(dmg_dist.white_mh_damage * f, 2) + "<br>";
-        if (dmg_dist.white_mh_count > 0) debug_topic += "DPS white OH: " + String_helpers::string_with_precision(dmg_dist.white_oh_damage * f, 2) + "<br>";
-        if (dmg_dist.bloodthirst_count > 0) debug_topic += "DPS bloodthirst: " + String_helpers::string_with_precision(dmg_dist.bloodthirst_damage * f, 2) + "<br>";
-        if (dmg_dist.mortal_strike_count > 0) debug_topic += "DPS mortal strike: " + String_helpers::string_with_precision(dmg_dist.mortal_strike_damage * f, 2) + "<br>";
-        if (dmg_dist.sweeping_strikes_count > 0) debug_topic += "DPS sweeping strikes: " + String_helpers::string_with_precision(dmg_dist.sweeping_strikes_damage * f, 2) + "<br>";
-        if (dmg_dist.overpower_count > 0) debug_topic += "DPS overpower: " + String_helpers::string_with_precision(dmg_dist.overpower_damage * f, 2) + "<br>";
-        if (dmg_dist.slam_count > 0) debug_topic += "DPS slam: " + String_helpers::string_with_precision(dmg_dist.slam_damage * f, 2) + "<br>";
-        if (dmg_dist.execute_count > 0) debug_topic += "DPS execute: " + String_helpers::string_with_precision(dmg_dist.execute_damage * f, 2) + "<br>";
-        if (dmg_dist.heroic_strike_count > 0) debug_topic += "DPS heroic strike: " + String_helpers::string_with_precision(dmg_dist.heroic_strike_damage * f, 2) + "<br>";
-        if (dmg_dist.cleave_count > 0) debug_topic += "DPS cleave: " + String_helpers::string_with_precision(dmg_dist.cleave_damage * f, 2) + "<br>";
-        if (dmg_dist.whirlwind_damage > 0) debug_topic += "DPS whirlwind: " + String_helpers::string_with_precision(dmg_dist.whirlwind_damage * f, 2) + "<br>";
-        if (dmg_dist.hamstring_count > 0) debug_topic += "DPS hamstring: " + String_helpers::string_with_precision(dmg_dist.hamstring_damage * f, 2) + "<br>";
-        if (dmg_dist.deep_wounds_count > 0) debug_topic += "DPS deep wounds: " + String_helpers::string_with_precision(dmg_dist.deep_wounds_damage * f, 2) + "<br>";
-        if (dmg_dist.item_hit_effects_count > 0) debug_topic += "DPS item effects: " + String_helpers::string_with_precision(dmg_dist.item_hit_effects_damage * f, 2) + "<br><br>";
+        for (const auto& [source, label] : damage_source_labels)
+        {
+            if (source != Damage_source::white_mh && dmg_dist.count_of(source) == 0) continue;
+            debug_topic += "DPS " + label + ": " + String_helpers::string_with_precision(dmg_dist.damage_of(source) * f, 2) + "<br>";
+        }
+        debug_topic += "<br>";
 
         auto g = 1.0 / base_dps.samples();
         debug_topic += "Casts:<br>";
-        debug_topic += "#Hits white MH: " + String_helpers::string_with_precision(dmg_dist.white_mh_count * g, 2) + "<br>";
-        if (dmg_dist.white_oh_count > 0) debug_topic += "#Hits white OH: " + String_helpers::string_with_precision(dmg_dist.white_oh_count * g, 2) + "<br>";
-        if (dmg_dist.bloodthirst_count > 0) debug_topic += "#Hits bloodthirst: " + String_helpers::string_with_precision(dmg_dist.bloodthirst_count * g, 2) + "<br>";
-        if (dmg_dist.mortal_strike_count > 0) debug_topic += "#Hits mortal strike: " + String_helpers::string_with_precision(dmg_dist.mortal_strike_count * g, 2) + "<br>";
-        if (dmg_dist.sweeping_strikes_count > 0) debug_topic += "#Hits sweeping strikes: " + String_helpers::string_with_precision(dmg_dist.sweeping_strikes_count * g, 2) + "<br>";
-        if (dmg_dist.overpower_count > 0) debug_topic += "#Hits overpower: " + String_helpers::string_with_precision(dmg_dist.overpower_count * g, 2) + "<br>";
-        if (dmg_dist.slam_count > 0) debug_topic += "#Hits slam: " + String_helpers::string_with_precision(dmg_dist.slam_count * g, 2) + "<br>";
-        if (dmg_dist.execute_count > 0) debug_topic += "#Hits execute: " + String_helpers::string_with_precision(dmg_dist.execute_count * g, 2) + "<br>";
-        if (dmg_dist.heroic_strike_count > 0) debug_topic += "#Hits heroic strike: " + String_helpers::string_with_precision(dmg_dist.heroic_strike_count * g, 2) + "<br>";
-        if (dmg_dist.cleave_count > 0) debug_topic += "#Hits cleave: " + String_helpers::string_with_precision(dmg_dist.cleave_count * g, 2) + "<br>";
-        if (dmg_dist.whirlwind_count > 0) debug_topic += "#Hits whirlwind: " + String_helpers::string_with_precision(dmg_dist.whirlwind_count * g, 2) + "<br>";
-        if (dmg_dist.hamstring_count > 0) debug_topic += "#Hits hamstring: " + String_helpers::string_with_precision(dmg_dist.hamstring_count * g, 2) + "<br>";
-        if (dmg_dist.deep_wounds_count > 0) debug_topic += "#Hits deep_wounds: " + String_helpers::string_with_precision(dmg_dist.deep_wounds_count * g, 2) + "<br>";
-        if (dmg_dist.item_hit_effects_count > 0) debug_topic += "#Hits item effects: " + String_helpers::string_with_precision(dmg_dist.item_hit_effects_count * g, 2) + "<br>";
+        for (const auto& [source, label] : damage_source_labels)
+        {
+            if (source != Damage_source::white_mh && dmg_dist.count_of(source) == 0) continue;
+            debug_topic += "#Hits " + label + ": " + String_helpers::string_with_precision(dmg_dist.count_of(source) * g, 2);
+            const double rolled = dmg_dist.rolled_count_of(source);
+            if (rolled > 0)
+            {
+                auto percent = [&](Hit_result hit_result) {
+                    return String_helpers::string_with_precision(100 * dmg_dist.count_of(source, hit_result) / rolled, 1) + "%";
+                };
+                debug_topic += " (crit " + percent(Hit_result::crit) + ", miss " + percent(Hit_result::miss) + ", dodge " +
+                               percent(Hit_result::dodge);
+                if (dmg_dist.count_of(source, Hit_result::glancing) > 0) debug_topic += ", glancing " + percent(Hit_result::glancing);
+                debug_topic += ")";
+            }
+            debug_topic += "<br>";
+        }
+    }
+
+    const auto dpr_text = wait_for_text(pool, dpr_info);
+
+    const auto talents_text = wait_for_text(pool, talents_info);
+#ifdef TEST_VIA_CONFIG
+    if (talents_text.find("Value per 1 talent point") != std::string::npos)
+    {
+        for (size_t ppos = 0, pos = talents_text.find("<br>", ppos); pos != std::string::npos; ppos = pos + 4, pos = talents_text.find("<br>", ppos))
+        {
+            std::cout << talents_text.substr(ppos, pos - ppos) << std::endl;
+        }
+    }
+    std::cout << std::endl;
+#endif
+
+    if (compare_dps.valid())
+    {
+        const auto dps = pool.wait(compare_dps);
+        mean_dps_vec.push_back(dps.mean());
+        sample_std_dps_vec.push_back(dps.std_of_the_mean());
+    }
+
+    const auto item_strengths_string = wait_for_text(pool, item_strengths);
+#ifdef TEST_VIA_CONFIG
+    if (!item_strengths_string.empty())
+    {
+        for (size_t ppos = 0, pos = item_strengths_string.find("<br>", ppos); pos != std::string::npos; ppos = pos + 4, pos = item_strengths_string.find("<br>", ppos))
+        {
+            std::cout << item_strengths_string.substr(ppos, pos - ppos) << std::endl;
+        }
+    }
+#endif
+
+    std::vector<std::string> sw_strings{};
+    sw_strings.reserve(stat_weights.size());
+    for (auto& stat_weight : stat_weights)
+    {
+        sw_strings.emplace_back(pool.wait(stat_weight));
     }
 
     for (auto& v : sample_std_dps_vec)
@@ -1107,30 +1378,34 @@ Sim_output Sim_interface::simulate(const Sim_input& input)
         v *= q95;
     }
 
-    auto p5 = Statistics::find_cdf_quantile(Statistics::get_two_sided_p_value(0.05), 0.01);
-    auto p50 = Statistics::find_cdf_quantile(Statistics::get_two_sided_p_value(0.50), 0.01);
-    auto p95 = Statistics::find_cdf_quantile(Statistics::get_two_sided_p_value(0.95), 0.01);
+    // quantiles of the recorded samples, the dps distribution is usually skewed by procs and execute
+    const auto dps_quantile = [&dps_histogram](double q) {
+        return String_helpers::string_with_precision(dps_histogram.quantile(q), 1);
+    };
 
     std::string histogram_details(
         "Mean is " + String_helpers::string_with_precision(base_dps.mean(), 1) + " DPS, " +
         "Standard deviation is " + String_helpers::string_with_precision(base_dps.std(), 1) +  + " DPS.<br><ul>" +
-        "<li>5% of all samples are within &plusmn " + String_helpers::string_with_precision(base_dps.std() * p5, 1) + " DPS of the mean." +
-        "<li>50% of all samples are within &plusmn " + String_helpers::string_with_precision(base_dps.std() * p50, 1) + " DPS of the mean (lighter blue above)." +
-        "<li>95% of all samples are within &plusmn " + String_helpers::string_with_precision(base_dps.std() * p95, 1) + " DPS of the mean." +
+        "<li>5% of all samples are below " + dps_quantile(0.05) + " DPS." +
+        "<li>50% of all samples are between " + dps_quantile(0.25) + " and " + dps_quantile(0.75) +
+        " DPS (lighter blue above), the median is " + dps_quantile(0.5) + " DPS." +
+        "<li>95% of all samples are below " + dps_quantile(0.95) + " DPS." +
         "</ul><br>");
 
-    return {hist_x,
-            hist_y,
-            dps_dist,
-            time_lapse_names,
-            damage_time_lapse,
-            aura_uptimes,
-            use_effects_schedule_string,
-            proc_statistics,
-            sw_strings,
-            {item_strengths_string + extra_info_string + rage_info + dpr_info + talents_info, debug_topic},
-            histogram_details,
-            mean_dps_vec,
-            sample_std_dps_vec,
-            {character_stats}};
+    Sim_output output{hist_x,
+                      hist_y,
+                      dps_dist,
+                      time_lapse_names,
+                      damage_time_lapse,
+                      aura_uptimes,
+                      use_effects_schedule_string,
+                      proc_statistics,
+                      sw_strings,
+                      {item_strengths_string + extra_info_string + rage_info + dpr_text + talents_text, debug_topic},
+                      histogram_details,
+                      mean_dps_vec,
+                      sample_std_dps_vec,
+                      {character_stats}};
+    output.time_lapse_resolution = time_lapse.resolution() * 0.001;
+    return output;
 }
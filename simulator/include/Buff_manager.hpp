@@ -6,6 +6,7 @@
 #include "Rage_manager.hpp"
 #include "Use_effects.hpp"
 #include "damage_sources.hpp"
+#include "event_calendar.hpp"
 #include "logger.hpp"
 #include "sim_state.hpp"
 #include "time_keeper.hpp"
@@ -16,7 +17,7 @@ struct Over_time_buff
 {
     static constexpr int inactive = -1;
 
-    Over_time_buff(const Over_time_effect& effect, int current_time) :
+    Over_time_buff(const Over_time_effect& effect, int current_time, int timer) :
         name(effect.name),
         rage_gain(effect.rage_gain),
         damage(effect.damage),
@@ -25,7 +26,8 @@ struct Over_time_buff
         next_tick(current_time + effect.interval),
         next_fade(current_time + effect.duration),
         uptime(0),
-        last_gain(current_time) {}
+        last_gain(current_time),
+        timer(timer) {}
 
     std::string name;
 
@@ -41,21 +43,37 @@ struct Over_time_buff
     // statistics
     int64_t uptime;
     int last_gain;
+
+    int timer; // next tick in the event queue of Buff_manager
 };
 
 struct Combat_buff
 {
-    Combat_buff(const Hit_effect& hit_effect, const Special_stats& multipliers, int current_time) :
+    // buffs with a side effect when they fade, resolved from the name once
+    enum class On_fade : uint8_t
+    {
+        nothing,
+        swap_stance,
+        fade_sliver_stacks,
+    };
+
+    Combat_buff(const Hit_effect& hit_effect, const Special_stats& multipliers, int current_time, int timer) :
         name(hit_effect.name),
+        on_fade(name == "battle_stance" ? On_fade::swap_stance :
+                name == "blackened_naaru_sliver_active" ? On_fade::fade_sliver_stacks : On_fade::nothing),
         special_stats_boost(hit_effect.to_special_stats(multipliers)),
+        stat_fields(Stat_aggregator::fields_of(special_stats_boost)),
         stacks(1),
         next_fade(current_time + hit_effect.duration),
         charges(hit_effect.max_charges),
         uptime(0),
-        last_gain(current_time) {}
+        last_gain(current_time),
+        timer(timer) {}
 
     const std::string name;
+    const On_fade on_fade;
     const Special_stats special_stats_boost;
+    const uint32_t stat_fields;
     int stacks;
 
     int next_fade;
@@ -64,23 +82,28 @@ struct Combat_buff
     // statistics
     int64_t uptime;
     int last_gain;
+
+    int timer; // next fade in the event queue of Buff_manager
 };
 
 struct Hit_aura
 {
     static constexpr int inactive = -1;
 
-    Hit_aura(std::string name, int current_time, int duration) :
+    Hit_aura(std::string name, int current_time, int duration, int timer) :
         name(std::move(name)),
         next_fade(current_time + duration),
-        hit_effect_mh(nullptr),
-        hit_effect_oh(nullptr) { }
+        timer(timer) { }
 
     std::string name;
     int next_fade;
 
-    Hit_effect* hit_effect_mh; // disabled on next_fade
-    Hit_effect* hit_effect_oh;
+    // the hit effects enabled by the aura (indices into the hit effects of the weapons, whose vectors grow with every
+    // new aura), disabled on next_fade
+    int hit_effect_mh{-1};
+    int hit_effect_oh{-1};
+
+    int timer;
 };
 
 class Buff_manager
@@ -94,76 +117,77 @@ public:
     void update_aura_uptimes(int current_time);
     [[nodiscard]] std::unordered_map<std::string, double> get_aura_uptimes_map() const;
 
+    // earliest_event is a lower bound, a buff which is refreshed keeps it (like the old minimum per buff type). that
+    //  costs an empty step at worst, which is cheaper than looking for the exact next event every time
     [[nodiscard]] int next_event(int current_time) const
     {
-        auto next_event = std::numeric_limits<int>::max();
-        if (min_combat_buff > current_time && min_combat_buff < next_event) next_event = min_combat_buff;
-        if (min_over_time_buff > current_time && min_over_time_buff < next_event) next_event = min_over_time_buff;
-        if (min_hit_aura > current_time && min_hit_aura < next_event) next_event = min_hit_aura;
-        if (min_use_effect > current_time && min_use_effect < next_event) next_event = min_use_effect;
-        return next_event;
+        return earliest_event > current_time ? earliest_event : events.next_after(current_time);
     }
 
-    void increment(Time_keeper& time_keeper, Logger& logger);
-
-    void remove_charge(const Hit_effect& hit_effect, int current_time, Logger& logger);
-
-    void start_cooldown(const Hit_effect& hit_effect, int current_time) const
+    void increment(Time_keeper& time_keeper, Logger& logger)
     {
-        if (hit_effect.cooldown == 0) return;
-
-        for (auto& hit_effect_mh : *hit_effects_mh)
-        {
-            if (hit_effect_mh.name == hit_effect.name)
-            {
-                hit_effect_mh.time_counter = current_time + hit_effect.cooldown;
-                break;
-            }
-        }
-        for (auto& hit_effect_oh : *hit_effects_oh)
-        {
-            if (hit_effect_oh.name == hit_effect.name)
-            {
-                hit_effect_oh.time_counter = current_time + hit_effect.cooldown;
-                break;
-            }
-        }
+        if (time_keeper.time >= earliest_event) do_increment(time_keeper, logger);
     }
 
+    void remove_charge(const Hit_effect& hit_effect, int current_time, Logger& logger);
+
     void add_combat_buff(Hit_effect& hit_effect, int current_time);
     void add_hit_aura(const std::string& name, Hit_effect& hit_effect, int duration, int current_time);
     void add_over_time_buff(Over_time_effect& over_time_effect, int current_time);
 
-    bool need_to_recompute_hit_tables{};
-    bool need_to_recompute_mitigation{};
-
 private:
-    void increment_combat_buffs(int current_time, Logger& logger);
-    void increment_over_time_buffs(int current_time, Logger& logger);
-    void increment_hit_auras(int current_time, Logger& logger);
+    // what a timer of the event queue belongs to
+    struct Timer_owner
+    {
+        enum class Type
+        {
+            combat_buff,
+            over_time_buff,
+            hit_aura,
+            use_effect,
+        };
+
+        Type type;
+        size_t index;
+    };
+
+    void do_increment(Time_keeper& time_keeper, Logger& logger);
+
+    int add_timer(Timer_owner::Type type, size_t index);
+    void schedule(int timer, int time);
+
+    void fade_combat_buff(Combat_buff& buff, int current_time, Logger& logger);
+    void tick_over_time_buff(Over_time_buff& buff, int current_time, Logger& logger);
+    void fade_hit_aura(Hit_aura& hit_aura, int current_time, Logger& logger);
     void increment_use_effects(int current_time, Time_keeper& time_keeper, Logger& logger);
 
     void do_fade_buff(Combat_buff& buff, Logger& logger, int current_time);
-    void force_fade_aura_by_name(const std::string& name, Logger& logger, int current_time);
+    void force_fade_combat_buff(int combat_buff_idx, Logger& logger, int current_time);
 
-    void gain_stats(const Special_stats& ssb);
     void do_add_combat_buff(Hit_effect& hit_effect, int current_time);
     void do_add_over_time_buff(const Over_time_effect& over_time_effect, int current_time);
 
     Sim_state* sim_state{};
     Rage_manager* rage_manager{};
 
+    // fades, ticks and the next use effect, instead of scanning all buffs for the next event
+    Event_calendar<> events{};
+    std::vector<Timer_owner> timer_owners{};
+    std::vector<int> due_timers{};
+    int earliest_event{Event_calendar<>::never}; // no timer is due before this
+
     size_t use_effect_index{};
-    int min_use_effect{std::numeric_limits<int>::max()};
+    int use_effect_timer{-1};
 
     std::vector<Combat_buff> combat_buffs{};
-    int min_combat_buff{std::numeric_limits<int>::max()};
-
     std::vector<Over_time_buff> over_time_buffs{};
-    int min_over_time_buff{std::numeric_limits<int>::max()};
-
     std::vector<Hit_aura> hit_auras{};
-    int min_hit_aura{std::numeric_limits<int>::max()};
+
+    // buff ids by name, only looked up the first time an effect is added; the effect caches the id after that
+    std::unordered_map<std::string, int> combat_buff_ids{};
+    std::unordered_map<std::string, int> over_time_buff_ids{};
+    std::unordered_map<std::string, int> hit_aura_ids{};
+    int sliver_stacks_idx{-1}; // faded together with blackened_naaru_sliver_active
 
     std::vector<Hit_effect>* hit_effects_mh{};
     std::vector<Hit_effect>* hit_effects_oh{};
@@ -5,9 +5,12 @@
 #include "Character.hpp"
 #include "Config.hpp"
 #include "Distribution.hpp"
+#include "Histogram.hpp"
 #include "Rage_manager.hpp"
+#include "Result_cache.hpp"
 #include "damage_sources.hpp"
 #include "logger.hpp"
+#include "random_generator.hpp"
 #include "sim_state.hpp"
 #include "time_keeper.hpp"
 #include "weapon_sim.hpp"
@@ -16,10 +19,13 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <functional>
 #include <iomanip>
 #include <map>
 #include <vector>
 
+class Task_pool;
+
 class Combat_simulator : Rage_manager
 {
 public:
@@ -134,22 +140,25 @@ public:
         double hit_multiplier_;
     };
 
+    // cumulative roll thresholds of an attack. the name points to a literal, so the table is trivially copyable and
+    // recomputing it (on every hit or expertise change) doesn't allocate
     class Hit_table
     {
     public:
-        Hit_table(std::string name, double miss, double dodge, double glance, double crit, const Damage_multipliers& dm)
-                : name_(std::move(name)), miss_(miss), dodge_(miss + dodge), glance_(miss + dodge + glance), crit_(miss + dodge + glance + crit), dm_(dm)
+        Hit_table(const char* name, double miss, double dodge, double glance, double crit, const Damage_multipliers& dm)
+                : name_(name), miss_(miss), dodge_(miss + dodge), glance_(miss + dodge + glance), crit_(miss + dodge + glance + crit), dm_(dm)
         {
         }
 
-        Hit_table() : name_(), miss_(0), dodge_(0), glance_(0), crit_(0), dm_() {}
+        Hit_table() : name_(""), miss_(0), dodge_(0), glance_(0), crit_(0), dm_() {}
 
         void alter_white_crit(double crit_delta) { crit_ += crit_delta; }
         void alter_yellow_crit(double crit_delta) { crit_ += (100 - dodge_) / 100 * crit_delta; }
 
-        [[nodiscard]] const std::string& name() const { return name_; }
+        [[nodiscard]] const char* name() const { return name_; }
 
-        [[nodiscard]] bool isMissOrDodge() const { return rand() * 100.0 / RAND_MAX < dodge_; }
+        // roll is uniform in [0, 100)
+        [[nodiscard]] bool isMissOrDodge(double roll) const { return roll < dodge_; }
 
         [[nodiscard]] double miss() const { return miss_; }
         [[nodiscard]] double dodge() const { return dodge_ - miss_; }
@@ -159,9 +168,8 @@ public:
 
         [[nodiscard]] double glancing_penalty() const { return dm_.glance(); }
 
-        [[nodiscard]] Hit_outcome generate_hit(double damage) const
+        [[nodiscard]] Hit_outcome generate_hit(double damage, double roll) const
         {
-            auto roll = rand() * 100.0 / RAND_MAX;
             if (roll < miss_) return {0, Hit_result::miss};
             if (roll < dodge_) return {0, Hit_result::dodge, damage * dm_.hit()};
             if (roll < glance_) return {damage * dm_.glance(), Hit_result::glancing};
@@ -169,7 +177,7 @@ public:
             return {damage * dm_.hit(), Hit_result::hit};
         }
     private:
-        std::string name_;
+        const char* name_;
 
         double miss_;
         double dodge_;
@@ -218,18 +226,22 @@ public:
     [[nodiscard]] double get_rage() const final { return rage; }
 
     // TODO(vigo) turn us into hit effects :)
-    void maybe_gain_flurry(Hit_result hit_result, int& flurry_charges, Special_stats& special_stats) const;
-    void maybe_remove_flurry(int& flurry_charges, Special_stats& special_stats) const;
-    void maybe_add_rampage_stack(Hit_result hit_result, int& rampage_stacks, Special_stats& special_stats);
+    void maybe_gain_flurry(Hit_result hit_result, int& flurry_charges, Stat_aggregator& stats) const;
+    void maybe_remove_flurry(int& flurry_charges, Stat_aggregator& stats) const;
+    void maybe_add_rampage_stack(Hit_result hit_result, int& rampage_stacks, Stat_aggregator& stats);
     void unbridled_wrath(Sim_state& state, const Weapon_sim& weapon);
 
     void swing_main_hand(Sim_state& state, Extra_attack_chain chain = {});
     void swing_off_hand(Sim_state& state);
 
-    // template helper for hit_effects()
-    template<typename ...Args> void on_proc(Hit_effect& hit_effect, Args&&... args) {
+    // template helper for hit_effects(), linked is the same effect on the other weapon (or nullptr)
+    template<typename ...Args> void on_proc(Hit_effect& hit_effect, Hit_effect* linked, Args&&... args) {
         hit_effect.procs++;
-        buff_manager_.start_cooldown(hit_effect, time_keeper_.time);
+        if (hit_effect.cooldown > 0)
+        {
+            hit_effect.time_counter = time_keeper_.time + hit_effect.cooldown;
+            if (linked) linked->time_counter = hit_effect.time_counter;
+        }
         logger_.print(args...);
     }
 
@@ -259,16 +271,46 @@ public:
 
     static Distribution simulate(const Combat_simulator_config& config, const Character& character);
 
-    void normal_phase(Sim_state& state, bool mh_swing);
-    void execute_phase(Sim_state& state, bool mh_swing);
+    // the statistics of a run of the character, looked up in Result_cache::shared() first. with log_data the result
+    // also has the dps histogram and the damage time lapse
+    static std::shared_ptr<const Sim_result> simulate_result(const Combat_simulator_config& config, const Character& character,
+                                                             bool log_data = false);
+
+    // simulates every character with the same config, one task of the pool per character (each run on a single
+    // thread, config.n_threads is the pool's business). returns the dps of each character, in order
+    static std::vector<Distribution> simulate(const Combat_simulator_config& config, const std::vector<Character>& characters,
+                                              Task_pool& pool);
+
+    // simulates the character once as is and once per ablation (config.dpr_settings: the ability costs rage but has no
+    // effect) in a single pass: each iteration advances every run with the same random numbers, until config.stopping_rule
+    // is done with every difference or after config.n_batches iterations. returns the dps lost to each ablation per iteration
+    static std::vector<Distribution> simulate_ablations(const Combat_simulator_config& config, const Character& character,
+                                                        const std::vector<Combat_simulator_config::dpr_t>& ablations);
+
+    // races the candidates against the iterations of base_samples (a run with config.common_random_numbers): they all
+    // advance in rounds of round_size iterations. a candidate is done once the rule is done with its difference to the
+    // base, or once the rule's sign test finds it worse than the best candidate (over the iterations both have run, from
+    // rule.min_samples() on). the iterations left go to the close calls. returns the difference of each candidate to the
+    // base per iteration, in order
+    static std::vector<Distribution> simulate_race(const Combat_simulator_config& config,
+                                                   const std::vector<Character>& candidates,
+                                                   const std::vector<double>& base_samples, StoppingRule rule,
+                                                   int round_size = 100);
+
+    // accumulates the statistics of another (finished) simulator, e.g. a worker of simulate_parallel()
+    void merge(const Combat_simulator& other);
+
     void queue_next_melee();
 
     void update_swing_timers(Sim_state& state, double oldHaste);
 
-    static double get_uniform_random(double r_max) { return rand() * r_max / RAND_MAX; }
+    double get_uniform_random(double r_max) { return rng_.uniform(r_max); }
+
+    [[nodiscard]] bool is_miss_or_dodge(const Hit_table& hit_table) { return hit_table.isMissOrDodge(get_uniform_random(100)); }
 
     [[nodiscard]] static double rage_generation(Sim_state& state, const Hit_outcome& hit_outcome, const Weapon_sim& weapon);
 
+    // records the outcome of a hit in the combat log, callers check logger_.is_enabled() first
     void cout_damage_parse(const Weapon_sim& weapon, const Hit_table& hit_table, const Hit_outcome& hit_outcome);
 
     Hit_outcome generate_hit(Sim_state& state, const Weapon_sim& weapon, const Hit_table& hit_table, double damage,
@@ -292,34 +334,50 @@ public:
 
     [[nodiscard]] const Hit_table& get_hit_probabilities_yellow_oh() const { return hit_table_yellow_oh_; }
 
-    void add_damage_source_to_time_lapse(const std::vector<Damage_instance>& damage_instances);
-
-    [[nodiscard]] std::vector<std::string> get_aura_uptimes() const;
-    [[nodiscard]] bool filter_aura_from_statistics(std::string aura_name) const;
-    [[nodiscard]] std::unordered_map<std::string, double> get_aura_uptimes_map() const { return buff_manager_.get_aura_uptimes_map(); }
+    // the uptimes and procs (per iteration) of a run with config, formatted as "<name> <value>"
+    [[nodiscard]] static std::vector<std::string> get_aura_uptimes(const Sim_result& result,
+                                                                   const Combat_simulator_config& config);
+    [[nodiscard]] static bool filter_aura_from_statistics(const std::string& aura_name);
+    [[nodiscard]] const std::unordered_map<std::string, double>& get_aura_uptimes_map() const { return aura_uptimes_; }
 
     [[nodiscard]] const std::unordered_map<std::string, int>& get_proc_data() const { return proc_data_; }
 
-    [[nodiscard]] std::vector<std::string> get_proc_statistics() const;
-    [[nodiscard]] bool filter_proc_from_statistics(std::string proc_name) const;
+    [[nodiscard]] static std::vector<std::string> get_proc_statistics(const Sim_result& result,
+                                                                      const Combat_simulator_config& config);
+    [[nodiscard]] static bool filter_proc_from_statistics(const std::string& proc_name);
 
     void reset_time_lapse();
 
-    [[nodiscard]] const std::vector<std::vector<double>>& get_damage_time_lapse() const { return damage_time_lapse_; };
+    // damage per source and time bucket (of config.time_lapse_resolution), averaged over the iterations
+    [[nodiscard]] const Time_lapse& get_damage_time_lapse() const { return time_lapse_; };
 
     [[nodiscard]] std::string get_debug_topic() const;
 
+    // the combat log of the last iteration as events (see Logger), only recorded with config.display_combat_debug
+    [[nodiscard]] const Logger& get_combat_log() const { return logger_; }
+
     [[nodiscard]] const Damage_sources& get_damage_distribution() const { return damage_distribution_; }
 
     [[nodiscard]] const Distribution& get_dps_distribution() const { return dps_distribution_; }
 
+    // dps of every iteration in order, only recorded with config.common_random_numbers
+    [[nodiscard]] const std::vector<double>& get_dps_samples() const { return dps_samples_; }
+
+    // the statistics of the run which Result_cache keeps
+    [[nodiscard]] Sim_result get_result() const;
+
     [[nodiscard]] double get_rage_lost_stance() const { return rage_lost_stance_swap_; }
     [[nodiscard]] double get_rage_lost_capped() const { return rage_lost_capped_; }
 
     [[nodiscard]] double get_avg_rage_spent_executing() const { return avg_rage_spent_executing_; }
 
-    [[nodiscard]] const std::vector<int>& get_hist_x() const { return hist_x; }
-    [[nodiscard]] const std::vector<int>& get_hist_y() const { return hist_y; }
+    // the dps histogram (only recorded when logging data) without the empty buckets at either end, as the lower bound and
+    //  the count of each bucket
+    [[nodiscard]] std::vector<int> get_hist_x() const { return get_hist_x(dps_histogram_); }
+    [[nodiscard]] std::vector<int> get_hist_y() const { return get_hist_y(dps_histogram_); }
+    [[nodiscard]] static std::vector<int> get_hist_x(const Histogram& histogram);
+    [[nodiscard]] static std::vector<int> get_hist_y(const Histogram& histogram);
+    [[nodiscard]] const Histogram& get_dps_histogram() const { return dps_histogram_; }
 
     [[nodiscard]] double get_flurry_uptime() const { return flurry_uptime_; }
     [[nodiscard]] double get_hs_uptime() const { return oh_queued_uptime_; }
@@ -327,8 +385,6 @@ public:
 
     void init_histogram();
 
-    void prune_histogram();
-
     void normalize_timelapse();
 
     Combat_simulator_config config;
@@ -347,6 +403,52 @@ public:
     const Over_time_effect anger_management = {"anger_management", {}, 1, 0, 3, 600};
 
 private:
+    // the rotation features the combat loop branches on. run_batches() picks a kernel once per simulate(): the common
+    // setups get an instantiation with their features fixed at compile time, everything else runs the generic kernel,
+    // which looks them up in rotation_features_
+    struct Rotation_kernel
+    {
+        enum Feature : unsigned
+        {
+            dual_wield = 1,
+            bloodthirst = 2,
+            mortal_strike = 4,
+            slam = 8,
+            multi_target = 16,
+        };
+
+        static constexpr unsigned generic = ~0u;
+        static constexpr unsigned fury_dual_wield = dual_wield | bloodthirst;
+        static constexpr unsigned arms_slam = mortal_strike | slam;
+    };
+
+    template <unsigned Kernel>
+    [[nodiscard]] bool uses(Rotation_kernel::Feature feature) const
+    {
+        if constexpr (Kernel == Rotation_kernel::generic)
+        {
+            return (rotation_features_ & feature) != 0;
+        }
+        else
+        {
+            return (Kernel & feature) != 0;
+        }
+    }
+
+    using Iteration_kernel = void (Combat_simulator::*)(const Character& character, bool log_data);
+
+    void run_batches(const Character& character, const std::function<bool(const Distribution&)>& target, bool log_data);
+    // sets up the weapons, effects and buffs of the character, returns the combat loop of one iteration for its rotation
+    Iteration_kernel prepare_batches(const Character& character);
+    template <unsigned Kernel>
+    void run_iteration(const Character& character, bool log_data);
+    void finish_batches();
+    template <unsigned Kernel>
+    void normal_phase(Sim_state& state, bool mh_swing);
+    template <unsigned Kernel>
+    void execute_phase(Sim_state& state, bool mh_swing);
+    void simulate_parallel(const Character& character, int n_workers, bool log_data);
+
     [[nodiscard]] static int to_millis(double seconds) { return Time_keeper::to_millis(seconds); }
     [[nodiscard]] int from_offset(double offset) const { return time_keeper_.from_offset(offset); }
 
@@ -367,6 +469,13 @@ private:
 
     Logger logger_{};
 
+    // set up by prepare_batches(), the buff manager and the procs point into these
+    std::vector<Weapon_sim> weapons_{};
+    std::vector<Hit_effect> no_hit_effects_{}; // hit effects of the missing off hand
+    Use_effects::Schedule use_effect_schedule_{};
+
+    Random_stream rng_{};
+
     // config related
     double armor_reduction_factor_{};
     double armor_reduction_factor_add{};
@@ -384,6 +493,7 @@ private:
     int tactical_mastery_rage_{};
 
     Special_stats flurry_{};
+    Special_stats rampage_stack_{0, 0, 50};
 
     bool deep_wounds_{};
     bool use_bloodthirst_{};
@@ -391,6 +501,7 @@ private:
     bool use_mortal_strike_{};
     bool use_sweeping_strikes_{};
     bool have_flurry_{};
+    unsigned rotation_features_{}; // Rotation_kernel::Feature flags
 
     int sweeping_strikes_charges_{};
     int sunder_armor_stacks_{};
@@ -407,10 +518,15 @@ private:
     Hit_effect battle_stance_{"battle_stance", Hit_effect::Type::stat_boost, {}, {-3.0, 0, 0}, 0, 1.5, 0, 0};
     Hit_effect destroyer_2_set_{"destroyer_2_set", Hit_effect::Type::stat_boost, {}, {0, 0, 100}, 0, 5, 0, 0};
     Hit_effect windfury_attack_{"windfury_attack", Hit_effect::Type::stat_boost, {}, {0, 0, 445}, 0, 1.5, 0, 0, 0, 2};
+    // 20s buff which adds a stack of the latter on each subsequent hit (no cooldown, 100% chance, max 10 stacks)
+    Hit_effect blackened_naaru_sliver_active_{"blackened_naaru_sliver_active", Hit_effect::Type::blackened_naaru_sliver_active, {}, {}, 0, 20, 0, 1};
+    Hit_effect blackened_naaru_sliver_stacks_{"blackened_naaru_sliver_stacks", Hit_effect::Type::stat_boost, {}, {0, 0, 44}, 0, 20, 0, 0, 0, 1, 0, 10};
 
     // statistics
     Damage_sources damage_distribution_{};
     Distribution dps_distribution_{};
+    std::vector<double> dps_samples_{};
+    int first_iteration_{}; // index of this simulators first iteration, workers of simulate_parallel() start later
 
     double flurry_uptime_{};
     double oh_queued_uptime_{};
@@ -425,13 +541,12 @@ private:
     double avg_rage_spent_executing_{};
 
     std::unordered_map<std::string, int> proc_data_{};
+    std::unordered_map<std::string, double> aura_uptimes_{};
 
-    static constexpr int time_lapse_resolution = 500; // time lapse bucket size (in ms)
     static constexpr int histogram_dps_resolution = 20; // histogram bucket size (in dps)
 
-    std::vector<std::vector<double>> damage_time_lapse_{};
-    std::vector<int> hist_x{};
-    std::vector<int> hist_y{};
+    Time_lapse time_lapse_{};
+    Histogram dps_histogram_{histogram_dps_resolution};
 
     bool has_run{}; // TODO(vigo) remove me soonish
 };
@@ -1,11 +1,13 @@
 #ifndef COMBAT_SIMULATOR_CONFIG_HPP
 #define COMBAT_SIMULATOR_CONFIG_HPP
 
+#include "StoppingRule.hpp"
 #include "sim_input.hpp"
 #include "string_helpers.hpp"
 #include "find_values.hpp"
 #include "time_keeper.hpp"
 
+// every field is part of the key of cached results, new fields have to be added to Sim_hash::add(config) as well
 struct Combat_simulator_config
 {
     Combat_simulator_config() = default;
@@ -21,13 +23,23 @@ struct Combat_simulator_config
     [[nodiscard]] static int to_millis(double seconds) { return Time_keeper::to_millis(seconds); }
 
     int n_batches{};
+    int n_threads{1}; // worker threads used by Combat_simulator::simulate(character), batches are split evenly
+    // when Combat_simulator::simulate(character) may stop before n_batches (which replaces its max_samples), e.g. once
+    // the mean dps is known to the precision an analysis needs
+    StoppingRule stopping_rule{};
 
     bool display_combat_debug{};
     //bool display_histogram{};
     //bool display_time_lapse{};
     int seed{};
+    // reseed the random numbers at the start of every iteration from (seed, iteration) and keep the dps of each
+    // iteration, so two setups simulated with the same seed can be compared pairwise (see get_dps_samples())
+    bool common_random_numbers{};
+    // always run the generic combat loop instead of one specialized for the rotation (for benchmarks and debugging)
+    bool generic_rotation_kernel{};
 
     double sim_time{};
+    double time_lapse_resolution{0.5}; // time lapse bucket size (in s), only used if the simulator logs data
 
     int main_target_level{};
     int main_target_initial_armor_{};
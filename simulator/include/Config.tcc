@@ -6,9 +6,21 @@ void Combat_simulator_config::parse_combat_simulator_config(const T& input)
     // n_batches - set from e.g. n_simulations_talent_dd
 
     // combat_debug - special run mode "debug on"
-    // seed - only used in multi, at the moment
+    // seed - set in the Sim_input constructor, seeds the per-simulator random generator
+
+#ifndef __EMSCRIPTEN__
+    n_threads = std::max(1, static_cast<int>(fv.find("n_threads_dd", 1)));
+#endif
+
+    // stop once the mean dps is known to +-target_precision at 95%, 0 runs all n_batches
+    const auto target_precision = fv.find("target_precision_dd", 0);
+    if (target_precision > 0)
+    {
+        stopping_rule.with_precision(target_precision).with_min_samples(100);
+    }
 
     sim_time = fv.find("fight_time_dd"); // TODO(vigo) probably convert to millis as well - but this is kinda infiltrative
+    time_lapse_resolution = fv.find("time_lapse_resolution_dd", 0.5);
 
     main_target_level = fv.find("opponent_level_dd");
     main_target_initial_armor_ = fv.find("boss_armor_dd");
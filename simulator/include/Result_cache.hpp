@@ -0,0 +1,119 @@
+#ifndef WOW_SIMULATOR_RESULT_CACHE_HPP
+#define WOW_SIMULATOR_RESULT_CACHE_HPP
+
+#include "Character.hpp"
+#include "Config.hpp"
+#include "Distribution.hpp"
+#include "Histogram.hpp"
+#include "damage_sources.hpp"
+#include "time_lapse.hpp"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// the statistics of a finished run which are kept in the cache
+struct Sim_result
+{
+    Distribution dps{};
+    std::vector<double> dps_samples{}; // only recorded with config.common_random_numbers
+    Damage_sources damage_sources{};
+    std::unordered_map<std::string, double> aura_uptimes{};
+    std::unordered_map<std::string, int> proc_data{};
+
+    // see the getters of Combat_simulator of the same name
+    double flurry_uptime{};
+    double hs_uptime{};
+    double rampage_uptime{};
+    double rage_lost_stance{};
+    double rage_lost_capped{};
+    double avg_rage_spent_executing{};
+
+    // only recorded when logging data
+    std::optional<Histogram> dps_histogram{};
+    Time_lapse time_lapse{};
+};
+
+// 64 bit FNV-1a hash of a canonical encoding of everything a run depends on: every field of the config and what the
+// simulator reads of the character (items, enchants, gems, buffs, talents and total stats). floating point values are
+// hashed by their bits, so only identical inputs share a hash
+class Sim_hash
+{
+public:
+    // salts every hash: a hash of the sources of the simulator and the libraries it uses, generated by CMake. any change
+    // to them (which could change results) gives new keys, so the disk cache of an older build is never read
+    static const uint64_t source_hash;
+
+    Sim_hash();
+
+    Sim_hash& add(const Combat_simulator_config& config);
+    Sim_hash& add(const Character& character);
+    Sim_hash& add(const StoppingRule& rule);
+    Sim_hash& add(const std::vector<double>& values);
+    Sim_hash& add(const std::string& value);
+    Sim_hash& add(double value);
+    Sim_hash& add(int64_t value);
+    Sim_hash& add(int value) { return add(static_cast<int64_t>(value)); }
+    Sim_hash& add(bool value) { return add(static_cast<int64_t>(value)); }
+
+    [[nodiscard]] uint64_t value() const { return hash_; }
+
+private:
+    void add_bytes(const void* data, size_t size);
+
+    uint64_t hash_;
+};
+
+// results of finished runs, addressed by their Sim_hash. repeated requests (the same gear and config, or the same
+// baseline in batch jobs) become a lookup. the most recently used results are kept in memory up to capacity_bytes;
+// with a directory every result is also written to (and looked up in) a file named after its hash
+class Result_cache
+{
+public:
+    explicit Result_cache(size_t capacity_bytes, std::string directory = {});
+
+    // nullptr if neither the memory nor the disk cache has the result
+    [[nodiscard]] std::shared_ptr<const Sim_result> find(uint64_t key);
+
+    // returns the result as it's kept in the cache
+    std::shared_ptr<const Sim_result> insert(uint64_t key, Sim_result result);
+
+    // 0 disables the memory cache
+    void set_capacity(size_t capacity_bytes);
+
+    // an empty directory disables the disk cache
+    void set_directory(std::string directory);
+
+    void clear();
+
+    // the cache of Combat_simulator::simulate(config, character) and the Sim_interface analyses, 64 MB and no disk
+    // cache by default
+    static Result_cache& shared();
+
+private:
+    struct Entry
+    {
+        uint64_t key;
+        std::shared_ptr<const Sim_result> result;
+        size_t size;
+    };
+
+    void insert_in_memory(uint64_t key, std::shared_ptr<const Sim_result> result);
+    [[nodiscard]] std::string file_name(uint64_t key) const;
+    [[nodiscard]] std::shared_ptr<const Sim_result> read(uint64_t key) const;
+    void write(uint64_t key, const Sim_result& result) const;
+
+    std::mutex mutex_;
+    size_t capacity_bytes_;
+    size_t size_bytes_{};
+    std::string directory_;
+    std::list<Entry> entries_{}; // most recently used first
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index_{};
+};
+
+#endif // WOW_SIMULATOR_RESULT_CACHE_HPP
@@ -1,9 +1,12 @@
 #ifndef WOW_SIMULATOR_DAMAGE_SOURCES_HPP
 #define WOW_SIMULATOR_DAMAGE_SOURCES_HPP
 
+#include "hit_result.hpp"
+
+#include <array>
+#include <cassert>
 #include <string>
 #include <vector>
-#include <cassert>
 
 enum class Damage_source
 {
@@ -24,67 +27,69 @@ enum class Damage_source
     size, // convenience ;)
 };
 
-struct Damage_instance
-{
-    Damage_instance(Damage_source source, double damage, int time_stamp)
-        : damage_source(source), damage(damage), time_stamp(time_stamp) {}
-
-    Damage_source damage_source;
-    double damage;
-    int time_stamp;
-};
-
 std::ostream& operator<<(std::ostream& os, Damage_source damage_source);
 
+// damage, number of casts/ticks and the hit results per damage source, indexed by Damage_source. flat arrays, so
+// merging the results of batches (or threads) is a couple of vectorized loops
 struct Damage_sources
 {
-    Damage_sources& operator+(const Damage_sources& rhs);
+    static constexpr size_t n_sources = static_cast<size_t>(Damage_source::size);
+
+    Damage_sources& operator+=(const Damage_sources& rhs);
 
     [[nodiscard]] double sum_damage_sources() const
     {
-        return white_mh_damage + white_oh_damage + bloodthirst_damage + mortal_strike_damage + slam_damage +
-               overpower_damage + heroic_strike_damage + cleave_damage + whirlwind_damage + hamstring_damage +
-               execute_damage + deep_wounds_damage + item_hit_effects_damage + sweeping_strikes_damage;
+        double sum = 0;
+        for (const auto d : damage) sum += d;
+        return sum;
     }
 
     [[nodiscard]] int sum_counts() const
     {
-        return white_mh_count + white_oh_count + bloodthirst_count + mortal_strike_count + slam_count +
-               overpower_count + heroic_strike_count + cleave_count + whirlwind_count + hamstring_count +
-               execute_count + deep_wounds_count + item_hit_effects_count + sweeping_strikes_count;
+        int sum = 0;
+        for (const auto c : counts) sum += c;
+        return sum;
+    }
+
+    void add_damage(Damage_source source, double amount)
+    {
+        assert(source < Damage_source::size);
+        damage[static_cast<size_t>(source)] += amount;
+        counts[static_cast<size_t>(source)]++;
+    }
+
+    void add_damage(Damage_source source, double amount, Hit_result hit_result)
+    {
+        add_damage(source, amount);
+        add_hit_result(source, hit_result);
+    }
+
+    // for abilities which hit more than once per cast (whirlwind, cleave)
+    void add_hit_result(Damage_source source, Hit_result hit_result)
+    {
+        hit_results[static_cast<size_t>(source) * n_hit_results + hit_result_index(hit_result)]++;
+    }
+
+    [[nodiscard]] double damage_of(Damage_source source) const { return damage[static_cast<size_t>(source)]; }
+
+    [[nodiscard]] int count_of(Damage_source source) const { return counts[static_cast<size_t>(source)]; }
+
+    [[nodiscard]] int count_of(Damage_source source, Hit_result hit_result) const
+    {
+        return hit_results[static_cast<size_t>(source) * n_hit_results + hit_result_index(hit_result)];
+    }
+
+    // hits of the source which got a hit result (deep wounds and spell procs don't roll on the hit table)
+    [[nodiscard]] int rolled_count_of(Damage_source source) const
+    {
+        int sum = 0;
+        for (size_t i = 0; i < n_hit_results; i++) sum += hit_results[static_cast<size_t>(source) * n_hit_results + i];
+        return sum;
     }
 
-    void add_damage(Damage_source source, double damage);
-
-    double white_mh_damage{};
-    double white_oh_damage{};
-    double slam_damage{};
-    double overpower_damage{};
-    double bloodthirst_damage{};
-    double mortal_strike_damage{};
-    double sweeping_strikes_damage{};
-    double execute_damage{};
-    double heroic_strike_damage{};
-    double cleave_damage{};
-    double whirlwind_damage{};
-    double hamstring_damage{};
-    double deep_wounds_damage{};
-    double item_hit_effects_damage{};
-
-    int white_mh_count{};
-    int white_oh_count{};
-    int slam_count{};
-    int overpower_count{};
-    int bloodthirst_count{};
-    int mortal_strike_count{};
-    int sweeping_strikes_count{};
-    int execute_count{};
-    int heroic_strike_count{};
-    int cleave_count{};
-    int whirlwind_count{};
-    int hamstring_count{};
-    int deep_wounds_count{};
-    int item_hit_effects_count{};
+    std::array<double, n_sources> damage{};
+    std::array<int, n_sources> counts{};
+    std::array<int, n_sources * n_hit_results> hit_results{}; // [source][hit_result_index]
 };
 
 #endif // WOW_SIMULATOR_DAMAGE_SOURCES_HPP
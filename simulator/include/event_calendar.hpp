@@ -0,0 +1,58 @@
+#ifndef WOW_SIMULATOR_EVENT_CALENDAR_HPP
+#define WOW_SIMULATOR_EVENT_CALENDAR_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <limits>
+#include <vector>
+
+// timers keyed by millisecond timestamp. a subsystem registers its timers (a fixed set, or add_timer() for e.g. buffs)
+// and (re)schedules them, the combat loop asks the calendar for the next event instead of polling every subsystem.
+// a fight only has a handful of timers, so they are kept in a flat array: scheduling is a single store, and the next
+// event is a linear scan over a few cache lines. a binary heap was measured to be slower here, nearly every step
+// reschedules the timer on top (swings, cooldowns).
+template <typename Storage = std::vector<int>>
+class Event_calendar
+{
+public:
+    static constexpr int never = std::numeric_limits<int>::max();
+
+    Event_calendar() { clear(); }
+
+    int add_timer()
+    {
+        time_.push_back(never);
+        return size() - 1;
+    }
+
+    void schedule(int timer, int time)
+    {
+        assert(timer >= 0 && timer < size());
+        time_[timer] = time;
+    }
+
+    void cancel(int timer) { time_[timer] = never; }
+
+    void clear() { std::fill(time_.begin(), time_.end(), never); }
+
+    [[nodiscard]] int time_of(int timer) const { return time_[timer]; }
+
+    [[nodiscard]] int size() const { return static_cast<int>(time_.size()); }
+
+    // earliest event strictly after the given time, timers which are due by then have fired already
+    [[nodiscard]] int next_after(int time) const
+    {
+        int next = never;
+        for (const auto t : time_)
+        {
+            if (t > time && t < next) next = t;
+        }
+        return next;
+    }
+
+private:
+    Storage time_{};
+};
+
+#endif // WOW_SIMULATOR_EVENT_CALENDAR_HPP
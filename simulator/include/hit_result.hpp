@@ -1,6 +1,10 @@
 #ifndef WOW_SIMULATOR_HIT_RESULT_HPP
 #define WOW_SIMULATOR_HIT_RESULT_HPP
 
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
 enum class Hit_result:uint8_t
 {
     miss = 0x1,
@@ -12,4 +16,14 @@ enum class Hit_result:uint8_t
     TBD = 0,
 };
 
+constexpr size_t n_hit_results = 5;
+
+// position of the flag, for tables by hit result. only for rolled outcomes, TBD has no flag (and __builtin_ctz(0)
+// is undefined)
+constexpr size_t hit_result_index(Hit_result hit_result)
+{
+    assert(hit_result != Hit_result::TBD);
+    return static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(hit_result)));
+}
+
 #endif // WOW_SIMULATOR_HIT_RESULT_HPP
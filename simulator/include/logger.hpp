@@ -1,47 +1,173 @@
 #ifndef WOW_SIMULATOR_LOGGER_HPP
 #define WOW_SIMULATOR_LOGGER_HPP
 
+#include "hit_result.hpp"
 #include "time_keeper.hpp"
-#include "string_helpers.hpp"
 
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// the combat log is compiled in unless WOW_SIMULATOR_COMBAT_LOG is switched off (see CMakeLists.txt). when it is, every
+// print() is a no-op the compiler removes along with its arguments. when it is compiled in but not enabled at runtime
+// (all but the one debug run of the website), a print() is a single predictable branch, the recording lives out of line
+#ifdef WOW_SIMULATOR_NO_COMBAT_LOG
+constexpr bool combat_log_compiled_in = false;
+#else
+constexpr bool combat_log_compiled_in = true;
+#endif
+
+// one line of the combat log. hits and rage readings are typed events, every other line is a message whose arguments
+// are stored in Logger::args()
+struct Trace_event
+{
+    enum class Kind : uint8_t
+    {
+        message,
+        hit,
+        rage,
+    };
+
+    enum class Hit_source : uint8_t
+    {
+        main_hand,
+        off_hand,
+        main_hand_ability,
+        off_hand_ability,
+    };
+
+    int time;
+    Kind kind;
+    Hit_source source;     // hit
+    Hit_result hit_result; // hit
+    uint16_t n_args;       // message
+    uint32_t first_arg;    // message
+    double value;          // hit: damage, rage: current rage
+};
+
+// argument of a message. text points to a string literal (or another string that lives as long as the program, like
+// the names of the hit tables), names of buffs and procs are interned by the logger
+struct Trace_arg
+{
+    enum class Type : uint8_t
+    {
+        text,
+        name,
+        integer,
+        real,
+    };
+
+    Type type;
+    union
+    {
+        const char* text;
+        uint32_t name;
+        int integer;
+        double real;
+    };
+};
+
+// records the combat log of the last iteration as fixed-size events into buffers that are reused between iterations.
+// the html shown by the website is only formatted when get_debug_topic() is called
 class Logger
 {
 public:
     Logger() = default;
 
-    explicit Logger(const Time_keeper& time_keeper) : display_combat_debug_(true), time_keeper_(&time_keeper)
+    explicit Logger(const Time_keeper& time_keeper) : display_combat_debug_(combat_log_compiled_in), time_keeper_(&time_keeper)
     {
-        if (display_combat_debug_) debug_topic_.reserve(128 * 1024); // just a hunch ;)
+        if (display_combat_debug_)
+        {
+            events_.reserve(16 * 1024); // just a hunch ;)
+            args_.reserve(32 * 1024);
+        }
     }
 
-    void reset() { debug_topic_.clear(); }
+    void reset()
+    {
+        events_.clear();
+        args_.clear();
+    }
+
+    [[nodiscard]] bool is_enabled() const { return combat_log_compiled_in && __builtin_expect(display_combat_debug_, false); }
+
+    [[nodiscard]] const std::vector<Trace_event>& events() const { return events_; }
+
+    [[nodiscard]] const std::vector<Trace_arg>& args() const { return args_; }
 
-    [[nodiscard]] bool is_enabled() const { return display_combat_debug_; }
+    [[nodiscard]] const std::string& name(uint32_t id) const { return names_[id]; }
 
-    [[nodiscard]] std::string get_debug_topic() const { return debug_topic_; }
+    // formats the recorded events like the old html log, one "<br>"-terminated line per event
+    [[nodiscard]] std::string get_debug_topic() const;
+
+    [[nodiscard]] static std::string format_event(const Trace_event& event, const std::vector<Trace_arg>& args,
+                                                  const std::vector<std::string>& names);
 
     template <typename... Args>
     void print(Args&&... args)
     {
-        if (display_combat_debug_)
+        if (is_enabled())
+        {
+            record_message(std::forward<Args>(args)...);
+        }
+    }
+
+    void hit(Trace_event::Hit_source source, Hit_result hit_result, double damage)
+    {
+        if (is_enabled())
+        {
+            events_.push_back({time_keeper_->time, Trace_event::Kind::hit, source, hit_result, 0, 0, damage});
+        }
+    }
+
+    void rage(double current_rage)
+    {
+        if (is_enabled())
         {
-            debug_topic_ += "Time: " + String_helpers::string_with_precision(time_keeper_->time * 0.001, 3) + "s. ";
-            __attribute__((unused)) int dummy[] = {0, ((void)print_statement(std::forward<Args>(args)), 0)...};
-            debug_topic_ += "<br>";
+            events_.push_back({time_keeper_->time, Trace_event::Kind::rage, {}, {}, 0, 0, current_rage});
         }
     }
 
 private:
-    void print_statement(const std::string& t) { debug_topic_ += t; }
+    template <typename... Args>
+    __attribute__((noinline, cold)) void record_message(Args&&... args)
+    {
+        const auto first_arg = static_cast<uint32_t>(args_.size());
+        __attribute__((unused)) int dummy[] = {0, ((void)push_arg(std::forward<Args>(args)), 0)...};
+        events_.push_back({time_keeper_->time, Trace_event::Kind::message, {}, {}, uint16_t(sizeof...(Args)), first_arg, 0});
+    }
+
+    void push_arg(const char* t)
+    {
+        Trace_arg arg{Trace_arg::Type::text, {}};
+        arg.text = t;
+        args_.push_back(arg);
+    }
 
-    void print_statement(int t) { debug_topic_ += std::to_string(t); }
+    void push_arg(const std::string& t);
 
-    void print_statement(double t) { debug_topic_ += String_helpers::string_with_precision(t, 3); }
+    void push_arg(int t)
+    {
+        Trace_arg arg{Trace_arg::Type::integer, {}};
+        arg.integer = t;
+        args_.push_back(arg);
+    }
+
+    void push_arg(double t)
+    {
+        Trace_arg arg{Trace_arg::Type::real, {}};
+        arg.real = t;
+        args_.push_back(arg);
+    }
 
     bool display_combat_debug_{};
     const Time_keeper* time_keeper_{nullptr};
 
-    std::string debug_topic_{};
+    std::vector<Trace_event> events_{};
+    std::vector<Trace_arg> args_{};
+    std::vector<std::string> names_{};
+    std::unordered_map<std::string, uint32_t> name_ids_{};
 };
 
 #endif // WOW_SIMULATOR_LOGGER_HPP
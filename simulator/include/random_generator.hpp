@@ -0,0 +1,216 @@
+#ifndef WOW_SIMULATOR_RANDOM_GENERATOR_HPP
+#define WOW_SIMULATOR_RANDOM_GENERATOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// xoshiro256+ (http://prng.di.unimi.it/), seeded via splitmix64.
+// every simulator owns its own (buffered, see Random_stream), so runs are reproducible from config.seed and threads
+// don't share any state.
+// independent substreams are obtained with jump(), which advances the state by 2^128 draws.
+class Random_generator
+{
+public:
+    Random_generator() : Random_generator(0) {}
+
+    explicit Random_generator(uint64_t seed, uint64_t stream = 0) { reseed(seed, stream); }
+
+    void reseed(uint64_t seed, uint64_t stream = 0)
+    {
+        for (auto& s : s_)
+        {
+            seed += 0x9e3779b97f4a7c15;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            s = z ^ (z >> 31);
+        }
+        for (uint64_t i = 0; i < stream; ++i)
+        {
+            jump();
+        }
+    }
+
+    uint64_t next()
+    {
+        const uint64_t result = s_[0] + s_[3];
+        const uint64_t t = s_[1] << 17;
+
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+
+        return result;
+    }
+
+    // uniform in [0, 1): exponent of 1.0 plus 52 random mantissa bits gives [1, 2)
+    double uniform() { return to_uniform(next()); }
+
+    static double to_uniform(uint64_t bits)
+    {
+        bits = (bits >> 12) | 0x3ff0000000000000;
+        double u;
+        std::memcpy(&u, &bits, sizeof(u));
+        return u - 1.0;
+    }
+
+    double uniform(double r_max) { return uniform() * r_max; }
+
+    void jump()
+    {
+        constexpr std::array<uint64_t, 4> jump_table = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa,
+                                                        0x39abdc4529b1661c};
+        std::array<uint64_t, 4> s{};
+        for (const auto j : jump_table)
+        {
+            for (int b = 0; b < 64; ++b)
+            {
+                if (j & (uint64_t{1} << b))
+                {
+                    for (size_t i = 0; i < s.size(); ++i) s[i] ^= s_[i];
+                }
+                next();
+            }
+        }
+        s_ = s;
+    }
+
+    [[nodiscard]] const std::array<uint64_t, 4>& state() const { return s_; }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    std::array<uint64_t, 4> s_{};
+};
+
+// hands out uniform doubles from a buffer which is refilled in blocks. the block is produced by n_lanes interleaved
+// xoshiro256+ generators (lane i is the substream stream * n_lanes + i of Random_generator), with AVX2 if the build
+// targets it (see WOW_SIMULATOR_NATIVE), and a plain loop over the lanes otherwise. both give identical numbers.
+// the buffer stays in L1, a single draw is then just a load and an index increment.
+class Random_stream
+{
+public:
+    static constexpr size_t n_lanes = 4;
+    static constexpr size_t block_size = 512;
+
+    Random_stream() : Random_stream(0) {}
+
+    explicit Random_stream(uint64_t seed, uint64_t stream = 0) { reseed(seed, stream); }
+
+    void reseed(uint64_t seed, uint64_t stream = 0)
+    {
+        Random_generator generator{seed};
+        for (uint64_t i = 0; i < stream * n_lanes; ++i)
+        {
+            generator.jump();
+        }
+        for (size_t lane = 0; lane < n_lanes; ++lane)
+        {
+            const auto& state = generator.state();
+            for (size_t i = 0; i < state.size(); ++i)
+            {
+                s_[i][lane] = state[i];
+            }
+            generator.jump();
+        }
+        index_ = block_size;
+    }
+
+    // cheap reseed for common random numbers: every iteration of a fight gets its own stream, derived from
+    // (seed, iteration) with splitmix64 only (no jumps), so two setups simulated with the same seed see the same rolls
+    // in the same iteration. the lanes aren't guaranteed to be disjoint, but overlaps of 2^256 periods are negligible.
+    void reseed_iteration(uint64_t seed, uint64_t iteration)
+    {
+        uint64_t x = seed ^ (iteration * 0xd1b54a32d192ed03);
+        for (size_t lane = 0; lane < n_lanes; ++lane)
+        {
+            for (size_t i = 0; i < s_.size(); ++i)
+            {
+                x += 0x9e3779b97f4a7c15;
+                uint64_t z = x;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+                s_[i][lane] = z ^ (z >> 31);
+            }
+        }
+        index_ = block_size;
+    }
+
+    // uniform in [0, 1)
+    double uniform()
+    {
+        if (index_ == block_size) refill();
+        return buffer_[index_++];
+    }
+
+    double uniform(double r_max) { return uniform() * r_max; }
+
+    void refill()
+    {
+#ifdef __AVX2__
+        auto s0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s_[0].data()));
+        auto s1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s_[1].data()));
+        auto s2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s_[2].data()));
+        auto s3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s_[3].data()));
+        const auto exponent = _mm256_set1_epi64x(0x3ff0000000000000);
+        const auto one = _mm256_set1_pd(1.0);
+        for (size_t block = 0; block < block_size; block += n_lanes)
+        {
+            const auto result = _mm256_add_epi64(s0, s3);
+            const auto t = _mm256_slli_epi64(s1, 17);
+
+            s2 = _mm256_xor_si256(s2, s0);
+            s3 = _mm256_xor_si256(s3, s1);
+            s1 = _mm256_xor_si256(s1, s2);
+            s0 = _mm256_xor_si256(s0, s3);
+
+            s2 = _mm256_xor_si256(s2, t);
+            s3 = _mm256_or_si256(_mm256_slli_epi64(s3, 45), _mm256_srli_epi64(s3, 19));
+
+            const auto bits = _mm256_or_si256(_mm256_srli_epi64(result, 12), exponent);
+            _mm256_storeu_pd(&buffer_[block], _mm256_sub_pd(_mm256_castsi256_pd(bits), one));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(s_[0].data()), s0);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(s_[1].data()), s1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(s_[2].data()), s2);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(s_[3].data()), s3);
+#else
+        for (size_t block = 0; block < block_size; block += n_lanes)
+        {
+            for (size_t lane = 0; lane < n_lanes; ++lane)
+            {
+                const uint64_t result = s_[0][lane] + s_[3][lane];
+                const uint64_t t = s_[1][lane] << 17;
+
+                s_[2][lane] ^= s_[0][lane];
+                s_[3][lane] ^= s_[1][lane];
+                s_[1][lane] ^= s_[2][lane];
+                s_[0][lane] ^= s_[3][lane];
+
+                s_[2][lane] ^= t;
+                s_[3][lane] = (s_[3][lane] << 45) | (s_[3][lane] >> 19);
+
+                buffer_[block + lane] = Random_generator::to_uniform(result);
+            }
+        }
+#endif
+        index_ = 0;
+    }
+
+private:
+    std::array<std::array<uint64_t, n_lanes>, 4> s_{};
+    std::array<double, block_size> buffer_{};
+    size_t index_{block_size};
+};
+
+#endif // WOW_SIMULATOR_RANDOM_GENERATOR_HPP
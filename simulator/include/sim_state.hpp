@@ -3,41 +3,48 @@
 
 #include "weapon_sim.hpp"
 #include "Character.hpp"
+#include "stat_aggregator.hpp"
+#include "time_lapse.hpp"
 
 struct Sim_state
 {
     Sim_state(Weapon_sim& main_hand_weapon, Weapon_sim& off_hand_weapon, bool is_dual_wield,
-              Special_stats special_stats, const Character::talents_t& talents,
-              std::vector<Damage_instance>& damage_instances, bool log_damage_instances) :
+              const Special_stats& starting_stats, const Character::talents_t& talents,
+              Time_lapse* time_lapse) :
         main_hand_weapon(main_hand_weapon),
         off_hand_weapon(off_hand_weapon),
         is_dual_wield(is_dual_wield),
-        special_stats(special_stats),
+        stats(starting_stats),
+        special_stats(stats.get()),
         talents(talents),
         damage_sources(),
-        damage_instances(damage_instances),
-        log_damage_instances(log_damage_instances),
+        time_lapse(time_lapse),
         flurry_charges(0),
         rampage_stacks(0)
     {
-        if (log_damage_instances) damage_instances.clear();
     }
 
     Weapon_sim& main_hand_weapon;
     Weapon_sim& off_hand_weapon;
     const bool is_dual_wield;
-    Special_stats special_stats;
+    Stat_aggregator stats; // buffs are added and removed here
+    const Special_stats& special_stats;
     const Character::talents_t& talents;
     Damage_sources damage_sources;
-    std::vector<Damage_instance>& damage_instances;
-    const bool log_damage_instances;
+    Time_lapse* const time_lapse; // nullptr unless the simulator logs data
     int flurry_charges;
     int rampage_stacks;
 
     void add_damage(Damage_source source, double damage, int current_time)
     {
         damage_sources.add_damage(source, damage);
-        if (log_damage_instances) damage_instances.emplace_back(source, damage, current_time);
+        if (time_lapse) time_lapse->add(source, damage, current_time);
+    }
+
+    void add_damage(Damage_source source, double damage, int current_time, Hit_result hit_result)
+    {
+        damage_sources.add_damage(source, damage, hit_result);
+        if (time_lapse) time_lapse->add(source, damage, current_time);
     }
 };
 
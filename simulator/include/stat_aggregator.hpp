@@ -0,0 +1,226 @@
+#ifndef WOW_SIMULATOR_STAT_AGGREGATOR_HPP
+#define WOW_SIMULATOR_STAT_AGGREGATOR_HPP
+
+#include "Attributes.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+// the stats of a fight, while buffs come and go. Special_stats::operator+= rebuilds every field and folds the
+// multipliers into the totals, so each gain and fade leaves some rounding error behind.
+// this keeps the additive sums and the multiplier products apart and only updates the fields a buff has. a field which
+// nothing modifies anymore is set back to its starting value, so errors can't build up over a fight.
+// the fields that changed are collected until they are taken, to recompute hit tables etc. only if their inputs changed.
+class Stat_aggregator
+{
+public:
+    enum Field : uint32_t
+    {
+        critical_strike = 1u << 0,
+        hit = 1u << 1,
+        attack_power = 1u << 2,
+        bonus_attack_power = 1u << 3,
+        haste = 1u << 4,
+        damage_mod_physical = 1u << 5,
+        stat_multiplier = 1u << 6,
+        bonus_damage = 1u << 7,
+        crit_multiplier = 1u << 8,
+        spell_crit = 1u << 9,
+        damage_mod_spell = 1u << 10,
+        expertise = 1u << 11,
+        sword_expertise = 1u << 12,
+        mace_expertise = 1u << 13,
+        axe_expertise = 1u << 14,
+        gear_armor_pen = 1u << 15,
+        ap_multiplier = 1u << 16,
+        attack_speed = 1u << 17,
+    };
+
+    static constexpr int n_fields = 18;
+    static constexpr uint32_t all_fields = (1u << n_fields) - 1;
+    static constexpr uint32_t hit_table_fields = critical_strike | hit | expertise;
+
+    explicit Stat_aggregator(const Special_stats& start) { reset(start); }
+
+    void reset(const Special_stats& start)
+    {
+        start_ = start;
+        stats_ = start;
+        attack_power_sum_ = start.attack_power / (1 + start.ap_multiplier);
+        haste_sum_ = (1 + start.haste) / (1 + start.attack_speed) - 1;
+        modifiers_.fill(0);
+        changed_ = all_fields;
+    }
+
+    // the fields a buff modifies, worth caching for buffs which are gained often
+    static uint32_t fields_of(const Special_stats& s)
+    {
+        uint32_t fields = 0;
+        if (s.critical_strike != 0) fields |= critical_strike;
+        if (s.hit != 0) fields |= hit;
+        if (s.attack_power != 0) fields |= attack_power;
+        if (s.bonus_attack_power != 0) fields |= bonus_attack_power;
+        if (s.haste != 0) fields |= haste;
+        if (s.damage_mod_physical != 0) fields |= damage_mod_physical;
+        if (s.stat_multiplier != 0) fields |= stat_multiplier;
+        if (s.bonus_damage != 0) fields |= bonus_damage;
+        if (s.crit_multiplier != 0) fields |= crit_multiplier;
+        if (s.spell_crit != 0) fields |= spell_crit;
+        if (s.damage_mod_spell != 0) fields |= damage_mod_spell;
+        if (s.expertise != 0) fields |= expertise;
+        if (s.sword_expertise != 0) fields |= sword_expertise;
+        if (s.mace_expertise != 0) fields |= mace_expertise;
+        if (s.axe_expertise != 0) fields |= axe_expertise;
+        if (s.gear_armor_pen != 0) fields |= gear_armor_pen;
+        if (s.ap_multiplier != 0) fields |= ap_multiplier;
+        if (s.attack_speed != 0) fields |= attack_speed;
+        return fields;
+    }
+
+    void add(const Special_stats& boost) { add(boost, fields_of(boost)); }
+
+    void add(const Special_stats& boost, uint32_t fields)
+    {
+        assert(boost.haste == 0 || boost.attack_speed == 0);
+        update(boost, fields, 1);
+    }
+
+    // has to match an earlier add
+    void remove(const Special_stats& boost) { remove(boost, fields_of(boost)); }
+
+    void remove(const Special_stats& boost, uint32_t fields) { update(boost, fields, -1); }
+
+    [[nodiscard]] const Special_stats& get() const { return stats_; }
+
+    [[nodiscard]] uint32_t take_changed()
+    {
+        const auto changed = changed_;
+        changed_ = 0;
+        return changed;
+    }
+
+private:
+    void update(const Special_stats& boost, uint32_t fields, int sign)
+    {
+        changed_ |= fields;
+        for (; fields != 0; fields &= fields - 1)
+        {
+            const auto field = static_cast<Field>(fields & (~fields + 1));
+            auto& modifiers = modifiers_[index(field)];
+            modifiers += sign;
+            assert(modifiers >= 0);
+            const bool unmodified = modifiers == 0;
+
+            switch (field)
+            {
+            case critical_strike:
+                add_to(&Special_stats::critical_strike, boost, sign, unmodified);
+                break;
+            case hit:
+                add_to(&Special_stats::hit, boost, sign, unmodified);
+                break;
+            case attack_power:
+                attack_power_sum_ = unmodified ? start_.attack_power / (1 + start_.ap_multiplier) :
+                                                 attack_power_sum_ + sign * boost.attack_power;
+                derive_attack_power();
+                break;
+            case bonus_attack_power:
+                add_to(&Special_stats::bonus_attack_power, boost, sign, unmodified);
+                break;
+            case haste:
+                haste_sum_ = unmodified ? (1 + start_.haste) / (1 + start_.attack_speed) - 1 :
+                                          haste_sum_ + sign * boost.haste;
+                derive_haste();
+                break;
+            case damage_mod_physical:
+                multiply(&Special_stats::damage_mod_physical, boost, sign, unmodified);
+                break;
+            case stat_multiplier:
+                multiply(&Special_stats::stat_multiplier, boost, sign, unmodified);
+                break;
+            case bonus_damage:
+                add_to(&Special_stats::bonus_damage, boost, sign, unmodified);
+                break;
+            case crit_multiplier:
+                multiply(&Special_stats::crit_multiplier, boost, sign, unmodified);
+                break;
+            case spell_crit:
+                add_to(&Special_stats::spell_crit, boost, sign, unmodified);
+                break;
+            case damage_mod_spell:
+                multiply(&Special_stats::damage_mod_spell, boost, sign, unmodified);
+                break;
+            case expertise:
+                add_to(&Special_stats::expertise, boost, sign, unmodified);
+                break;
+            case sword_expertise:
+                add_to(&Special_stats::sword_expertise, boost, sign, unmodified);
+                break;
+            case mace_expertise:
+                add_to(&Special_stats::mace_expertise, boost, sign, unmodified);
+                break;
+            case axe_expertise:
+                add_to(&Special_stats::axe_expertise, boost, sign, unmodified);
+                break;
+            case gear_armor_pen:
+                stats_.gear_armor_pen = unmodified ? start_.gear_armor_pen : stats_.gear_armor_pen + sign * boost.gear_armor_pen;
+                break;
+            case ap_multiplier:
+                multiply(&Special_stats::ap_multiplier, boost, sign, unmodified);
+                derive_attack_power();
+                changed_ |= attack_power;
+                break;
+            case attack_speed:
+                multiply(&Special_stats::attack_speed, boost, sign, unmodified);
+                derive_haste();
+                changed_ |= haste;
+                break;
+            }
+        }
+    }
+
+    void add_to(double Special_stats::*field, const Special_stats& boost, int sign, bool unmodified)
+    {
+        stats_.*field = unmodified ? start_.*field : stats_.*field + sign * (boost.*field);
+    }
+
+    void multiply(double Special_stats::*field, const Special_stats& boost, int sign, bool unmodified)
+    {
+        if (unmodified)
+        {
+            stats_.*field = start_.*field;
+        }
+        else
+        {
+            stats_.*field = sign > 0 ? multiplicative_addition(stats_.*field, boost.*field) :
+                                       multiplicative_subtraction(stats_.*field, boost.*field);
+        }
+    }
+
+    void derive_attack_power()
+    {
+        const bool unmodified = modifiers_[index(attack_power)] == 0 && modifiers_[index(ap_multiplier)] == 0;
+        stats_.attack_power = unmodified ? start_.attack_power : attack_power_sum_ * (1 + stats_.ap_multiplier);
+    }
+
+    void derive_haste()
+    {
+        const bool unmodified = modifiers_[index(haste)] == 0 && modifiers_[index(attack_speed)] == 0;
+        stats_.haste = unmodified ? start_.haste : (1 + haste_sum_) * (1 + stats_.attack_speed) - 1;
+    }
+
+    static constexpr int index(Field field) { return __builtin_ctz(field); }
+
+    Special_stats start_;
+    Special_stats stats_;
+
+    // attack power before ap_multiplier, haste before attack_speed
+    double attack_power_sum_{};
+    double haste_sum_{};
+
+    std::array<int, n_fields> modifiers_{}; // number of active buffs per field
+    uint32_t changed_{all_fields};
+};
+
+#endif // WOW_SIMULATOR_STAT_AGGREGATOR_HPP
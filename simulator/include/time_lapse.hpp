@@ -0,0 +1,83 @@
+#ifndef WOW_SIMULATOR_TIME_LAPSE_HPP
+#define WOW_SIMULATOR_TIME_LAPSE_HPP
+
+#include "damage_sources.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+// damage over the course of a fight, per source and time bucket. damage is binned while it's dealt, into a single
+// [source][bucket] array which is shared by all iterations (and merged once per worker), instead of replaying a list
+// of every hit after each iteration
+class Time_lapse
+{
+public:
+    Time_lapse() = default;
+
+    // a time lapse with the given state (see data()), e.g. one read from a file
+    Time_lapse(int resolution, std::vector<double> damage)
+        : resolution_(std::max(resolution, 1))
+        , n_buckets_(damage.size() / Damage_sources::n_sources)
+        , damage_(std::move(damage))
+    {
+        assert(damage_.size() == Damage_sources::n_sources * n_buckets_);
+    }
+
+    // sim_time and resolution (the bucket size) in ms
+    void reset(int sim_time, int resolution)
+    {
+        resolution_ = std::max(resolution, 1);
+        n_buckets_ = static_cast<size_t>(sim_time / resolution_ + 1);
+        damage_.assign(Damage_sources::n_sources * n_buckets_, 0.0);
+    }
+
+    void add(Damage_source source, double damage, int time)
+    {
+        const auto bucket = static_cast<size_t>(time / resolution_);
+        assert(time >= 0 && bucket < n_buckets_);
+        damage_[static_cast<size_t>(source) * n_buckets_ + bucket] += damage;
+    }
+
+    Time_lapse& operator+=(const Time_lapse& rhs)
+    {
+        assert(damage_.size() == rhs.damage_.size());
+        for (size_t i = 0; i < damage_.size(); ++i) damage_[i] += rhs.damage_[i];
+        return *this;
+    }
+
+    void scale(double factor)
+    {
+        for (auto& damage : damage_) damage *= factor;
+    }
+
+    [[nodiscard]] bool empty() const { return damage_.empty(); }
+
+    [[nodiscard]] int resolution() const { return resolution_; }
+
+    [[nodiscard]] size_t n_buckets() const { return n_buckets_; }
+
+    // the damage of every source and bucket, [source][bucket]
+    [[nodiscard]] const std::vector<double>& data() const { return damage_; }
+
+    [[nodiscard]] std::vector<double> series(Damage_source source) const
+    {
+        const auto first = damage_.begin() + static_cast<ptrdiff_t>(static_cast<size_t>(source) * n_buckets_);
+        return {first, first + static_cast<ptrdiff_t>(n_buckets_)};
+    }
+
+    [[nodiscard]] double total(Damage_source source) const
+    {
+        double sum = 0;
+        for (size_t i = 0; i < n_buckets_; ++i) sum += damage_[static_cast<size_t>(source) * n_buckets_ + i];
+        return sum;
+    }
+
+private:
+    int resolution_{1};
+    size_t n_buckets_{};
+    std::vector<double> damage_{}; // [source][bucket]
+};
+
+#endif // WOW_SIMULATOR_TIME_LAPSE_HPP
@@ -3,6 +3,19 @@
 
 #include "Item.hpp"
 
+#include <vector>
+
+// a hit effect of a weapon, prepared for the proc loop of Combat_simulator::hit_effects() (see Weapon_sim::update_procs())
+struct Weapon_proc
+{
+    int index;           // into Weapon_sim::hit_effects
+    int linked;          // the same effect on the other weapon, which shares the cooldown; -1 if there is none
+    double probability;  // ppm is converted with the weapon speed already
+    uint8_t trigger;     // Hit_result mask (Hit_effect::proc_type)
+    bool removes_charge; // darkmoon_card_wrath loses a charge on hits which don't proc it
+    Hit_effect::Type type;
+};
+
 class Weapon_sim
 {
 public:
@@ -22,6 +35,10 @@ public:
         return socket == Socket::main_hand ? damage + bonus : damage * 0.5 + bonus;
     }
 
+    // adds the procs of hit effects that aren't in the table yet (all of them at the start, hit auras added in combat
+    // later on). other_weapon is the off hand of a main hand and vice versa, nullptr if not dual wielding
+    void update_procs(const Weapon_sim* other_weapon);
+
     double swing_speed;
     double normalized_swing_speed;
     int next_swing;
@@ -30,6 +47,7 @@ public:
     Weapon_type weapon_type;
     Weapon_socket weapon_socket;
     std::vector<Hit_effect> hit_effects;
+    std::vector<Weapon_proc> procs;
 };
 
 #endif // WOW_SIMULATOR_WEAPON_SIM_HPP
@@ -13,12 +13,29 @@ void Buff_manager::initialize(std::vector<Hit_effect>& hit_effects_mh_input, std
     use_effects_schedule = use_effects_schedule_input;
 
     rage_manager = rage_manager_input;
+
+    if (use_effect_timer == -1) use_effect_timer = add_timer(Timer_owner::Type::use_effect, 0);
+}
+
+int Buff_manager::add_timer(Timer_owner::Type type, size_t index)
+{
+    timer_owners.push_back({type, index});
+    return events.add_timer();
+}
+
+void Buff_manager::schedule(int timer, int time)
+{
+    events.schedule(timer, time);
+    if (time < earliest_event) earliest_event = time;
 }
 
 void Buff_manager::reset(Sim_state& state)
 {
     sim_state = &state;
 
+    events.clear();
+    earliest_event = Event_calendar<>::never;
+
     for (auto& he : *hit_effects_mh)
     {
         he.time_counter = 0;
@@ -34,36 +51,21 @@ void Buff_manager::reset(Sim_state& state)
         buff.stacks = 0;
         buff.next_fade = std::numeric_limits<int>::max();
     }
-    min_combat_buff = std::numeric_limits<int>::max();
 
     for (auto& buff : over_time_buffs)
     {
         buff.next_tick = Over_time_buff::inactive;
     }
-    min_over_time_buff = std::numeric_limits<int>::max();
 
     for (auto& hit_aura : hit_auras)
     {
-        // update hit effect pointers, since hit_effects are permutated now
-        auto mh = std::find_if(hit_effects_mh->begin(), hit_effects_mh->end(), [&hit_aura](auto& he) { return he.name == hit_aura.name; });
-        assert(mh != hit_effects_mh->end());
-        hit_aura.hit_effect_mh = &(*mh);
-
-        auto oh = std::find_if(hit_effects_oh->begin(), hit_effects_oh->end(), [&hit_aura](auto& he) { return he.name == hit_aura.name; });
-        assert(oh != hit_effects_oh->end());
-        hit_aura.hit_effect_oh = &(*oh);
-
         hit_aura.next_fade = Hit_aura::inactive;
-        hit_aura.hit_effect_mh->time_counter = std::numeric_limits<int>::max();
-        hit_aura.hit_effect_oh->time_counter = std::numeric_limits<int>::max();
+        (*hit_effects_mh)[hit_aura.hit_effect_mh].time_counter = std::numeric_limits<int>::max();
+        (*hit_effects_oh)[hit_aura.hit_effect_oh].time_counter = std::numeric_limits<int>::max();
     }
-    min_hit_aura = std::numeric_limits<int>::max();
 
     use_effect_index = 0;
-    min_use_effect = use_effects_schedule.empty() ? std::numeric_limits<int>::max() : use_effects_schedule[0].first - 1;
-
-    need_to_recompute_mitigation = true;
-    need_to_recompute_hit_tables = true;
+    if (!use_effects_schedule.empty()) schedule(use_effect_timer, use_effects_schedule[0].first - 1);
 }
 
 void Buff_manager::update_aura_uptimes(int current_time) {
@@ -91,13 +93,56 @@ void Buff_manager::update_aura_uptimes(int current_time) {
     return m;
 }
 
-void Buff_manager::increment(Time_keeper& time_keeper, Logger& logger)
+void Buff_manager::do_increment(Time_keeper& time_keeper, Logger& logger)
 {
     auto current_time = time_keeper.time;
-    increment_combat_buffs(current_time, logger);
-    increment_over_time_buffs(current_time, logger);
-    increment_hit_auras(current_time, logger);
-    increment_use_effects(current_time, time_keeper, logger);
+
+    // collect first, every timer fires at most once per increment (e.g. pre-combat ticks that are still overdue).
+    //  simultaneous events are handled buffs first, then ticks, hit auras and finally use effects
+    due_timers.clear();
+    earliest_event = Event_calendar<>::never; // lowered again by whatever is scheduled below
+    for (int timer = 0; timer < events.size(); ++timer)
+    {
+        const auto time = events.time_of(timer);
+        if (time <= current_time)
+        {
+            due_timers.push_back(timer);
+            events.cancel(timer);
+        }
+        else if (time < earliest_event)
+        {
+            earliest_event = time;
+        }
+    }
+    if (due_timers.size() > 1)
+    {
+        std::sort(due_timers.begin(), due_timers.end(), [this](int a, int b) {
+            const auto& owner_a = timer_owners[a];
+            const auto& owner_b = timer_owners[b];
+            return owner_a.type < owner_b.type || (owner_a.type == owner_b.type && owner_a.index < owner_b.index);
+        });
+    }
+
+    for (const auto timer : due_timers)
+    {
+        const auto& owner = timer_owners[timer];
+        switch (owner.type)
+        {
+        case Timer_owner::Type::combat_buff:
+            // might have been faded by another buff already
+            if (combat_buffs[owner.index].stacks > 0) fade_combat_buff(combat_buffs[owner.index], current_time, logger);
+            break;
+        case Timer_owner::Type::over_time_buff:
+            tick_over_time_buff(over_time_buffs[owner.index], current_time, logger);
+            break;
+        case Timer_owner::Type::hit_aura:
+            fade_hit_aura(hit_auras[owner.index], current_time, logger);
+            break;
+        case Timer_owner::Type::use_effect:
+            increment_use_effects(current_time, time_keeper, logger);
+            break;
+        }
+    }
 }
 
 void Buff_manager::remove_charge(const Hit_effect& hit_effect, int current_time, Logger& logger)
@@ -128,19 +173,20 @@ void Buff_manager::add_combat_buff(Hit_effect& hit_effect, int current_time)
     // "registration", essentially - once per hit_effect, connects each hit_effect w/ a combat buff
     if (hit_effect.combat_buff_idx == -1)
     {
-        for (size_t i = 0; i < combat_buffs.size(); ++i)
+        const auto id = combat_buff_ids.find(hit_effect.name);
+        if (id != combat_buff_ids.end())
         {
-            if (combat_buffs[i].name == hit_effect.name)
-            {
-                hit_effect.combat_buff_idx = static_cast<int>(i);
-                return do_add_combat_buff(hit_effect, current_time);
-            }
+            hit_effect.combat_buff_idx = id->second;
+            return do_add_combat_buff(hit_effect, current_time);
         }
 
-        auto& buff = combat_buffs.emplace_back(hit_effect, sim_state->special_stats, current_time);
-        gain_stats(buff.special_stats_boost);
-        if (buff.next_fade < min_combat_buff) min_combat_buff = buff.next_fade;
+        const auto timer = add_timer(Timer_owner::Type::combat_buff, combat_buffs.size());
+        auto& buff = combat_buffs.emplace_back(hit_effect, sim_state->special_stats, current_time, timer);
+        sim_state->stats.add(buff.special_stats_boost, buff.stat_fields);
+        schedule(buff.timer, buff.next_fade);
         hit_effect.combat_buff_idx = static_cast<int>(combat_buffs.size()) - 1;
+        combat_buff_ids.emplace(hit_effect.name, hit_effect.combat_buff_idx);
+        if (hit_effect.name == "blackened_naaru_sliver_stacks") sliver_stacks_idx = hit_effect.combat_buff_idx;
         return;
     }
 
@@ -149,41 +195,50 @@ void Buff_manager::add_combat_buff(Hit_effect& hit_effect, int current_time)
 
 void Buff_manager::add_hit_aura(const std::string& name, Hit_effect& hit_effect, int duration, int current_time)
 {
-    for (auto& hit_aura : hit_auras)
+    if (hit_effect.hit_aura_idx == -1)
     {
-        if (hit_aura.name == name)
-        {
-            hit_aura.hit_effect_mh->time_counter = 0; // re-enable hit_effects, and queue fade
-            hit_aura.hit_effect_oh->time_counter = 0;
-            hit_aura.next_fade = current_time + duration;
-            if (hit_aura.next_fade < min_hit_aura) min_hit_aura = hit_aura.next_fade;
-            return;
-        }
+        const auto id = hit_aura_ids.find(name);
+        if (id != hit_aura_ids.end()) hit_effect.hit_aura_idx = id->second;
     }
 
-    auto& hit_aura = hit_auras.emplace_back(Hit_aura(name, current_time, duration));
+    if (hit_effect.hit_aura_idx != -1)
+    {
+        auto& hit_aura = hit_auras[hit_effect.hit_aura_idx];
+        (*hit_effects_mh)[hit_aura.hit_effect_mh].time_counter = 0; // re-enable hit_effects, and queue fade
+        (*hit_effects_oh)[hit_aura.hit_effect_oh].time_counter = 0;
+        hit_aura.next_fade = current_time + duration;
+        schedule(hit_aura.timer, hit_aura.next_fade);
+        return;
+    }
+
+    const auto timer = add_timer(Timer_owner::Type::hit_aura, hit_auras.size());
+    auto& hit_aura = hit_auras.emplace_back(Hit_aura(name, current_time, duration, timer));
+    hit_effect.hit_aura_idx = static_cast<int>(hit_auras.size()) - 1;
+    hit_aura_ids.emplace(name, hit_effect.hit_aura_idx);
     hit_effect.sanitize();
-    hit_aura.hit_effect_mh = &hit_effects_mh->emplace_back(hit_effect);
-    hit_aura.hit_effect_oh = &hit_effects_oh->emplace_back(hit_effect);
-    if (hit_aura.next_fade < min_hit_aura) min_hit_aura = hit_aura.next_fade;
+    hit_aura.hit_effect_mh = static_cast<int>(hit_effects_mh->size());
+    hit_effects_mh->push_back(hit_effect);
+    hit_aura.hit_effect_oh = static_cast<int>(hit_effects_oh->size());
+    hit_effects_oh->push_back(hit_effect);
+    schedule(hit_aura.timer, hit_aura.next_fade);
 }
 
 void Buff_manager::add_over_time_buff(Over_time_effect& over_time_effect, int current_time)
 {
     if (over_time_effect.over_time_buff_idx == -1)
     {
-        for (size_t i = 0; i < over_time_buffs.size(); ++i)
+        const auto id = over_time_buff_ids.find(over_time_effect.name);
+        if (id != over_time_buff_ids.end())
         {
-            if (over_time_buffs[i].name == over_time_effect.name)
-            {
-                over_time_effect.over_time_buff_idx = static_cast<int>(i);
-                return do_add_over_time_buff(over_time_effect, current_time);
-            }
+            over_time_effect.over_time_buff_idx = id->second;
+            return do_add_over_time_buff(over_time_effect, current_time);
         }
 
-        auto& buff = over_time_buffs.emplace_back(Over_time_buff(over_time_effect, current_time));
-        if (buff.next_tick < min_over_time_buff) min_over_time_buff = buff.next_tick;
+        const auto timer = add_timer(Timer_owner::Type::over_time_buff, over_time_buffs.size());
+        auto& buff = over_time_buffs.emplace_back(Over_time_buff(over_time_effect, current_time, timer));
+        schedule(buff.timer, buff.next_tick);
         over_time_effect.over_time_buff_idx = static_cast<int>(over_time_buffs.size()) - 1;
+        over_time_buff_ids.emplace(over_time_effect.name, over_time_effect.over_time_buff_idx);
         return;
     }
 
@@ -191,153 +246,92 @@ void Buff_manager::add_over_time_buff(Over_time_effect& over_time_effect, int cu
 }
 
 
-void Buff_manager::increment_combat_buffs(int current_time, Logger& logger)
+void Buff_manager::fade_combat_buff(Combat_buff& buff, int current_time, Logger& logger)
 {
-    if (current_time < min_combat_buff)
-    {
-        return;
-    }
+    assert(buff.stacks > 0);
+    assert(current_time == buff.next_fade);
 
-    min_combat_buff = std::numeric_limits<int>::max();
-    for (auto& buff : combat_buffs)
-    {
-        if (buff.stacks == 0) // inactive
-        {
-            continue;
-        }
+    do_fade_buff(buff, logger, current_time);
+}
 
-        if (buff.next_fade > current_time) // not ready
-        {
-            if (buff.next_fade < min_combat_buff) min_combat_buff = buff.next_fade;
-            continue;
-        }
+void Buff_manager::tick_over_time_buff(Over_time_buff& buff, int current_time, Logger& logger)
+{
+    assert(buff.next_tick != Over_time_buff::inactive);
 
-        assert(current_time == buff.next_fade);
+    // if over_time_buffs start pre-combat (bloodrage), next_tick might be < 0, and can't be scheduled correctly
+    assert(current_time == (buff.next_tick > 0 ? buff.next_tick : 0));
 
-        do_fade_buff(buff, logger, current_time);
+    // this used to support everything at once, but no over_time_buff actually granted rage, dealt damage, and added stats.
+    //  nothing does the latter, afaik
+    if (buff.rage_gain > 0)
+    {
+        rage_manager->gain_rage(buff.rage_gain);
+        logger.print("Over time effect: ", buff.name, " tick. Current rage: ", int(rage_manager->get_rage()));
     }
-}
-
-void Buff_manager::increment_over_time_buffs(int current_time, Logger& logger)
-{
-    if (current_time < min_over_time_buff)
+    else if (buff.damage > 0)
     {
-        return;
+        sim_state->add_damage(Damage_source::deep_wounds, buff.damage, current_time);
+        logger.print("Over time effect: ", buff.name, " tick. Damage: ", int(buff.damage));
     }
-
-    min_over_time_buff = std::numeric_limits<int>::max();
-    for (auto& buff : over_time_buffs)
+    else
     {
-        if (buff.next_tick == Over_time_buff::inactive) // inactive
-        {
-            continue;
-        }
-
-        if (buff.next_tick > current_time) // not ready
-        {
-            if (buff.next_tick < min_over_time_buff) min_over_time_buff = buff.next_tick;
-            continue;
-        }
-
-        // if over_time_buffs start pre-combat (bloodrage), next_tick might be < 0, and can't be scheduled correctly
-        assert(current_time == (buff.next_tick > 0 ? buff.next_tick : 0));
-
-        // this used to support everything at once, but no over_time_buff actually granted rage, dealt damage, and added stats.
-        //  nothing does the latter, afaik
-        if (buff.rage_gain > 0)
-        {
-            rage_manager->gain_rage(buff.rage_gain);
-            logger.print("Over time effect: ", buff.name, " tick. Current rage: ", int(rage_manager->get_rage()));
-        }
-        else if (buff.damage > 0)
-        {
-            sim_state->add_damage(Damage_source::deep_wounds, buff.damage, current_time);
-            logger.print("Over time effect: ", buff.name, " tick. Damage: ", int(buff.damage));
-        }
-        else
-        {
-            sim_state->special_stats += buff.special_stats;
-        }
-
-        if (buff.next_fade == current_time)
-        {
-            buff.next_tick = Over_time_buff::inactive;
-            buff.uptime += buff.next_fade - (buff.last_gain > 0 ? buff.last_gain : 0);
-            logger.print("Over time effect: ", buff.name, " fades.");
-        }
-        else
-        {
-            buff.next_tick += buff.interval;
-            if (buff.next_tick < min_over_time_buff) min_over_time_buff = buff.next_tick;
-        }
+        sim_state->stats.add(buff.special_stats);
     }
-}
 
-void Buff_manager::increment_hit_auras(int current_time, Logger& logger)
-{
-    if (current_time < min_hit_aura)
+    if (buff.next_fade == current_time)
     {
-        return;
+        buff.next_tick = Over_time_buff::inactive;
+        buff.uptime += buff.next_fade - (buff.last_gain > 0 ? buff.last_gain : 0);
+        logger.print("Over time effect: ", buff.name, " fades.");
     }
-
-    min_hit_aura = std::numeric_limits<int>::max();
-    for (auto& hit_aura : hit_auras)
+    else
     {
-        if (hit_aura.next_fade == Hit_aura::inactive)
-        {
-            continue;
-        }
-
-        if (hit_aura.next_fade > current_time)
-        {
-            if (hit_aura.next_fade < min_hit_aura) min_hit_aura = hit_aura.next_fade;
-            continue;
-        }
+        buff.next_tick += buff.interval;
+        schedule(buff.timer, buff.next_tick);
+    }
+}
 
-        assert(current_time == hit_aura.next_fade);
+void Buff_manager::fade_hit_aura(Hit_aura& hit_aura, int current_time, Logger& logger)
+{
+    assert(hit_aura.next_fade != Hit_aura::inactive);
+    assert(current_time == hit_aura.next_fade);
 
-        assert(hit_aura.hit_effect_mh != nullptr);
-        assert(hit_aura.hit_effect_oh != nullptr);
+    auto& hit_effect_mh = (*hit_effects_mh)[hit_aura.hit_effect_mh];
+    auto& hit_effect_oh = (*hit_effects_oh)[hit_aura.hit_effect_oh];
 
-        // or have a specialized add_combat_buff() here, probably
-        assert(hit_aura.hit_effect_mh->combat_buff_idx >= 0);
-        assert(hit_aura.hit_effect_oh->combat_buff_idx == -1 || hit_aura.hit_effect_oh->combat_buff_idx == hit_aura.hit_effect_mh->combat_buff_idx);
+    // or have a specialized add_combat_buff() here, probably
+    assert(hit_effect_mh.combat_buff_idx >= 0);
+    assert(hit_effect_oh.combat_buff_idx == -1 || hit_effect_oh.combat_buff_idx == hit_effect_mh.combat_buff_idx);
 
-        hit_aura.hit_effect_mh->time_counter = std::numeric_limits<int>::max(); // effectively disable hit_effects
-        hit_aura.hit_effect_oh->time_counter = std::numeric_limits<int>::max();
+    hit_effect_mh.time_counter = std::numeric_limits<int>::max(); // effectively disable hit_effects
+    hit_effect_oh.time_counter = std::numeric_limits<int>::max();
 
-        auto& buff = combat_buffs[hit_aura.hit_effect_mh->combat_buff_idx];
-        buff.next_fade = hit_aura.next_fade; // for correct uptime bookkeeping
-        do_fade_buff(buff, logger, current_time);
+    auto& buff = combat_buffs[hit_effect_mh.combat_buff_idx];
+    buff.next_fade = hit_aura.next_fade; // for correct uptime bookkeeping
+    do_fade_buff(buff, logger, current_time);
 
-        hit_aura.next_fade = Hit_aura::inactive;
-    }
+    hit_aura.next_fade = Hit_aura::inactive;
 }
 
 void Buff_manager::increment_use_effects(int current_time, Time_keeper& time_keeper, Logger& logger)
 {
-    if (current_time < min_use_effect)
-    {
-        return;
-    }
-
     auto& use_effect = use_effects_schedule[use_effect_index].second.get();
 
     if (use_effect.triggers_gcd && !time_keeper.global_ready())
     {
-        min_use_effect = current_time + time_keeper.global_cd();
+        schedule(use_effect_timer, current_time + time_keeper.global_cd());
         return;
     }
 
     if (use_effect.rage_boost > 0 && rage_manager->get_rage() + use_effect.rage_boost > 100)
     {
-        min_use_effect = current_time + 500;
+        schedule(use_effect_timer, current_time + 500);
         return;
     }
 
     if (use_effect.rage_boost < 0 && rage_manager->get_rage() + use_effect.rage_boost < 0)
     {
-        min_use_effect = current_time + 500;
+        schedule(use_effect_timer, current_time + 500);
         return;
     }
 
@@ -357,13 +351,13 @@ void Buff_manager::increment_use_effects(int current_time, Time_keeper& time_kee
     if (use_effect.rage_boost > 0)
     {
         rage_manager->gain_rage(use_effect.rage_boost);
-        logger.print("Current rage: ", int(rage_manager->get_rage()));
+        logger.rage(rage_manager->get_rage());
     }
 
     if (use_effect.rage_boost < 0)
     {
         rage_manager->spend_rage(-use_effect.rage_boost);
-        logger.print("Current rage: ", int(rage_manager->get_rage()));
+        logger.rage(rage_manager->get_rage());
     }
 
     if (use_effect.triggers_gcd)
@@ -375,38 +369,33 @@ void Buff_manager::increment_use_effects(int current_time, Time_keeper& time_kee
 
     if (use_effect_index < use_effects_schedule.size())
     {
-        min_use_effect = use_effects_schedule[use_effect_index].first;
+        auto next_use_effect = use_effects_schedule[use_effect_index].first;
 
         const auto& ue = use_effects_schedule[use_effect_index].second.get();
-        if (ue.triggers_gcd || ue.rage_boost != 0) min_use_effect -= 1000;
-    }
-    else
-    {
-        min_use_effect = std::numeric_limits<int>::max();
+        if (ue.triggers_gcd || ue.rage_boost != 0) next_use_effect -= 1000;
+        schedule(use_effect_timer, next_use_effect);
     }
 }
 
 
 void Buff_manager::do_fade_buff(Combat_buff& buff, Logger& logger, int current_time)
 {
-    const auto& ssb = buff.special_stats_boost;
     for (int i = 0; i < buff.stacks; i++)
     {
-        sim_state->special_stats -= ssb;
+        sim_state->stats.remove(buff.special_stats_boost, buff.stat_fields);
     }
     buff.stacks = 0;
     buff.charges = 0;
-    need_to_recompute_hit_tables |= (ssb.critical_strike > 0 || ssb.hit > 0 || ssb.expertise > 0);
-    need_to_recompute_mitigation |= (ssb.gear_armor_pen > 0);
+    events.cancel(buff.timer);
 
     // special case, should be removed
-    if (buff.name == "battle_stance")
+    if (buff.on_fade == Combat_buff::On_fade::swap_stance)
     {
         rage_manager->swap_stance();
     }
-    if (buff.name == "blackened_naaru_sliver_active")
+    if (buff.on_fade == Combat_buff::On_fade::fade_sliver_stacks)
     {
-        force_fade_aura_by_name("blackened_naaru_sliver_stacks", logger, current_time);
+        if (sliver_stacks_idx != -1) force_fade_combat_buff(sliver_stacks_idx, logger, current_time);
     }
 
     buff.uptime += buff.next_fade - (buff.last_gain > 0 ? buff.last_gain : 0);
@@ -414,25 +403,10 @@ void Buff_manager::do_fade_buff(Combat_buff& buff, Logger& logger, int current_t
     logger.print(buff.name, " fades.");
 }
 
-void Buff_manager::force_fade_aura_by_name(const std::string& name, Logger& logger, int current_time)
-{
-    //find the aura with matching name
-    for (auto& buff : combat_buffs)
-    {
-        if (buff.name == name)
-        {
-            //force a fade on the next tick
-            do_fade_buff(buff, logger, current_time);
-            return;
-        }
-    }
-}
-
-void Buff_manager::gain_stats(const Special_stats& ssb)
+void Buff_manager::force_fade_combat_buff(int combat_buff_idx, Logger& logger, int current_time)
 {
-    sim_state->special_stats += ssb;
-    need_to_recompute_hit_tables |= (ssb.hit > 0 || ssb.critical_strike > 0 || ssb.expertise > 0);
-    need_to_recompute_mitigation |= (ssb.gear_armor_pen > 0);
+    //force a fade on the next tick
+    do_fade_buff(combat_buffs[combat_buff_idx], logger, current_time);
 }
 
 void Buff_manager::do_add_combat_buff(Hit_effect& hit_effect, int current_time)
@@ -442,12 +416,12 @@ void Buff_manager::do_add_combat_buff(Hit_effect& hit_effect, int current_time)
     {
         if (buff.next_fade < current_time) assert(buff.stacks == 0 && buff.charges == 0);
         if (buff.stacks == 0) buff.last_gain = current_time;
-        gain_stats(buff.special_stats_boost);
+        sim_state->stats.add(buff.special_stats_boost, buff.stat_fields);
         buff.stacks += 1;
     }
     buff.next_fade = current_time + hit_effect.duration; // or keep unchanged for "temporary hit effects"
     buff.charges = hit_effect.max_charges;
-    if (buff.next_fade < min_combat_buff) min_combat_buff = buff.next_fade;
+    schedule(buff.timer, buff.next_fade);
 }
 
 void Buff_manager::do_add_over_time_buff(const Over_time_effect& over_time_effect, int current_time)
@@ -462,5 +436,5 @@ void Buff_manager::do_add_over_time_buff(const Over_time_effect& over_time_effec
 
     buff.next_tick = current_time + over_time_effect.interval;
     buff.next_fade = current_time + over_time_effect.duration;
-    if (buff.next_tick < min_over_time_buff) min_over_time_buff = buff.next_tick;
+    schedule(buff.timer, buff.next_tick);
 }
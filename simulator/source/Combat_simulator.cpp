@@ -4,8 +4,12 @@
 #include "Use_effects.hpp"
 #include "item_heuristics.hpp"
 #include "sim_state.hpp"
+#include "task_pool.hpp"
 
 #include <algorithm>
+#include <deque>
+#include <thread>
+#include <type_traits>
 
 namespace
 {
@@ -20,10 +24,20 @@ constexpr double armor_reduction_factor(int target_armor)
 {
     return 10557.5 / (10557.5 + target_armor);
 }
+
+// the buckets from the first to the last non-empty one
+std::pair<size_t, size_t> occupied_buckets(const std::vector<int>& counts)
+{
+    size_t first = 0;
+    while (first < counts.size() && counts[first] == 0) ++first;
+    size_t last = counts.size();
+    while (last > first && counts[last - 1] == 0) --last;
+    return {first, last};
+}
 } // namespace
 
 
-Combat_simulator::Combat_simulator(const Combat_simulator_config& config) : config(config)
+Combat_simulator::Combat_simulator(const Combat_simulator_config& config) : config(config), rng_(config.seed)
 {
     armor_reduction_from_spells_ = 0;
     armor_reduction_from_spells_ += 800 * config.curse_of_recklessness_active;
@@ -54,6 +68,8 @@ void Combat_simulator::add_talent_effects(const Character& character)
     use_sweeping_strikes_ = character.talents.sweeping_strikes && config.use_sweeping_strikes && config.multi_target_mode_;
 }
 
+static_assert(std::is_trivially_copyable_v<Combat_simulator::Hit_table>, "hit tables are recomputed during the fight");
+
 void Combat_simulator::compute_hit_tables(const Character& character, const Special_stats& special_stats, const Weapon_sim& weapon)
 {
     if (special_stats.hit == compute_hit_table_stats_.hit && special_stats.expertise == compute_hit_table_stats_.expertise)
@@ -158,111 +174,11 @@ void Combat_simulator::compute_hit_tables(const Character& character, const Spec
 
 void Combat_simulator::cout_damage_parse(const Weapon_sim& weapon, const Hit_table& hit_table, const Combat_simulator::Hit_outcome& hit_outcome)
 {
-    if (!logger_.is_enabled()) return;
-
-    if (weapon.socket == Socket::main_hand)
-    {
-        if (hit_table.glance() > 0)
-        {
-            switch (hit_outcome.hit_result)
-            {
-            case Hit_result::glancing:
-                logger_.print("Mainhand glancing hit for: ", int(hit_outcome.damage), " damage.");
-                break;
-            case Hit_result::hit:
-                logger_.print("Mainhand white hit for: ", int(hit_outcome.damage), " damage.");
-                break;
-            case Hit_result::crit:
-                logger_.print("Mainhand crit for: ", int(hit_outcome.damage), " damage.");
-                break;
-            case Hit_result::dodge:
-                logger_.print("Mainhand hit dodged");
-                break;
-            case Hit_result::miss:
-                logger_.print("Mainhand hit missed");
-                break;
-            case Hit_result::TBD:
-                // Should never happen
-                logger_.print("BUUUUUUUUUUGGGGGGGGG");
-                break;
-            }
-        }
-        else
-        {
-            switch (hit_outcome.hit_result)
-            {
-            case Hit_result::glancing:
-                logger_.print("BUG: Ability glanced for: ", int(hit_outcome.damage), " damage.");
-                break;
-            case Hit_result::hit:
-                logger_.print("Ability hit for: ", int(hit_outcome.damage), " damage.");
-                break;
-            case Hit_result::crit:
-                logger_.print("Ability crit for: ", int(hit_outcome.damage), " damage.");
-                break;
-            case Hit_result::dodge:
-                logger_.print("Ability dodged");
-                break;
-            case Hit_result::miss:
-                logger_.print("Ability missed");
-                break;
-            case Hit_result::TBD:
-                logger_.print("BUUUUUUUUUUGGGGGGGGG");
-                break;
-            }
-        }
-    }
-    else
-    {
-        if (hit_table.glance() > 0)
-        {
-            switch (hit_outcome.hit_result)
-            {
-            case Hit_result::glancing:
-                logger_.print("Offhand glancing hit for: ", int(hit_outcome.damage), " damage.");
-                break;
-            case Hit_result::hit:
-                logger_.print("Offhand white hit for: ", int(hit_outcome.damage), " damage.");
-                break;
-            case Hit_result::crit:
-                logger_.print("Offhand crit for: ", int(hit_outcome.damage), " damage.");
-                break;
-            case Hit_result::dodge:
-                logger_.print("Offhand hit dodged");
-                break;
-            case Hit_result::miss:
-                logger_.print("Offhand hit missed");
-                break;
-            case Hit_result::TBD:
-                logger_.print("BUUUUUUUUUUGGGGGGGGG");
-                break;
-            }
-        }
-        else
-        {
-            switch (hit_outcome.hit_result)
-            {
-            case Hit_result::glancing:
-                logger_.print("BUG: Offhand ability glanced for: ", int(hit_outcome.damage), " damage.");
-                break;
-            case Hit_result::hit:
-                logger_.print("Offhand ability hit for: ", int(hit_outcome.damage), " damage.");
-                break;
-            case Hit_result::crit:
-                logger_.print("Offhand ability crit for: ", int(hit_outcome.damage), " damage.");
-                break;
-            case Hit_result::dodge:
-                logger_.print("Offhand ability dodged");
-                break;
-            case Hit_result::miss:
-                logger_.print("Offhand ability missed");
-                break;
-            case Hit_result::TBD:
-                logger_.print("BUUUUUUUUUUGGGGGGGGG");
-                break;
-            }
-        }
-    }
+    using Source = Trace_event::Hit_source;
+    const bool white = hit_table.glance() > 0;
+    const auto source = weapon.socket == Socket::main_hand ? (white ? Source::main_hand : Source::main_hand_ability)
+                                                           : (white ? Source::off_hand : Source::off_hand_ability);
+    logger_.hit(source, hit_outcome.hit_result, hit_outcome.damage);
 }
 
 Combat_simulator::Hit_outcome Combat_simulator::generate_hit(Sim_state& state, const Weapon_sim& weapon, const Hit_table& hit_table,
@@ -279,9 +195,9 @@ Combat_simulator::Hit_outcome Combat_simulator::generate_hit(Sim_state& state, c
         damage *= armor_reduction_factor_add * (1 + state.special_stats.damage_mod_physical);
     }
 
-    auto hit_outcome = hit_table.generate_hit(damage);
+    auto hit_outcome = hit_table.generate_hit(damage, get_uniform_random(100));
 
-    cout_damage_parse(weapon, hit_table, hit_outcome);
+    if (logger_.is_enabled()) cout_damage_parse(weapon, hit_table, hit_outcome);
 
     if (sweeping_strikes_charges_ > 0)
     {
@@ -309,7 +225,10 @@ Combat_simulator::Hit_outcome Combat_simulator::generate_hit(Sim_state& state, c
                 state.add_damage(Damage_source::sweeping_strikes, sweeping_strike_damage, time_keeper_.time);
             }
             logger_.print("Sweeping strikes hits a nearby target.");
-            cout_damage_parse(state.main_hand_weapon, hit_table_yellow_mh_, {sweeping_strike_damage, Hit_result::hit});
+            if (logger_.is_enabled())
+            {
+                cout_damage_parse(state.main_hand_weapon, hit_table_yellow_mh_, {sweeping_strike_damage, Hit_result::hit});
+            }
             sweeping_strikes_charges_--;
             logger_.print("Sweeping strikes charges left: ", sweeping_strikes_charges_);
         }
@@ -352,28 +271,28 @@ Combat_simulator::Hit_outcome Combat_simulator::generate_hit(Sim_state& state, c
     return hit_outcome;
 }
 
-void Combat_simulator::maybe_gain_flurry(Hit_result hit_result, int& flurry_charges, Special_stats& special_stats) const
+void Combat_simulator::maybe_gain_flurry(Hit_result hit_result, int& flurry_charges, Stat_aggregator& stats) const
 {
     if (!have_flurry_ || flurry_charges == 3 || hit_result != Hit_result::crit) return;
 
-    if (flurry_charges == 0) special_stats += flurry_;
+    if (flurry_charges == 0) stats.add(flurry_, Stat_aggregator::attack_speed);
     flurry_charges = 3;
 }
 
-void Combat_simulator::maybe_remove_flurry(int& flurry_charges, Special_stats& special_stats) const
+void Combat_simulator::maybe_remove_flurry(int& flurry_charges, Stat_aggregator& stats) const
 {
     if (!have_flurry_ || flurry_charges == 0) return;
 
-    if (flurry_charges == 1) special_stats -= flurry_;
+    if (flurry_charges == 1) stats.remove(flurry_, Stat_aggregator::attack_speed);
     flurry_charges -= 1;
 }
 
-void Combat_simulator::maybe_add_rampage_stack(Hit_result hit_result, int& rampage_stacks, Special_stats& special_stats)
+void Combat_simulator::maybe_add_rampage_stack(Hit_result hit_result, int& rampage_stacks, Stat_aggregator& stats)
 {
     if (!use_rampage_ || rampage_stacks == 5 || rampage_stacks == 0 || hit_result == Hit_result::miss || hit_result == Hit_result::dodge) return;
 
     rampage_stacks += 1;
-    special_stats += {0, 0, 50};
+    stats.add(rampage_stack_, Stat_aggregator::attack_power);
     logger_.print(rampage_stacks, " rampage stacks");
 }
 
@@ -396,6 +315,7 @@ bool Combat_simulator::start_cast_slam(Sim_state& state, bool mh_swing, const We
         {
             logger_.print("Starting to cast slam.", " Latency: ", config.combat.slam_latency, " ms.");
             slam_manager.cast_slam(time_keeper_.time + config.combat.slam_latency);
+            time_keeper_.schedule(Time_keeper::slam_finish_timer, slam_manager.next_finish());
             time_keeper_.global_cast(1500 + config.combat.slam_latency);
             spend_rage(15); // reserve slam cost, to prevent usage while slam is casting (e.g. use effects)
             return true;
@@ -408,7 +328,7 @@ void Combat_simulator::slam(Sim_state& state)
 {
     if (config.dpr_settings.compute_dpr_sl_)
     {
-        spend_rage(hit_table_yellow_mh_.isMissOrDodge() ? 3 : 15);
+        spend_rage(is_miss_or_dodge(hit_table_yellow_mh_) ? 3 : 15);
         time_keeper_.global_cast(1500);
         return;
     }
@@ -426,18 +346,18 @@ void Combat_simulator::slam(Sim_state& state)
     else
     {
         spend_rage(15);
-        maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.special_stats);
+        maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.stats);
         hit_effects(state, hit_outcome.hit_result, state.main_hand_weapon);
     }
-    state.add_damage(Damage_source::slam, hit_outcome.damage, time_keeper_.time);
-    logger_.print("Current rage: ", int(rage));
+    state.add_damage(Damage_source::slam, hit_outcome.damage, time_keeper_.time, hit_outcome.hit_result);
+    logger_.rage(rage);
 }
 
 void Combat_simulator::mortal_strike(Sim_state& state)
 {
     if (config.dpr_settings.compute_dpr_ms_)
     {
-        spend_rage(hit_table_yellow_mh_.isMissOrDodge() ? 0.2 * mortal_strike_rage_cost_ : mortal_strike_rage_cost_);
+        spend_rage(is_miss_or_dodge(hit_table_yellow_mh_) ? 0.2 * mortal_strike_rage_cost_ : mortal_strike_rage_cost_);
         time_keeper_.mortal_strike_cast(6000 - state.talents.improved_mortal_strike * 200);
         time_keeper_.global_cast(1500);
         return;
@@ -456,20 +376,20 @@ void Combat_simulator::mortal_strike(Sim_state& state)
     else
     {
         spend_rage(mortal_strike_rage_cost_);
-        maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.special_stats);
+        maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.stats);
         hit_effects(state, hit_outcome.hit_result, state.main_hand_weapon, Hit_type::spell, {}, Special_type::ms_bt);
     }
     time_keeper_.mortal_strike_cast(6000 - state.talents.improved_mortal_strike * 200);
     time_keeper_.global_cast(1500);
-    state.add_damage(Damage_source::mortal_strike, hit_outcome.damage, time_keeper_.time);
-    logger_.print("Current rage: ", int(rage));
+    state.add_damage(Damage_source::mortal_strike, hit_outcome.damage, time_keeper_.time, hit_outcome.hit_result);
+    logger_.rage(rage);
 }
 
 void Combat_simulator::bloodthirst(Sim_state& state)
 {
     if (config.dpr_settings.compute_dpr_bt_)
     {
-        spend_rage(hit_table_yellow_mh_.isMissOrDodge() ? 0.2 * bloodthirst_rage_cost_ : bloodthirst_rage_cost_);
+        spend_rage(is_miss_or_dodge(hit_table_yellow_mh_) ? 0.2 * bloodthirst_rage_cost_ : bloodthirst_rage_cost_);
         time_keeper_.blood_thirst_cast(6000);
         time_keeper_.global_cast(1500);
         return;
@@ -489,13 +409,13 @@ void Combat_simulator::bloodthirst(Sim_state& state)
     else
     {
         spend_rage(bloodthirst_rage_cost_);
-        maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.special_stats);
+        maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.stats);
         hit_effects(state, hit_outcome.hit_result, state.main_hand_weapon, Hit_type::spell, {}, Special_type::ms_bt);
     }
     time_keeper_.blood_thirst_cast(6000);
     time_keeper_.global_cast(1500);
-    state.add_damage(Damage_source::bloodthirst, hit_outcome.damage, time_keeper_.time);
-    logger_.print("Current rage: ", int(rage));
+    state.add_damage(Damage_source::bloodthirst, hit_outcome.damage, time_keeper_.time, hit_outcome.hit_result);
+    logger_.rage(rage);
 }
 
 void Combat_simulator::overpower(Sim_state& state)
@@ -518,7 +438,7 @@ void Combat_simulator::overpower(Sim_state& state)
     spend_rage(5);
     if (hit_outcome.hit_result != Hit_result::miss && hit_outcome.hit_result != Hit_result::dodge)
     {
-        maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.special_stats);
+        maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.stats);
         hit_effects(state, hit_outcome.hit_result, state.main_hand_weapon);
     }
     if (has_destroyer_2_set_)
@@ -527,8 +447,8 @@ void Combat_simulator::overpower(Sim_state& state)
     }
     time_keeper_.overpower_cast(5000);
     time_keeper_.global_cast(1500);
-    state.add_damage(Damage_source::overpower, hit_outcome.damage, time_keeper_.time);
-    logger_.print("Current rage: ", int(rage));
+    state.add_damage(Damage_source::overpower, hit_outcome.damage, time_keeper_.time, hit_outcome.hit_result);
+    logger_.rage(rage);
 }
 
 void Combat_simulator::whirlwind(Sim_state& state)
@@ -550,9 +470,10 @@ void Combat_simulator::whirlwind(Sim_state& state)
     {
         const auto& mh_outcome = generate_hit(state, state.main_hand_weapon, hit_table_yellow_mh_, mh_damage, i == 0, i == 0);
         total_damage += mh_outcome.damage;
+        state.damage_sources.add_hit_result(Damage_source::whirlwind, mh_outcome.hit_result);
         if (mh_outcome.hit_result != Hit_result::miss && mh_outcome.hit_result != Hit_result::dodge)
         {
-            maybe_gain_flurry(mh_outcome.hit_result, state.flurry_charges, state.special_stats);
+            maybe_gain_flurry(mh_outcome.hit_result, state.flurry_charges, state.stats);
             hit_effects(state, mh_outcome.hit_result, state.main_hand_weapon);
         }
         else if (mh_outcome.hit_result == Hit_result::dodge)
@@ -563,9 +484,10 @@ void Combat_simulator::whirlwind(Sim_state& state)
         {
             const auto& oh_outcome = generate_hit(state, state.off_hand_weapon, hit_table_yellow_oh_, oh_damage, i == 0, false);
             total_damage += oh_outcome.damage;
+            state.damage_sources.add_hit_result(Damage_source::whirlwind, oh_outcome.hit_result);
             if (oh_outcome.hit_result != Hit_result::miss && oh_outcome.hit_result != Hit_result::dodge)
             {
-                maybe_gain_flurry(oh_outcome.hit_result, state.flurry_charges, state.special_stats);
+                maybe_gain_flurry(oh_outcome.hit_result, state.flurry_charges, state.stats);
                 // most likely doesn't proc any non-weapon-specific hit effect
                 hit_effects(state, oh_outcome.hit_result, state.off_hand_weapon);
             }
@@ -574,7 +496,7 @@ void Combat_simulator::whirlwind(Sim_state& state)
     time_keeper_.whirlwind_cast(10000 - state.talents.improved_whirlwind * 1000);
     time_keeper_.global_cast(1500);
     state.add_damage(Damage_source::whirlwind, total_damage, time_keeper_.time);
-    logger_.print("Current rage: ", int(rage));
+    logger_.rage(rage);
 }
 
 void Combat_simulator::execute(Sim_state& state)
@@ -584,7 +506,7 @@ void Combat_simulator::execute(Sim_state& state)
         logger_.print("Execute (DPR)!");
         spend_rage(execute_rage_cost_);
         time_keeper_.global_cast(1500);
-        if (hit_table_yellow_mh_.isMissOrDodge()) return;
+        if (is_miss_or_dodge(hit_table_yellow_mh_)) return;
         spend_all_rage();
         return;
     }
@@ -599,21 +521,21 @@ void Combat_simulator::execute(Sim_state& state)
         {
             gain_rage(2);
         }
-        logger_.print("Current rage: ", int(rage));
+        logger_.rage(rage);
         return;
     }
     spend_all_rage();
-    maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.special_stats);
+    maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.stats);
     hit_effects(state, hit_outcome.hit_result, state.main_hand_weapon);
-    state.add_damage(Damage_source::execute, hit_outcome.damage, time_keeper_.time);
-    logger_.print("Current rage: ", int(rage));
+    state.add_damage(Damage_source::execute, hit_outcome.damage, time_keeper_.time, hit_outcome.hit_result);
+    logger_.rage(rage);
 }
 
 void Combat_simulator::hamstring(Sim_state& state)
 {
     if (config.dpr_settings.compute_dpr_ha_)
     {
-        spend_rage(hit_table_yellow_mh_.isMissOrDodge() ? 2 : 10);
+        spend_rage(is_miss_or_dodge(hit_table_yellow_mh_) ? 2 : 10);
         time_keeper_.global_cast(1500);
         return;
     }
@@ -632,17 +554,17 @@ void Combat_simulator::hamstring(Sim_state& state)
     else
     {
         spend_rage(10);
-        maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.special_stats);
+        maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.stats);
         hit_effects(state, hit_outcome.hit_result, state.main_hand_weapon);
     }
-    state.add_damage(Damage_source::hamstring, hit_outcome.damage, time_keeper_.time);
-    logger_.print("Current rage: ", int(rage));
+    state.add_damage(Damage_source::hamstring, hit_outcome.damage, time_keeper_.time, hit_outcome.hit_result);
+    logger_.rage(rage);
 }
 
 void Combat_simulator::sunder_armor(Sim_state& state)
 {
     logger_.print("Sunder Armor!");
-    auto hit_outcome = hit_table_yellow_mh_.generate_hit(0);
+    auto hit_outcome = hit_table_yellow_mh_.generate_hit(0, get_uniform_random(100));
     time_keeper_.global_cast(1500);
     if (hit_outcome.hit_result == Hit_result::miss || hit_outcome.hit_result == Hit_result::dodge)
     {
@@ -660,13 +582,13 @@ void Combat_simulator::sunder_armor(Sim_state& state)
         logger_.print("Current Sunder Armor stacks: ", sunder_armor_stacks_);
         recompute_mitigation_ = true;
     }
-    logger_.print("Current rage: ", int(rage));
+    logger_.rage(rage);
 }
 
 void Combat_simulator::hit_effects(Sim_state& state, Hit_result hit_result, Weapon_sim& weapon, Hit_type hit_type, Extra_attack_chain chain,
                                     Special_type special_type)
 {
-    maybe_add_rampage_stack(Hit_result::hit, state.rampage_stacks, state.special_stats);
+    maybe_add_rampage_stack(Hit_result::hit, state.rampage_stacks, state.stats);
 
     if (state.talents.mace_specialization > 0 && weapon.weapon_type == Weapon_type::mace && get_uniform_random(60) < state.talents.mace_specialization * 0.3 * weapon.swing_speed)
     {
@@ -676,30 +598,44 @@ void Combat_simulator::hit_effects(Sim_state& state, Hit_result hit_result, Weap
 
     auto extra_attack_procced = false; // melee/next_melee attacks only allow one extra attack per swing (but any number in a chain)
 
-    for (auto& hit_effect : weapon.hit_effects)
+    Weapon_sim* other_weapon = nullptr;
+    if (state.is_dual_wield)
+    {
+        other_weapon = weapon.socket == Socket::main_hand ? &state.off_hand_weapon : &state.main_hand_weapon;
+    }
+    if (weapon.procs.size() != weapon.hit_effects.size()) weapon.update_procs(other_weapon); // a hit aura was added
+
+    // procs added during the loop (hit auras) are evaluated from the next hit on, and since that can reallocate
+    // weapon.hit_effects, the entries are looked up by index
+    const size_t n_procs = weapon.procs.size();
+    for (size_t i = 0; i < n_procs; ++i)
     {
+        const auto proc = weapon.procs[i];
+        auto& hit_effect = weapon.hit_effects[proc.index];
+
         if (hit_effect.time_counter > time_keeper_.time) continue; // on cooldown
 
-        if (!hit_effect.is_procced_by(hit_result)) // wrong trigger
+        if ((proc.trigger & static_cast<uint8_t>(hit_result)) == 0) // wrong trigger
         {
             // darkmoon_card_wrath charges are removed on any crit hit
-            if (hit_effect.name == "darkmoon_card_wrath")
+            if (proc.removes_charge)
             {
                 buff_manager_.remove_charge(hit_effect, time_keeper_.time, logger_);
             }
             continue;
         }
 
-        auto probability = hit_effect.ppm > 0 ? hit_effect.ppm * weapon.swing_speed / 60 : hit_effect.probability;
-        if (probability < 1 && get_uniform_random(1) >= probability) continue; // no chance ;)
+        if (proc.probability < 1 && get_uniform_random(1) >= proc.probability) continue; // no chance ;)
+
+        auto* linked = proc.linked >= 0 ? &other_weapon->hit_effects[proc.linked] : nullptr;
 
-        switch (hit_effect.type)
+        switch (proc.type)
         {
         case Hit_effect::Type::windfury_hit: { // only triggered by melee or next_melee, and only once per chain
             if (hit_type == Hit_type::spell || chain.windfury) break;
 
             auto ineffective = extra_attack_procced;
-            on_proc(hit_effect, "PROC: extra hit from: ", hit_effect.name, ineffective ? " (ineffective)" : "");
+            on_proc(hit_effect, linked, "PROC: extra hit from: ", hit_effect.name, ineffective ? " (ineffective)" : "");
             chain.windfury = true;
             windfury_attack_.duration = hit_type == Hit_type::next_melee ? 1500 : 10; // even if the extra attack is ineffective, the buff is still up
             buff_manager_.add_combat_buff(windfury_attack_, time_keeper_.time);
@@ -713,7 +649,7 @@ void Combat_simulator::hit_effects(Sim_state& state, Hit_result hit_result, Weap
             if (chain.sword_spec) break;
 
             auto ineffective = hit_type != Hit_type::spell && extra_attack_procced;
-            on_proc(hit_effect, "PROC: extra hit from: ", hit_effect.name, ineffective ? " (ineffective)" : "");
+            on_proc(hit_effect, linked, "PROC: extra hit from: ", hit_effect.name, ineffective ? " (ineffective)" : "");
             chain.sword_spec = true;
             if (ineffective) break;
 
@@ -723,7 +659,7 @@ void Combat_simulator::hit_effects(Sim_state& state, Hit_result hit_result, Weap
         }
         case Hit_effect::Type::extra_hit: { // no restrictions
             auto ineffective = hit_type != Hit_type::spell && extra_attack_procced;
-            on_proc(hit_effect, "PROC: extra hit from: ", hit_effect.name, ineffective ? " (ineffective)" : "");
+            on_proc(hit_effect, linked, "PROC: extra hit from: ", hit_effect.name, ineffective ? " (ineffective)" : "");
             if (ineffective) break;
 
             extra_attack_procced = true;
@@ -731,12 +667,12 @@ void Combat_simulator::hit_effects(Sim_state& state, Hit_result hit_result, Weap
             break;
         }
         case Hit_effect::Type::stat_boost: {
-            on_proc(hit_effect, "PROC: ", hit_effect.name, " stats increased for ", hit_effect.duration * 0.001, "s");
+            on_proc(hit_effect, linked, "PROC: ", hit_effect.name, " stats increased for ", hit_effect.duration * 0.001, "s");
             buff_manager_.add_combat_buff(hit_effect, time_keeper_.time);
             break;
         }
         case Hit_effect::Type::rage_boost: {
-            on_proc(hit_effect, "PROC: ", hit_effect.name, ". Current rage: ", int(rage));
+            on_proc(hit_effect, linked, "PROC: ", hit_effect.name, ". Current rage: ", int(rage));
             gain_rage(hit_effect.damage);
             break;
         }
@@ -745,14 +681,14 @@ void Combat_simulator::hit_effects(Sim_state& state, Hit_result hit_result, Weap
             // (100 + special_stats.spell_crit / 2) / 100 is the average damage gained from a x1.5 spell crit
             double effect_damage = hit_effect.damage * 0.83 * (100 + state.special_stats.spell_crit / 2) / 100 *
                                    (1 + state.special_stats.damage_mod_spell);
-            on_proc(hit_effect, "PROC: ", hit_effect.name, " does ", effect_damage, " magic damage.");
+            on_proc(hit_effect, linked, "PROC: ", hit_effect.name, " does ", effect_damage, " magic damage.");
             state.add_damage(Damage_source::item_hit_effects, effect_damage, time_keeper_.time);
             break;
         }
         case Hit_effect::Type::damage_physical: {
             const auto& hit_outcome = generate_hit(state, state.main_hand_weapon, hit_table_yellow_mh_, hit_effect.damage);
-            on_proc(hit_effect, "PROC: ", hit_effect.name, " does ", hit_outcome.damage, " physical damage.");
-            state.add_damage(Damage_source::item_hit_effects, hit_outcome.damage, time_keeper_.time);
+            on_proc(hit_effect, linked, "PROC: ", hit_effect.name, " does ", hit_outcome.damage, " physical damage.");
+            state.add_damage(Damage_source::item_hit_effects, hit_outcome.damage, time_keeper_.time, hit_outcome.hit_result);
             if (hit_outcome.hit_result != Hit_result::miss && hit_outcome.hit_result != Hit_result::dodge)
             {
                 hit_effects(state, hit_outcome.hit_result, state.main_hand_weapon);
@@ -761,23 +697,21 @@ void Combat_simulator::hit_effects(Sim_state& state, Hit_result hit_result, Weap
         }
         case Hit_effect::Type::ashtongue_talisman_of_valor: {
             if (special_type != Special_type::ms_bt) break;
-            on_proc(hit_effect, "PROC: ", hit_effect.name, " stats increased for ", hit_effect.duration * 0.001, "s");
+            on_proc(hit_effect, linked, "PROC: ", hit_effect.name, " stats increased for ", hit_effect.duration * 0.001, "s");
             buff_manager_.add_combat_buff(hit_effect, time_keeper_.time);
             break;
         }
         case Hit_effect::Type::blackened_naaru_sliver: {
-            on_proc(hit_effect, "PROC: ", hit_effect.name, " buff active for ", hit_effect.duration * 0.001, "s");
+            on_proc(hit_effect, linked, "PROC: ", hit_effect.name, " buff active for ", hit_effect.duration * 0.001, "s");
             //activate the buff that will add one stack on each subsequent hit (20s duration, no cooldown, 100% chance, max charges 10)
-            Hit_effect bnsa_hit_effect("blackened_naaru_sliver_active", Hit_effect::Type::blackened_naaru_sliver_active, {}, {}, 0, 20, 0, 1);
-            buff_manager_.add_combat_buff(bnsa_hit_effect, time_keeper_.time);
-            buff_manager_.add_hit_aura(bnsa_hit_effect.name, bnsa_hit_effect, bnsa_hit_effect.duration, time_keeper_.time);
+            buff_manager_.add_combat_buff(blackened_naaru_sliver_active_, time_keeper_.time);
+            buff_manager_.add_hit_aura(blackened_naaru_sliver_active_.name, blackened_naaru_sliver_active_, blackened_naaru_sliver_active_.duration, time_keeper_.time);
             break;
         }
         case Hit_effect::Type::blackened_naaru_sliver_active: {
-            on_proc(hit_effect, "PROC: Blackened Naaru Sliver stack gained");
+            on_proc(hit_effect, linked, "PROC: Blackened Naaru Sliver stack gained");
             //add one 44 AP stack of blackened_naaru_sliver, with 20s duration (all stacks will be dropped early when blackened_naaru_sliver_active fades)
-            Hit_effect bnss_hit_effect("blackened_naaru_sliver_stacks", Hit_effect::Type::stat_boost, {}, {0, 0, 44}, 0, 20, 0, 0, 0, 1, 0, 10);
-            buff_manager_.add_combat_buff(bnss_hit_effect, time_keeper_.time);
+            buff_manager_.add_combat_buff(blackened_naaru_sliver_stacks_, time_keeper_.time);
             break;
         }
         default:
@@ -801,7 +735,7 @@ void Combat_simulator::swing_main_hand(Sim_state& state, Extra_attack_chain chai
 {
     auto& weapon = state.main_hand_weapon;
 
-    maybe_remove_flurry(state.flurry_charges, state.special_stats);
+    maybe_remove_flurry(state.flurry_charges, state.stats);
 
     auto white_replaced = false;
     if (ability_queue_manager.heroic_strike_queued)
@@ -810,7 +744,7 @@ void Combat_simulator::swing_main_hand(Sim_state& state, Extra_attack_chain chai
         if (rage >= heroic_strike_rage_cost_ && config.dpr_settings.compute_dpr_hs_)
         {
             logger_.print("Performing Heroic Strike (DPR)");
-            spend_rage(hit_table_yellow_mh_.isMissOrDodge() ? heroic_strike_rage_cost_ :
+            spend_rage(is_miss_or_dodge(hit_table_yellow_mh_) ? heroic_strike_rage_cost_ :
                                                               0.2 * heroic_strike_rage_cost_);
         }
         else if (rage >= heroic_strike_rage_cost_)
@@ -826,11 +760,11 @@ void Combat_simulator::swing_main_hand(Sim_state& state, Extra_attack_chain chai
             else
             {
                 spend_rage(heroic_strike_rage_cost_);
-                maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.special_stats);
+                maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.stats);
                 unbridled_wrath(state, weapon);
                 hit_effects(state, hit_outcome.hit_result, weapon, Hit_type::next_melee, chain);
             }
-            state.add_damage(Damage_source::heroic_strike, hit_outcome.damage, time_keeper_.time);
+            state.add_damage(Damage_source::heroic_strike, hit_outcome.damage, time_keeper_.time, hit_outcome.hit_result);
             white_replaced = true;
         }
         else
@@ -838,7 +772,7 @@ void Combat_simulator::swing_main_hand(Sim_state& state, Extra_attack_chain chai
             // Failed to pay rage for heroic strike
             logger_.print("Failed to pay rage for Heroic Strike");
         }
-        logger_.print("Current rage: ", int(rage));
+        logger_.rage(rage);
     }
     else if (ability_queue_manager.cleave_queued)
     {
@@ -859,9 +793,10 @@ void Combat_simulator::swing_main_hand(Sim_state& state, Extra_attack_chain chai
             {
                 const auto& hit_outcome = generate_hit(state, weapon, hit_table_yellow_mh_, damage, i == 0);
                 total_damage += hit_outcome.damage;
+                state.damage_sources.add_hit_result(Damage_source::cleave, hit_outcome.hit_result);
                 if (hit_outcome.hit_result != Hit_result::miss && hit_outcome.hit_result != Hit_result::dodge)
                 {
-                    maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.special_stats);
+                    maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.stats);
                     unbridled_wrath(state, weapon);
                     hit_effects(state, hit_outcome.hit_result, weapon, Hit_type::next_melee, chain);
                 }
@@ -877,7 +812,7 @@ void Combat_simulator::swing_main_hand(Sim_state& state, Extra_attack_chain chai
         {
             logger_.print("Failed to pay rage for Cleave");
         }
-        logger_.print("Current rage: ", int(rage));
+        logger_.rage(rage);
     }
 
     if (!white_replaced)
@@ -888,7 +823,7 @@ void Combat_simulator::swing_main_hand(Sim_state& state, Extra_attack_chain chai
         if (hit_outcome.hit_result != Hit_result::miss && hit_outcome.hit_result != Hit_result::dodge)
         {
             gain_rage(rage_generation(state, hit_outcome, weapon));
-            maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.special_stats);
+            maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.stats);
             unbridled_wrath(state, weapon);
             hit_effects(state, hit_outcome.hit_result, weapon, Hit_type::melee, chain);
         }
@@ -902,8 +837,8 @@ void Combat_simulator::swing_main_hand(Sim_state& state, Extra_attack_chain chai
             logger_.print("Rage gained since the enemy dodged.");
         }
 
-        logger_.print("Current rage: ", int(rage));
-        state.add_damage(Damage_source::white_mh, hit_outcome.damage, time_keeper_.time);
+        logger_.rage(rage);
+        state.add_damage(Damage_source::white_mh, hit_outcome.damage, time_keeper_.time, hit_outcome.hit_result);
     }
 }
 
@@ -911,7 +846,7 @@ void Combat_simulator::swing_off_hand(Sim_state& state)
 {
     auto& weapon = state.off_hand_weapon;
 
-    maybe_remove_flurry(state.flurry_charges, state.special_stats);
+    maybe_remove_flurry(state.flurry_charges, state.stats);
 
     auto is_queued = (ability_queue_manager.heroic_strike_queued && !config.dpr_settings.compute_dpr_hs_) || (ability_queue_manager.cleave_queued && !config.dpr_settings.compute_dpr_cl_);
     auto hit_table = is_queued ? hit_table_white_oh_queued_ : hit_table_white_oh_;
@@ -922,7 +857,7 @@ void Combat_simulator::swing_off_hand(Sim_state& state)
     if (hit_outcome.hit_result != Hit_result::miss && hit_outcome.hit_result != Hit_result::dodge)
     {
         gain_rage(rage_generation(state, hit_outcome, weapon));
-        maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.special_stats);
+        maybe_gain_flurry(hit_outcome.hit_result, state.flurry_charges, state.stats);
         unbridled_wrath(state, weapon);
         hit_effects(state, hit_outcome.hit_result, weapon, Hit_type::melee);
     }
@@ -936,8 +871,8 @@ void Combat_simulator::swing_off_hand(Sim_state& state)
         logger_.print("Rage gained since the enemy dodged.");
     }
 
-    logger_.print("Current rage: ", int(rage));
-    state.add_damage(Damage_source::white_oh, hit_outcome.damage, time_keeper_.time);
+    logger_.rage(rage);
+    state.add_damage(Damage_source::white_oh, hit_outcome.damage, time_keeper_.time, hit_outcome.hit_result);
 }
 
 void Combat_simulator::update_swing_timers(Sim_state& state, double oldHaste)
@@ -951,10 +886,12 @@ void Combat_simulator::update_swing_timers(Sim_state& state, double oldHaste)
     if (mh.next_swing == current_time)
     {
         mh.next_swing = from_offset(1000 * mh.swing_speed / (1 + haste));
+        time_keeper_.schedule(Time_keeper::mh_swing_timer, mh.next_swing);
     }
     else if (haste != oldHaste)
     {
         mh.next_swing = from_offset((mh.next_swing - current_time) * (1 + oldHaste) / (1 + haste));
+        time_keeper_.schedule(Time_keeper::mh_swing_timer, mh.next_swing);
     }
 
     if (!state.is_dual_wield) return;
@@ -966,23 +903,169 @@ void Combat_simulator::update_swing_timers(Sim_state& state, double oldHaste)
     if (oh.next_swing == current_time)
     {
         oh.next_swing = from_offset(1000 * oh.swing_speed / (1 + haste));
+        time_keeper_.schedule(Time_keeper::oh_swing_timer, oh.next_swing);
     }
     else if (haste != oldHaste)
     {
         oh.next_swing = from_offset((oh.next_swing - current_time) * (1 + oldHaste) / (1 + haste));
+        time_keeper_.schedule(Time_keeper::oh_swing_timer, oh.next_swing);
     }
 }
 
 void Combat_simulator::simulate(const Character& character, bool log_data)
 {
-    simulate(character, [this](const auto& d) { return d.samples() == config.n_batches; }, log_data);
+    const int n_workers = std::min(config.n_threads, config.n_batches);
+    if (n_workers <= 1 || config.display_combat_debug)
+    {
+        auto rule = config.stopping_rule;
+        simulate(character, rule.with_max_samples(config.n_batches), log_data);
+        return;
+    }
+    simulate_parallel(character, n_workers, log_data);
 }
 
 Distribution Combat_simulator::simulate(const Combat_simulator_config& config, const Character& character)
 {
+    return simulate_result(config, character)->dps;
+}
+
+std::shared_ptr<const Sim_result> Combat_simulator::simulate_result(const Combat_simulator_config& config,
+                                                                    const Character& character, bool log_data)
+{
+    auto& cache = Result_cache::shared();
+    const auto key = Sim_hash{}.add(config).add(character).add(log_data).value();
+    if (auto result = cache.find(key)) return result;
+
     Combat_simulator sim(config);
-    sim.simulate(character, false);
-    return sim.get_dps_distribution();
+    sim.simulate(character, log_data);
+    return cache.insert(key, sim.get_result());
+}
+
+std::vector<Distribution> Combat_simulator::simulate(const Combat_simulator_config& config,
+                                                   const std::vector<Character>& characters, Task_pool& pool)
+{
+    auto character_config = config;
+    character_config.n_threads = 1;
+
+    std::vector<std::future<Distribution>> runs;
+    runs.reserve(characters.size());
+    for (const auto& character : characters)
+    {
+        runs.push_back(pool.submit([&character_config, &character]() { return simulate(character_config, character); }));
+    }
+
+    std::vector<Distribution> distributions;
+    distributions.reserve(characters.size());
+    for (auto& run : runs)
+    {
+        distributions.push_back(pool.wait(run));
+    }
+    return distributions;
+}
+
+std::vector<Distribution> Combat_simulator::simulate_ablations(const Combat_simulator_config& config, const Character& character,
+                                                             const std::vector<Combat_simulator_config::dpr_t>& ablations)
+{
+    auto run_config = config;
+    run_config.common_random_numbers = true;
+    run_config.display_combat_debug = false;
+    run_config.dpr_settings = {};
+
+    // the runs are set up once and stay in place, their buff managers point into them
+    std::deque<Combat_simulator> runs;
+    runs.emplace_back(run_config);
+    for (const auto& ablation : ablations)
+    {
+        run_config.dpr_settings = ablation;
+        runs.emplace_back(run_config);
+    }
+    std::vector<Iteration_kernel> kernels;
+    kernels.reserve(runs.size());
+    for (auto& run : runs)
+    {
+        run.has_run = true;
+        kernels.emplace_back(run.prepare_batches(character));
+    }
+
+    auto rule = config.stopping_rule;
+    rule.with_max_samples(config.n_batches);
+    std::vector<Distribution> dps_lost(ablations.size());
+    auto done = [&rule, &dps_lost]() {
+        return std::all_of(dps_lost.begin(), dps_lost.end(), [&rule](const Distribution& d) { return rule.done(d); });
+    };
+    while (!done())
+    {
+        for (size_t i = 0; i < runs.size(); ++i)
+        {
+            (runs[i].*kernels[i])(character, false);
+        }
+        for (size_t i = 0; i < dps_lost.size(); ++i)
+        {
+            dps_lost[i].add_sample(runs[0].dps_samples_.back() - runs[i + 1].dps_samples_.back());
+        }
+    }
+    return dps_lost;
+}
+
+std::vector<Distribution> Combat_simulator::simulate_race(const Combat_simulator_config& config,
+                                                         const std::vector<Character>& candidates,
+                                                         const std::vector<double>& base_samples, StoppingRule rule,
+                                                         int round_size)
+{
+    auto run_config = config;
+    run_config.common_random_numbers = true;
+    run_config.display_combat_debug = false;
+    assert(rule.max_samples() <= static_cast<int>(base_samples.size()));
+
+    std::deque<Combat_simulator> runs;
+    std::vector<Iteration_kernel> kernels;
+    kernels.reserve(candidates.size());
+    for (const auto& candidate : candidates)
+    {
+        auto& run = runs.emplace_back(run_config);
+        run.has_run = true;
+        kernels.emplace_back(run.prepare_batches(candidate));
+    }
+
+    std::vector<Distribution> diffs(candidates.size());
+    std::vector<std::vector<double>> diff_samples(candidates.size());
+    std::vector<bool> racing(candidates.size(), true);
+    size_t n_racing = candidates.size();
+    auto stop = [&racing, &n_racing](size_t i) {
+        racing[i] = false;
+        --n_racing;
+    };
+    while (n_racing > 0)
+    {
+        for (size_t i = 0; i < candidates.size(); ++i)
+        {
+            if (!racing[i]) continue;
+            for (int k = 0; k < round_size && !rule.done(diffs[i]); ++k)
+            {
+                (runs[i].*kernels[i])(candidates[i], false);
+                const double diff = runs[i].dps_samples_.back() - base_samples[diffs[i].samples()];
+                diffs[i].add_sample(diff);
+                diff_samples[i].push_back(diff);
+            }
+            if (rule.done(diffs[i])) stop(i);
+        }
+
+        const auto best = static_cast<size_t>(
+            std::max_element(diffs.begin(), diffs.end(), [](const auto& a, const auto& b) { return a.mean() < b.mean(); }) -
+            diffs.begin());
+        for (size_t i = 0; i < candidates.size(); ++i)
+        {
+            if (!racing[i] || i == best) continue;
+            Distribution behind{};
+            const auto n = std::min(diff_samples[i].size(), diff_samples[best].size());
+            for (size_t j = 0; j < n; ++j)
+            {
+                behind.add_sample(diff_samples[i][j] - diff_samples[best][j]);
+            }
+            if (behind.samples() >= rule.min_samples() && rule.sign(behind) < 0) stop(i);
+        }
+    }
+    return diffs;
 }
 
 void Combat_simulator::simulate(const Character& character, const std::function<bool(const Distribution&)>& target, bool log_data)
@@ -996,6 +1079,142 @@ void Combat_simulator::simulate(const Character& character, const std::function<
         reset_time_lapse();
         init_histogram();
     }
+
+    run_batches(character, target, log_data);
+
+    if (log_data)
+    {
+        normalize_timelapse();
+    }
+}
+
+void Combat_simulator::simulate_parallel(const Character& character, int n_workers, bool log_data)
+{
+    assert(!has_run);
+    has_run = true;
+
+    if (log_data)
+    {
+        reset_time_lapse();
+        init_histogram();
+    }
+
+    // every worker is a full simulator (time keeper, buff manager, weapons, statistics) running its share of the batches
+    std::deque<Combat_simulator> workers;
+    int first_iteration = 0;
+    for (int i = 0; i < n_workers; ++i)
+    {
+        auto worker_config = config;
+        worker_config.n_batches = config.n_batches / n_workers + (i < config.n_batches % n_workers ? 1 : 0);
+        worker_config.n_threads = 1;
+        auto& worker = workers.emplace_back(worker_config);
+        worker.rng_.reseed(config.seed, i); // independent substream per worker, so results only depend on seed and n_threads
+        worker.first_iteration_ = first_iteration;
+        first_iteration += worker_config.n_batches;
+    }
+
+    // every worker stops by its share of the stopping rule. with common random numbers the iterations have to be
+    // consecutive to be paired with another run, so the workers run all their batches
+    const auto worker_rule = config.stopping_rule.split(n_workers);
+    std::vector<std::thread> threads;
+    threads.reserve(workers.size());
+    for (auto& worker : workers)
+    {
+        threads.emplace_back([&worker, &character, worker_rule, log_data]() {
+            if (log_data)
+            {
+                worker.reset_time_lapse();
+                worker.init_histogram();
+            }
+            auto rule = worker.config.common_random_numbers ? StoppingRule{} : worker_rule;
+            worker.run_batches(character, rule.with_max_samples(worker.config.n_batches), log_data);
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const auto& worker : workers)
+    {
+        merge(worker);
+    }
+
+    // the caller might still ask for e.g. the use effect schedule
+    add_talent_effects(character);
+    add_use_effects(character);
+    add_over_time_effects(character);
+
+    if (log_data)
+    {
+        normalize_timelapse();
+    }
+}
+
+void Combat_simulator::merge(const Combat_simulator& other)
+{
+    const int n = dps_distribution_.samples();
+    const int n_other = other.dps_distribution_.samples();
+    if (n_other == 0) return;
+
+    auto merge_mean = [n, n_other](double mean, double mean_other) {
+        return (mean * n + mean_other * n_other) / (n + n_other);
+    };
+    flurry_uptime_ = merge_mean(flurry_uptime_, other.flurry_uptime_);
+    oh_queued_uptime_ = merge_mean(oh_queued_uptime_, other.oh_queued_uptime_);
+    rampage_uptime_ = merge_mean(rampage_uptime_, other.rampage_uptime_);
+    avg_rage_spent_executing_ = merge_mean(avg_rage_spent_executing_, other.avg_rage_spent_executing_);
+
+    dps_distribution_.add(other.dps_distribution_);
+    dps_samples_.insert(dps_samples_.end(), other.dps_samples_.begin(), other.dps_samples_.end());
+    damage_distribution_ += other.damage_distribution_;
+
+    rage_gained_ += other.rage_gained_;
+    rage_spent_ += other.rage_spent_;
+    rage_lost_stance_swap_ += other.rage_lost_stance_swap_;
+    rage_lost_capped_ += other.rage_lost_capped_;
+
+    for (const auto& proc : other.proc_data_)
+    {
+        proc_data_[proc.first] += proc.second;
+    }
+    for (const auto& aura : other.aura_uptimes_)
+    {
+        aura_uptimes_[aura.first] += aura.second;
+    }
+
+    if (!other.time_lapse_.empty())
+    {
+        time_lapse_ += other.time_lapse_;
+    }
+
+    dps_histogram_.add(other.dps_histogram_);
+}
+
+void Combat_simulator::run_batches(const Character& character, const std::function<bool(const Distribution&)>& target, bool log_data)
+{
+    const auto run_iteration = prepare_batches(character);
+    while (!target(dps_distribution_))
+    {
+        (this->*run_iteration)(character, log_data);
+    }
+    finish_batches();
+}
+
+Combat_simulator::Iteration_kernel Combat_simulator::prepare_batches(const Character& character)
+{
+    add_talent_effects(character);
+
+    rotation_features_ = 0;
+    if (character.is_dual_wield()) rotation_features_ |= Rotation_kernel::dual_wield;
+    if (use_bloodthirst_) rotation_features_ |= Rotation_kernel::bloodthirst;
+    if (use_mortal_strike_) rotation_features_ |= Rotation_kernel::mortal_strike;
+    if (config.combat.use_slam && character.weapons[0].weapon_socket == Weapon_socket::two_hand)
+    {
+        rotation_features_ |= Rotation_kernel::slam;
+    }
+    if (config.multi_target_mode_) rotation_features_ |= Rotation_kernel::multi_target;
+
     damage_distribution_ = Damage_sources();
 
     if (config.display_combat_debug)
@@ -1003,16 +1222,13 @@ void Combat_simulator::simulate(const Character& character, const std::function<
         logger_ = Logger(time_keeper_);
     }
 
-    add_talent_effects(character);
-
-    const auto starting_special_stats = character.total_special_stats;
     compute_hit_table_stats_ = {-1,-1,0};
 
-    std::vector<Weapon_sim> weapons;
+    weapons_.clear();
     for (const auto& wep : character.weapons)
     {
-        auto& weapon = weapons.emplace_back(wep);
-        compute_hit_tables(character, starting_special_stats, weapon);
+        auto& weapon = weapons_.emplace_back(wep);
+        compute_hit_tables(character, character.total_special_stats, weapon);
 
         if (weapon.weapon_type == Weapon_type::sword && character.talents.sword_specialization > 0)
         {
@@ -1031,7 +1247,7 @@ void Combat_simulator::simulate(const Character& character, const std::function<
             e.sanitize();
         }
     }
-    compute_hit_table_stats_ = starting_special_stats;
+    compute_hit_table_stats_ = character.total_special_stats;
 
     // handle non-stat set bonuses
     if (character.has_set_bonus(Set::warbringer, 2))
@@ -1049,330 +1265,357 @@ void Combat_simulator::simulate(const Character& character, const std::function<
     has_onslaught_2_set_ = character.has_set_bonus(Set::onslaught, 2);
     has_onslaught_4_set_ = character.has_set_bonus(Set::onslaught, 4);
 
-    const bool is_dual_wield = character.is_dual_wield();
-
-    const int sim_time = to_millis(config.sim_time);
-    const int time_execute_phase = to_millis(config.sim_time * (100.0 - config.execute_phase_percentage_) / 100.0);
+    const bool is_dual_wield = (rotation_features_ & Rotation_kernel::dual_wield) != 0;
 
     add_use_effects(character);
     add_over_time_effects(character);
 
-    auto use_effect_schedule = compute_use_effects_schedule(character);
+    use_effect_schedule_ = compute_use_effects_schedule(character);
 
-    auto empty_hit_effects = std::vector<Hit_effect>();
     if (is_dual_wield)
     {
-        buff_manager_.initialize(weapons[0].hit_effects,weapons[1].hit_effects, use_effect_schedule, this);
+        buff_manager_.initialize(weapons_[0].hit_effects,weapons_[1].hit_effects, use_effect_schedule_, this);
     }
     else
     {
-        buff_manager_.initialize(weapons[0].hit_effects,empty_hit_effects, use_effect_schedule, this);
+        buff_manager_.initialize(weapons_[0].hit_effects,no_hit_effects_, use_effect_schedule_, this);
     }
 
-    std::vector<Damage_instance> damage_instances{};
+    weapons_[0].update_procs(is_dual_wield ? &weapons_[1] : nullptr);
+    if (is_dual_wield) weapons_[1].update_procs(&weapons_[0]);
 
-    while (!target(dps_distribution_))
+    if (!config.generic_rotation_kernel)
     {
-        ability_queue_manager.reset();
-        logger_.reset();
-        slam_manager = Slam_manager(1500 - 500 * character.talents.improved_slam);
-        rage = config.initial_rage;
-        sunder_armor_stacks_ = config.n_sunder_armor_stacks;
+        switch (rotation_features_)
+        {
+        case Rotation_kernel::fury_dual_wield:
+            return &Combat_simulator::run_iteration<Rotation_kernel::fury_dual_wield>;
+        case Rotation_kernel::arms_slam:
+            return &Combat_simulator::run_iteration<Rotation_kernel::arms_slam>;
+        default:
+            break;
+        }
+    }
+    return &Combat_simulator::run_iteration<Rotation_kernel::generic>;
+}
 
-        // permute hit_effect order between runs - this isn't strictly necessary, but closer to what happens in-game, it seems
-        std::next_permutation(weapons[0].hit_effects.begin(), weapons[0].hit_effects.end(), [](const auto& he1, const auto& he2) { return he1.name < he2.name; });
-        if (is_dual_wield) std::next_permutation(weapons[1].hit_effects.begin(), weapons[1].hit_effects.end(), [](const auto& he1, const auto& he2) { return he1.name < he2.name; });
+template <unsigned Kernel>
+void Combat_simulator::run_iteration(const Character& character, bool log_data)
+{
+    const bool is_dual_wield = uses<Kernel>(Rotation_kernel::dual_wield);
 
-        Sim_state state(
-            weapons[0],
-            is_dual_wield ? weapons[1] : weapons[0],
-            is_dual_wield,
-            starting_special_stats,
-            character.talents,
-            damage_instances,
-            log_data
-        );
+    const int sim_time = to_millis(config.sim_time);
+    const int time_execute_phase = to_millis(config.sim_time * (100.0 - config.execute_phase_percentage_) / 100.0);
 
-        buff_manager_.reset(state);
+    if (config.common_random_numbers)
+    {
+        rng_.reseed_iteration(config.seed, first_iteration_ + dps_distribution_.samples());
+    }
 
-        rage_spent_on_execute_ = 0;
+    ability_queue_manager.reset();
+    logger_.reset();
+    slam_manager = Slam_manager(1500 - 500 * character.talents.improved_slam);
+    rage = config.initial_rage;
+    sunder_armor_stacks_ = config.n_sunder_armor_stacks;
 
-        apply_delayed_armor_reduction = false;
-        bool in_execute_phase = false;
+    // permute hit_effect order between runs - this isn't strictly necessary, but closer to what happens in-game, it seems
+    for (size_t w = 0; w < (is_dual_wield ? 2 : 1); ++w)
+    {
+        const auto& hit_effects = weapons_[w].hit_effects;
+        std::next_permutation(weapons_[w].procs.begin(), weapons_[w].procs.end(), [&hit_effects](const auto& p1, const auto& p2) {
+            return hit_effects[p1.index].name < hit_effects[p2.index].name;
+        });
+    }
 
-        double flurry_uptime = 0.0;
+    Sim_state state(
+        weapons_[0],
+        is_dual_wield ? weapons_[1] : weapons_[0],
+        is_dual_wield,
+        character.total_special_stats,
+        character.talents,
+        log_data ? &time_lapse_ : nullptr
+    );
 
-        int mh_hits = 0;
-        int oh_hits = 0;
-        int oh_hits_w_queued = 0;
-        int mh_hits_w_rampage = 0;
+    buff_manager_.reset(state);
 
-        state.main_hand_weapon.next_swing = 0;
-        if (state.is_dual_wield) state.off_hand_weapon.next_swing = to_millis(0.5 * state.off_hand_weapon.swing_speed / (1 + state.special_stats.haste)); // de-sync mh/oh swing timers
+    rage_spent_on_execute_ = 0;
 
-        // Combat configuration
-        if (!config.multi_target_mode_)
-        {
-            number_of_extra_targets_ = 0;
-        }
-        else
-        {
-            number_of_extra_targets_ = config.number_of_extra_targets;
-        }
+    apply_delayed_armor_reduction = false;
+    bool in_execute_phase = false;
 
-        // Check if the simulator should use any use effects before the fight
-        for (const auto& ue : use_effect_schedule)
-        {
-            if (ue.first >= 0) break;
+    double flurry_uptime = 0.0;
 
-            // set everything up so it works ;)
-            time_keeper_.prepare(ue.first);
-            rage -= ue.second.get().rage_boost;
+    int mh_hits = 0;
+    int oh_hits = 0;
+    int oh_hits_w_queued = 0;
+    int mh_hits_w_rampage = 0;
 
-            buff_manager_.increment(time_keeper_, logger_);
-        }
+    state.main_hand_weapon.next_swing = 0;
+    if (is_dual_wield) state.off_hand_weapon.next_swing = to_millis(0.5 * state.off_hand_weapon.swing_speed / (1 + state.special_stats.haste)); // de-sync mh/oh swing timers
 
-        time_keeper_.reset();
+    // Combat configuration
+    if (!uses<Kernel>(Rotation_kernel::multi_target))
+    {
+        number_of_extra_targets_ = 0;
+    }
+    else
+    {
+        number_of_extra_targets_ = config.number_of_extra_targets;
+    }
 
-        for (auto& over_time_effect : over_time_effects_)
-        {
-            buff_manager_.add_over_time_buff(over_time_effect, 0);
-        }
+    // Check if the simulator should use any use effects before the fight
+    for (const auto& ue : use_effect_schedule_)
+    {
+        if (ue.first >= 0) break;
 
-        // First global sunder
-        int sunder_armor_globals = config.sunder_armor_globals_;
+        // set everything up so it works ;)
+        time_keeper_.prepare(ue.first);
+        rage -= ue.second.get().rage_boost;
 
-        if (config.combat.first_hit_heroic_strike && rage >= heroic_strike_rage_cost_)
-        {
-            ability_queue_manager.queue_heroic_strike();
-        }
+        buff_manager_.increment(time_keeper_, logger_);
+    }
 
-        while (time_keeper_.time < sim_time)
-        {
-            int next_mh_swing = state.main_hand_weapon.next_swing;
-            int next_oh_swing = state.is_dual_wield ? state.off_hand_weapon.next_swing : -1;
-            int next_buff_event = buff_manager_.next_event(time_keeper_.time);
-            int next_slam_finish = slam_manager.next_finish();
-            int next_event = time_keeper_.get_next_event(next_mh_swing, next_oh_swing,
-                                                         next_buff_event, next_slam_finish, sim_time);
-            if (state.flurry_charges > 0) flurry_uptime += next_event - time_keeper_.time;
-            time_keeper_.increment(next_event);
+    time_keeper_.reset();
+    time_keeper_.schedule(Time_keeper::mh_swing_timer, state.main_hand_weapon.next_swing);
+    if (is_dual_wield) time_keeper_.schedule(Time_keeper::oh_swing_timer, state.off_hand_weapon.next_swing);
 
-            double oldHaste = state.special_stats.haste;
+    for (auto& over_time_effect : over_time_effects_)
+    {
+        buff_manager_.add_over_time_buff(over_time_effect, 0);
+    }
 
-            buff_manager_.increment(time_keeper_, logger_);
+    // First global sunder
+    int sunder_armor_globals = config.sunder_armor_globals_;
 
-            if (buff_manager_.need_to_recompute_hit_tables)
-            {
-                compute_hit_tables(character, state.special_stats, state.main_hand_weapon);
-                if (state.is_dual_wield)
-                {
-                    compute_hit_tables(character, state.special_stats, state.off_hand_weapon);
-                }
-                compute_hit_table_stats_ = state.special_stats;
+    if (config.combat.first_hit_heroic_strike && rage >= heroic_strike_rage_cost_)
+    {
+        ability_queue_manager.queue_heroic_strike();
+    }
 
-                buff_manager_.need_to_recompute_hit_tables = false;
-            }
+    while (time_keeper_.time < sim_time)
+    {
+        int next_event = time_keeper_.get_next_event(buff_manager_.next_event(time_keeper_.time), sim_time);
+        if (state.flurry_charges > 0) flurry_uptime += next_event - time_keeper_.time;
+        time_keeper_.increment(next_event);
+
+        double oldHaste = state.special_stats.haste;
+
+        buff_manager_.increment(time_keeper_, logger_);
 
-            if (buff_manager_.need_to_recompute_mitigation)
+        const auto changed_stats = state.stats.take_changed();
+
+        if (changed_stats & Stat_aggregator::hit_table_fields)
+        {
+            compute_hit_tables(character, state.special_stats, state.main_hand_weapon);
+            if (is_dual_wield)
             {
-                recompute_mitigation_ = true;
-                buff_manager_.need_to_recompute_mitigation = false;
+                compute_hit_tables(character, state.special_stats, state.off_hand_weapon);
             }
+            compute_hit_table_stats_ = state.special_stats;
+        }
 
-            if (!apply_delayed_armor_reduction && time_keeper_.time >= 6000 && config.exposed_armor)
+        if (changed_stats & Stat_aggregator::gear_armor_pen)
+        {
+            recompute_mitigation_ = true;
+        }
+
+        if (!apply_delayed_armor_reduction && time_keeper_.time >= 6000 && config.exposed_armor)
+        {
+            apply_delayed_armor_reduction = true;
+            recompute_mitigation_ = true;
+            logger_.print("Applying improved exposed armor!");
+        }
+
+        if (recompute_mitigation_)
+        {
+            int target_armor =
+                config.main_target_initial_armor_ - armor_reduction_from_spells_ - state.special_stats.gear_armor_pen - 520 * sunder_armor_stacks_;
+            if (apply_delayed_armor_reduction)
             {
-                apply_delayed_armor_reduction = true;
-                recompute_mitigation_ = true;
-                logger_.print("Applying improved exposed armor!");
+                target_armor -= armor_reduction_delayed_ - 520 * sunder_armor_stacks_;
             }
-
-            if (recompute_mitigation_)
+            target_armor = std::max(target_armor, 0);
+            armor_reduction_factor_ = armor_reduction_factor(target_armor);
+            logger_.print("Target armor: ", target_armor, ". Mitigation factor: ", 100 * (1 - armor_reduction_factor_), "%.");
+            if (uses<Kernel>(Rotation_kernel::multi_target))
             {
-                int target_armor =
-                    config.main_target_initial_armor_ - armor_reduction_from_spells_ - state.special_stats.gear_armor_pen - 520 * sunder_armor_stacks_;
-                if (apply_delayed_armor_reduction)
-                {
-                    target_armor -= armor_reduction_delayed_ - 520 * sunder_armor_stacks_;
-                }
-                target_armor = std::max(target_armor, 0);
-                armor_reduction_factor_ = armor_reduction_factor(target_armor);
-                logger_.print("Target armor: ", target_armor, ". Mitigation factor: ", 100 * (1 - armor_reduction_factor_), "%.");
-                if (config.multi_target_mode_)
-                {
-                    int extra_target_armor = config.extra_target_initial_armor_ - state.special_stats.gear_armor_pen;
-                    extra_target_armor = std::max(extra_target_armor, 0);
-                    armor_reduction_factor_add = armor_reduction_factor(extra_target_armor);
+                int extra_target_armor = config.extra_target_initial_armor_ - state.special_stats.gear_armor_pen;
+                extra_target_armor = std::max(extra_target_armor, 0);
+                armor_reduction_factor_add = armor_reduction_factor(extra_target_armor);
 
-                    logger_.print("Extra targets armor: ", extra_target_armor,
-                                  ". Mitigation factor: ", 1 - armor_reduction_factor_add, "%.");
-                }
-                recompute_mitigation_ = false;
+                logger_.print("Extra targets armor: ", extra_target_armor,
+                              ". Mitigation factor: ", 1 - armor_reduction_factor_add, "%.");
             }
+            recompute_mitigation_ = false;
+        }
 
-            if (config.multi_target_mode_ && number_of_extra_targets_ > 0 &&
-                time_keeper_.time >= sim_time * config.extra_target_percentage / 100)
-            {
-                logger_.print("Extra targets die.");
-                number_of_extra_targets_ = 0;
-            }
+        if (uses<Kernel>(Rotation_kernel::multi_target) && number_of_extra_targets_ > 0 &&
+            time_keeper_.time >= sim_time * config.extra_target_percentage / 100)
+        {
+            logger_.print("Extra targets die.");
+            number_of_extra_targets_ = 0;
+        }
 
-            if (slam_manager.is_slam_casting())
+        if (uses<Kernel>(Rotation_kernel::slam) && slam_manager.is_slam_casting())
+        {
+            if (!slam_manager.ready(time_keeper_.time))
             {
-                if (!slam_manager.ready(time_keeper_.time))
-                {
-                    continue; // the swing timer is effectively stopped while slam is casting
-                }
+                continue; // the swing timer is effectively stopped while slam is casting
+            }
 
-                gain_rage(15); // unreserve slam cost
-                slam(state);
-                slam_manager.finish_slam();
+            gain_rage(15); // unreserve slam cost
+            slam(state);
+            slam_manager.finish_slam();
 
-                state.main_hand_weapon.next_swing = from_offset(1000 * state.main_hand_weapon.swing_speed / (1 + state.special_stats.haste));
-                if (state.is_dual_wield)
-                {
-                    state.off_hand_weapon.next_swing = from_offset(1000 * state.off_hand_weapon.swing_speed / (1 + state.special_stats.haste));
-                }
-                oldHaste = state.special_stats.haste; // keep update_swing_timer() from applying haste changes again
+            state.main_hand_weapon.next_swing = from_offset(1000 * state.main_hand_weapon.swing_speed / (1 + state.special_stats.haste));
+            time_keeper_.schedule(Time_keeper::mh_swing_timer, state.main_hand_weapon.next_swing);
+            if (is_dual_wield)
+            {
+                state.off_hand_weapon.next_swing = from_offset(1000 * state.off_hand_weapon.swing_speed / (1 + state.special_stats.haste));
+                time_keeper_.schedule(Time_keeper::oh_swing_timer, state.off_hand_weapon.next_swing);
             }
+            oldHaste = state.special_stats.haste; // keep update_swing_timer() from applying haste changes again
+        }
 
-            bool mh_swing = state.main_hand_weapon.next_swing == time_keeper_.time;
-            bool oh_swing = state.is_dual_wield && state.off_hand_weapon.next_swing == time_keeper_.time;
+        bool mh_swing = state.main_hand_weapon.next_swing == time_keeper_.time;
+        bool oh_swing = is_dual_wield && state.off_hand_weapon.next_swing == time_keeper_.time;
 
-            if (mh_swing)
+        if (mh_swing)
+        {
+            mh_hits++;
+            if (state.rampage_stacks > 0)
             {
-                mh_hits++;
-                if (state.rampage_stacks > 0)
-                {
-                    mh_hits_w_rampage++;
-                }
-                swing_main_hand(state);
+                mh_hits_w_rampage++;
             }
+            swing_main_hand(state);
+        }
 
-            if (oh_swing)
+        if (oh_swing)
+        {
+            oh_hits++;
+            if (ability_queue_manager.is_ability_queued())
             {
-                oh_hits++;
-                if (ability_queue_manager.is_ability_queued())
-                {
-                    oh_hits_w_queued++;
-                }
-                swing_off_hand(state);
+                oh_hits_w_queued++;
             }
+            swing_off_hand(state);
+        }
 
-            if (!in_execute_phase)
+        if (!in_execute_phase)
+        {
+            if (time_keeper_.time > time_execute_phase)
             {
-                if (time_keeper_.time > time_execute_phase)
-                {
-                    logger_.print("------------ Execute phase! ------------");
-                    in_execute_phase = true;
-                }
+                logger_.print("------------ Execute phase! ------------");
+                in_execute_phase = true;
             }
+        }
 
-            if (use_sweeping_strikes_)
+        if (uses<Kernel>(Rotation_kernel::multi_target) && use_sweeping_strikes_)
+        {
+            if (time_keeper_.sweeping_strikes_ready() && time_keeper_.global_ready() && rage >= 30 && number_of_extra_targets_ > 0)
             {
-                if (time_keeper_.sweeping_strikes_ready() && time_keeper_.global_ready() && rage >= 30 && number_of_extra_targets_ > 0)
-                {
-                    logger_.print("Sweeping strikes!");
-                    time_keeper_.global_cast(1500);
-                    spend_rage(30);
-                    time_keeper_.sweeping_strikes_cast(30000);
-                    sweeping_strikes_charges_ = 10;
-                }
+                logger_.print("Sweeping strikes!");
+                time_keeper_.global_cast(1500);
+                spend_rage(30);
+                time_keeper_.sweeping_strikes_cast(30000);
+                sweeping_strikes_charges_ = 10;
             }
+        }
 
-            if (sunder_armor_globals > 0)
+        if (sunder_armor_globals > 0)
+        {
+            if (sunder_armor_stacks_ >= 5 || apply_delayed_armor_reduction)
             {
-                if (sunder_armor_stacks_ >= 5 || apply_delayed_armor_reduction)
-                {
-                    sunder_armor_globals = 0;
-                }
-                else if (time_keeper_.global_ready() && rage >= 15)
-                {
-                    sunder_armor(state);
-                    sunder_armor_globals--;
-                }
+                sunder_armor_globals = 0;
             }
-
-            if (use_rampage_)
+            else if (time_keeper_.global_ready() && rage >= 15)
             {
-                if (time_keeper_.rampage_ready() && state.rampage_stacks > 0)
-                {
-                    state.special_stats -= {0, 0, 50.0 * state.rampage_stacks};
-                    state.rampage_stacks = 0;
-                    logger_.print("Rampage fades.");
-                }
+                sunder_armor(state);
+                sunder_armor_globals--;
             }
+        }
 
-            if (in_execute_phase)
+        if (use_rampage_)
+        {
+            if (time_keeper_.rampage_ready() && state.rampage_stacks > 0)
             {
-                execute_phase(state, mh_swing);
-                if (slam_manager.is_slam_casting()) continue;
-
-                if (config.combat.use_heroic_strike && config.combat.use_hs_in_exec_phase)
+                for (int i = 0; i < state.rampage_stacks; i++)
                 {
-                    queue_next_melee();
+                    state.stats.remove(rampage_stack_, Stat_aggregator::attack_power);
                 }
+                state.rampage_stacks = 0;
+                logger_.print("Rampage fades.");
             }
-            else
-            {
-                normal_phase(state, mh_swing);
-                if (slam_manager.is_slam_casting()) continue;
+        }
 
-                if (config.combat.use_heroic_strike)
-                {
-                    queue_next_melee();
-                }
+        if (in_execute_phase)
+        {
+            execute_phase<Kernel>(state, mh_swing);
+            if (uses<Kernel>(Rotation_kernel::slam) && slam_manager.is_slam_casting()) continue;
+
+            if (config.combat.use_heroic_strike && config.combat.use_hs_in_exec_phase)
+            {
+                queue_next_melee();
             }
+        }
+        else
+        {
+            normal_phase<Kernel>(state, mh_swing);
+            if (uses<Kernel>(Rotation_kernel::slam) && slam_manager.is_slam_casting()) continue;
 
-            // end of turn - update swing timers if necessary
-            update_swing_timers(state, oldHaste);
+            if (config.combat.use_heroic_strike)
+            {
+                queue_next_melee();
+            }
         }
-        // end of batch
 
-        buff_manager_.update_aura_uptimes(sim_time);
+        // end of turn - update swing timers if necessary
+        update_swing_timers(state, oldHaste);
+    }
+    // end of batch
 
-        double dps_sample = state.damage_sources.sum_damage_sources() * 1000 / sim_time;
-        dps_distribution_.add_sample(dps_sample);
+    buff_manager_.update_aura_uptimes(sim_time);
 
-        int num_samples = dps_distribution_.samples();
+    double dps_sample = state.damage_sources.sum_damage_sources() * 1000 / sim_time;
+    dps_distribution_.add_sample(dps_sample);
+    if (config.common_random_numbers) dps_samples_.push_back(dps_sample);
 
-        damage_distribution_ = damage_distribution_ + state.damage_sources;
+    int num_samples = dps_distribution_.samples();
 
-        rampage_uptime_ = Statistics::update_mean(rampage_uptime_, num_samples, double(mh_hits_w_rampage) / mh_hits);
-        if (is_dual_wield)
-        {
-            oh_queued_uptime_ = Statistics::update_mean(oh_queued_uptime_, num_samples, double(oh_hits_w_queued) / oh_hits);
-        }
-        flurry_uptime_ = Statistics::update_mean(flurry_uptime_, num_samples, flurry_uptime / time_keeper_.time);
-        avg_rage_spent_executing_ = Statistics::update_mean(avg_rage_spent_executing_, num_samples, rage_spent_on_execute_);
+    damage_distribution_ += state.damage_sources;
 
-        if (log_data)
-        {
-            add_damage_source_to_time_lapse(state.damage_instances);
-            hist_y[static_cast<int>(dps_sample / histogram_dps_resolution)]++;
-        }
+    rampage_uptime_ = Statistics::update_mean(rampage_uptime_, num_samples, double(mh_hits_w_rampage) / mh_hits);
+    if (is_dual_wield)
+    {
+        oh_queued_uptime_ = Statistics::update_mean(oh_queued_uptime_, num_samples, double(oh_hits_w_queued) / oh_hits);
     }
+    flurry_uptime_ = Statistics::update_mean(flurry_uptime_, num_samples, flurry_uptime / time_keeper_.time);
+    avg_rage_spent_executing_ = Statistics::update_mean(avg_rage_spent_executing_, num_samples, rage_spent_on_execute_);
 
-    for (const auto& he : weapons[0].hit_effects)
+    if (log_data)
+    {
+        dps_histogram_.add_sample(dps_sample);
+    }
+}
+
+void Combat_simulator::finish_batches()
+{
+    for (const auto& he : weapons_[0].hit_effects)
     {
         proc_data_[he.name] += he.procs;
     }
-    if (is_dual_wield)
+    if ((rotation_features_ & Rotation_kernel::dual_wield) != 0)
     {
-        for (const auto& he : weapons[1].hit_effects)
+        for (const auto& he : weapons_[1].hit_effects)
         {
             proc_data_[he.name] += he.procs;
         }
     }
 
-    if (log_data)
-    {
-        normalize_timelapse();
-        prune_histogram();
-    }
+    aura_uptimes_ = buff_manager_.get_aura_uptimes_map();
 }
 
 // about 1/3 of all calls are cut short by the gcd check; a possible rage check is only effective for the execute-phase
+template <unsigned Kernel>
 void Combat_simulator::execute_phase(Sim_state& state, bool mh_swing)
 {
     if (!time_keeper_.global_ready()) return;
@@ -1386,16 +1629,16 @@ void Combat_simulator::execute_phase(Sim_state& state, bool mh_swing)
             spend_rage(20);
             if (state.rampage_stacks == 0)
             {
-                state.special_stats += {0, 0, 50};
+                state.stats.add(rampage_stack_, Stat_aggregator::attack_power);
                 state.rampage_stacks = 1;
             }
             logger_.print("Rampage!");
-            logger_.print("Current rage: ", int(rage));
+            logger_.rage(rage);
             return;
         }
     }
 
-    if (config.combat.use_slam && state.main_hand_weapon.weapon_socket == Weapon_socket::two_hand && config.combat.use_sl_in_exec_phase)
+    if (uses<Kernel>(Rotation_kernel::slam) && config.combat.use_sl_in_exec_phase)
     {
         assert(!slam_manager.is_slam_casting());
         if (rage >= 15)
@@ -1407,7 +1650,7 @@ void Combat_simulator::execute_phase(Sim_state& state, bool mh_swing)
         }
     }
 
-    if (use_mortal_strike_ && config.combat.use_ms_in_exec_phase)
+    if (uses<Kernel>(Rotation_kernel::mortal_strike) && config.combat.use_ms_in_exec_phase)
     {
         bool ms_ww = true;
         if (config.combat.use_whirlwind)
@@ -1421,7 +1664,7 @@ void Combat_simulator::execute_phase(Sim_state& state, bool mh_swing)
         }
     }
 
-    if (use_bloodthirst_ && config.combat.use_bt_in_exec_phase)
+    if (uses<Kernel>(Rotation_kernel::bloodthirst) && config.combat.use_bt_in_exec_phase)
     {
         bool bt_ww = true;
         if (config.combat.use_whirlwind)
@@ -1438,11 +1681,11 @@ void Combat_simulator::execute_phase(Sim_state& state, bool mh_swing)
     if (config.combat.use_whirlwind && config.combat.use_ww_in_exec_phase)
     {
         bool use_ww = true;
-        if (use_bloodthirst_)
+        if (uses<Kernel>(Rotation_kernel::bloodthirst))
         {
             use_ww = std::max(time_keeper_.blood_thirst_cd(), 100) > config.combat.whirlwind_bt_cooldown_thresh;
         }
-        if (use_mortal_strike_)
+        if (uses<Kernel>(Rotation_kernel::mortal_strike))
         {
             use_ww = std::max(time_keeper_.mortal_strike_cd(), 100) > config.combat.whirlwind_bt_cooldown_thresh;
         }
@@ -1460,6 +1703,7 @@ void Combat_simulator::execute_phase(Sim_state& state, bool mh_swing)
     }
 }
 
+template <unsigned Kernel>
 void Combat_simulator::normal_phase(Sim_state& state, bool mh_swing)
 {
     if (!time_keeper_.global_ready()) return;
@@ -1473,16 +1717,16 @@ void Combat_simulator::normal_phase(Sim_state& state, bool mh_swing)
             spend_rage(20);
             if (state.rampage_stacks == 0)
             {
-                state.special_stats += {0, 0, 50};
+                state.stats.add(rampage_stack_, Stat_aggregator::attack_power);
                 state.rampage_stacks = 1;
             }
             logger_.print("Rampage!");
-            logger_.print("Current rage: ", int(rage));
+            logger_.rage(rage);
             return;
         }
     }
 
-    if (config.combat.use_slam && state.main_hand_weapon.weapon_socket == Weapon_socket::two_hand)
+    if (uses<Kernel>(Rotation_kernel::slam))
     {
         assert(!slam_manager.is_slam_casting());
         if (rage >= 15)
@@ -1501,11 +1745,11 @@ void Combat_simulator::normal_phase(Sim_state& state, bool mh_swing)
         {
             use_sa = false;
         }
-        if (use_bloodthirst_)
+        if (uses<Kernel>(Rotation_kernel::bloodthirst))
         {
             use_sa &= time_keeper_.blood_thirst_cd() > config.combat.sunder_armor_cd_thresh;
         }
-        if (use_mortal_strike_)
+        if (uses<Kernel>(Rotation_kernel::mortal_strike))
         {
             use_sa &= time_keeper_.mortal_strike_cd() > config.combat.sunder_armor_cd_thresh;
         }
@@ -1520,7 +1764,7 @@ void Combat_simulator::normal_phase(Sim_state& state, bool mh_swing)
         }
     }
 
-    if (use_bloodthirst_)
+    if (uses<Kernel>(Rotation_kernel::bloodthirst))
     {
         bool bt_ww = true;
         if (config.combat.use_whirlwind)
@@ -1534,7 +1778,7 @@ void Combat_simulator::normal_phase(Sim_state& state, bool mh_swing)
         }
     }
 
-    if (use_mortal_strike_)
+    if (uses<Kernel>(Rotation_kernel::mortal_strike))
     {
         bool ms_ww = true;
         if (config.combat.use_whirlwind)
@@ -1551,11 +1795,11 @@ void Combat_simulator::normal_phase(Sim_state& state, bool mh_swing)
     if (config.combat.use_whirlwind)
     {
         bool use_ww = true;
-        if (use_bloodthirst_)
+        if (uses<Kernel>(Rotation_kernel::bloodthirst))
         {
             use_ww = std::max(time_keeper_.blood_thirst_cd(), 100) > config.combat.whirlwind_bt_cooldown_thresh;
         }
-        if (use_mortal_strike_)
+        if (uses<Kernel>(Rotation_kernel::mortal_strike))
         {
             use_ww = std::max(time_keeper_.mortal_strike_cd(), 100) > config.combat.whirlwind_bt_cooldown_thresh;
         }
@@ -1569,11 +1813,11 @@ void Combat_simulator::normal_phase(Sim_state& state, bool mh_swing)
     if (config.combat.use_overpower)
     {
         bool use_op = true;
-        if (use_bloodthirst_)
+        if (uses<Kernel>(Rotation_kernel::bloodthirst))
         {
             use_op &= time_keeper_.blood_thirst_cd() > config.combat.overpower_bt_cooldown_thresh;
         }
-        if (use_mortal_strike_)
+        if (uses<Kernel>(Rotation_kernel::mortal_strike))
         {
             use_op &= time_keeper_.mortal_strike_cd() > config.combat.overpower_bt_cooldown_thresh;
         }
@@ -1595,11 +1839,11 @@ void Combat_simulator::normal_phase(Sim_state& state, bool mh_swing)
         {
             use_ham = false;
         }
-        if (use_bloodthirst_)
+        if (uses<Kernel>(Rotation_kernel::bloodthirst))
         {
             use_ham &= time_keeper_.blood_thirst_cd() > config.combat.hamstring_cd_thresh;
         }
-        if (use_mortal_strike_)
+        if (uses<Kernel>(Rotation_kernel::mortal_strike))
         {
             use_ham &= time_keeper_.mortal_strike_cd() > config.combat.hamstring_cd_thresh;
         }
@@ -1777,49 +2021,55 @@ Use_effects::Schedule Combat_simulator::compute_use_effects_schedule(const Chara
 
 void Combat_simulator::init_histogram()
 {
-    const int n = 1000;
-    hist_x.reserve(n);
-    for (int i = 0; i < n; i++)
-    {
-        hist_x.push_back(i * histogram_dps_resolution);
-    }
-    hist_y.assign(n, 0);
+    dps_histogram_ = Histogram{histogram_dps_resolution};
 }
 
 void Combat_simulator::normalize_timelapse()
 {
-    for (auto& damage_time_lapse_i : damage_time_lapse_)
-    {
-        for (auto& singe_damage_instance : damage_time_lapse_i)
-        {
-            singe_damage_instance /= config.n_batches;
-        }
-    }
+    time_lapse_.scale(1.0 / config.n_batches);
 }
 
-void Combat_simulator::prune_histogram()
+Sim_result Combat_simulator::get_result() const
 {
-    size_t start_idx = 0;
-    for (; start_idx < hist_x.size(); ++start_idx)
-    {
-        if (hist_y[start_idx] != 0) break;
-    }
+    Sim_result result{dps_distribution_, dps_samples_, damage_distribution_, aura_uptimes_, proc_data_};
+    result.flurry_uptime = flurry_uptime_;
+    result.hs_uptime = oh_queued_uptime_;
+    result.rampage_uptime = rampage_uptime_;
+    result.rage_lost_stance = rage_lost_stance_swap_;
+    result.rage_lost_capped = rage_lost_capped_;
+    result.avg_rage_spent_executing = avg_rage_spent_executing_;
+    if (dps_histogram_.samples() > 0)
+    {
+        result.dps_histogram = dps_histogram_;
+    }
+    result.time_lapse = time_lapse_;
+    return result;
+}
 
-    int end_idx = static_cast<int>(hist_x.size()) - 1;
-    for (; end_idx >= 0; --end_idx)
+std::vector<int> Combat_simulator::get_hist_x(const Histogram& histogram)
+{
+    const auto [first, last] = occupied_buckets(histogram.counts());
+    std::vector<int> hist_x;
+    for (size_t i = first; i < last; ++i)
     {
-        if (hist_y[end_idx] != 0) break;
+        hist_x.push_back(static_cast<int>(i * histogram.bucket_width()));
     }
+    return hist_x;
+}
 
-    hist_x = std::vector<int>(&hist_x[start_idx], &hist_x[end_idx] + 1);
-    hist_y = std::vector<int>(&hist_y[start_idx], &hist_y[end_idx] + 1);
+std::vector<int> Combat_simulator::get_hist_y(const Histogram& histogram)
+{
+    const auto& counts = histogram.counts();
+    const auto [first, last] = occupied_buckets(counts);
+    return {counts.begin() + first, counts.begin() + last};
 }
 
-std::vector<std::string> Combat_simulator::get_aura_uptimes() const
+std::vector<std::string> Combat_simulator::get_aura_uptimes(const Sim_result& result,
+                                                            const Combat_simulator_config& config)
 {
     std::vector<std::string> aura_uptimes;
     double total_sim_time = config.n_batches * config.sim_time;
-    for (const auto& aura : buff_manager_.get_aura_uptimes_map())
+    for (const auto& aura : result.aura_uptimes)
     {
         if (!(filter_aura_from_statistics(aura.first)))
         {
@@ -1827,22 +2077,22 @@ std::vector<std::string> Combat_simulator::get_aura_uptimes() const
             aura_uptimes.emplace_back(aura.first + " " + std::to_string(100 * uptime));    
         }        
     }
-    if (flurry_uptime_ != 0.0)
+    if (result.flurry_uptime != 0.0)
     {
-        aura_uptimes.emplace_back("Flurry " + std::to_string(100 * flurry_uptime_));
+        aura_uptimes.emplace_back("Flurry " + std::to_string(100 * result.flurry_uptime));
     }
-    if (oh_queued_uptime_ != 0.0)
+    if (result.hs_uptime != 0.0)
     {
-        aura_uptimes.emplace_back("'Heroic_strike_bug' " + std::to_string(100 * oh_queued_uptime_));
+        aura_uptimes.emplace_back("'Heroic_strike_bug' " + std::to_string(100 * result.hs_uptime));
     }
-    if (rampage_uptime_ != 0.0)
+    if (result.rampage_uptime != 0.0)
     {
-        aura_uptimes.emplace_back("Rampage " + std::to_string(100 * rampage_uptime_));
+        aura_uptimes.emplace_back("Rampage " + std::to_string(100 * result.rampage_uptime));
     }
     return aura_uptimes;
 }
 
-bool Combat_simulator::filter_aura_from_statistics(std::string aura_name) const
+bool Combat_simulator::filter_aura_from_statistics(const std::string& aura_name)
 {
     if (aura_name == "blackened_naaru_sliver_active")
     {
@@ -1851,10 +2101,11 @@ bool Combat_simulator::filter_aura_from_statistics(std::string aura_name) const
     return false;           
 }
 
-std::vector<std::string> Combat_simulator::get_proc_statistics() const
+std::vector<std::string> Combat_simulator::get_proc_statistics(const Sim_result& result,
+                                                               const Combat_simulator_config& config)
 {
     std::vector<std::string> proc_counter;
-    for (const auto& proc : proc_data_)
+    for (const auto& proc : result.proc_data)
     {
         if (!(filter_proc_from_statistics(proc.first)))
         {
@@ -1865,7 +2116,7 @@ std::vector<std::string> Combat_simulator::get_proc_statistics() const
     return proc_counter;
 }
 
-bool Combat_simulator::filter_proc_from_statistics(std::string proc_name) const
+bool Combat_simulator::filter_proc_from_statistics(const std::string& proc_name)
 {
     if (proc_name == "blackened_naaru_sliver_active")
     {
@@ -1880,20 +2131,7 @@ bool Combat_simulator::filter_proc_from_statistics(std::string proc_name) const
 
 void Combat_simulator::reset_time_lapse()
 {
-    const auto sim_time = to_millis(config.sim_time);
-    std::vector<double> history(static_cast<size_t>(sim_time / time_lapse_resolution + 1));
-    damage_time_lapse_.assign(static_cast<size_t>(Damage_source::size), history);
-}
-
-void Combat_simulator::add_damage_source_to_time_lapse(const std::vector<Damage_instance>& damage_instances)
-{
-    for (const auto& damage_instance : damage_instances)
-    {
-        auto first_idx = static_cast<int>(damage_instance.damage_source);
-        auto second_idx = static_cast<int>(damage_instance.time_stamp / time_lapse_resolution);
-        assert(second_idx >= 0 && second_idx < static_cast<int>(damage_time_lapse_[first_idx].size()));
-        damage_time_lapse_[first_idx][second_idx] += damage_instance.damage;
-    }
+    time_lapse_.reset(to_millis(config.sim_time), to_millis(config.time_lapse_resolution));
 }
 
 std::string Combat_simulator::get_debug_topic() const
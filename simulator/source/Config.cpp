@@ -8,7 +8,8 @@ Combat_simulator_config::Combat_simulator_config(const Sim_input& input)
     n_batches = static_cast<int>(
         String_helpers::find_value(input.float_options_string, input.float_options_val, "n_simulations_dd"));
     if (String_helpers::find_string(input.options, "item_strengths") ||
-        String_helpers::find_string(input.options, "wep_strengths") || !input.stat_weights.empty() ||
+        String_helpers::find_string(input.options, "wep_strengths") ||
+        String_helpers::find_string(input.options, "gear_optimizer") || !input.stat_weights.empty() ||
         String_helpers::find_string(input.options, "compute_dpr"))
     {
         if (n_batches < 100000)
@@ -19,4 +20,5 @@ Combat_simulator_config::Combat_simulator_config(const Sim_input& input)
         }
     }
     seed = 110000;
+    common_random_numbers = true;
 }
@@ -0,0 +1,492 @@
+#include "Result_cache.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+namespace
+{
+constexpr uint64_t fnv_offset_basis = 0xcbf29ce484222325;
+constexpr uint64_t fnv_prime = 0x100000001b3;
+
+// tells result files apart from anything else in the directory, and from files of an older layout
+constexpr uint64_t file_magic = 0x32736572'6d697377; // "wsimres2"
+
+// talents are ints only, so their bytes are a canonical encoding
+static_assert(std::has_unique_object_representations_v<Character::talents_t>);
+
+template <typename T>
+void add_enum(Sim_hash& hash, T value)
+{
+    hash.add(static_cast<int64_t>(value));
+}
+
+void add_stats(Sim_hash& hash, const Attributes& attributes)
+{
+    hash.add(attributes.strength).add(attributes.agility);
+}
+
+void add_stats(Sim_hash& hash, const Special_stats& s)
+{
+    hash.add(s.critical_strike).add(s.hit).add(s.attack_power).add(s.bonus_attack_power).add(s.haste);
+    hash.add(s.damage_mod_physical).add(s.stat_multiplier).add(s.bonus_damage).add(s.crit_multiplier);
+    hash.add(s.spell_crit).add(s.damage_mod_spell).add(s.expertise).add(s.sword_expertise).add(s.mace_expertise);
+    hash.add(s.axe_expertise).add(s.gear_armor_pen).add(s.ap_multiplier).add(s.attack_speed);
+}
+
+// the definition of the effect, not its state during a run
+void add_effect(Sim_hash& hash, const Hit_effect& effect)
+{
+    hash.add(effect.name);
+    add_enum(hash, effect.type);
+    add_stats(hash, effect.attribute_boost);
+    add_stats(hash, effect.special_stats_boost);
+    hash.add(effect.damage).add(effect.duration).add(effect.cooldown).add(effect.probability);
+    hash.add(static_cast<int64_t>(effect.proc_type)).add(effect.max_charges).add(effect.armor_reduction);
+    hash.add(effect.ppm).add(effect.affects_both_weapons).add(effect.max_stacks);
+}
+
+void add_effect(Sim_hash& hash, const Over_time_effect& effect)
+{
+    hash.add(effect.name);
+    add_stats(hash, effect.special_stats);
+    hash.add(effect.rage_gain).add(effect.damage).add(effect.interval).add(effect.duration);
+}
+
+void add_effect(Sim_hash& hash, const Use_effect& effect)
+{
+    hash.add(effect.name);
+    add_enum(hash, effect.effect_socket);
+    hash.add(effect.rage_boost).add(effect.duration).add(effect.cooldown).add(effect.triggers_gcd);
+    hash.add(static_cast<int64_t>(effect.hit_effects.size()));
+    for (const auto& e : effect.hit_effects) add_effect(hash, e);
+    hash.add(static_cast<int64_t>(effect.over_time_effects.size()));
+    for (const auto& e : effect.over_time_effects) add_effect(hash, e);
+    add_effect(hash, effect.combat_buff);
+}
+
+template <typename T>
+void add_effects(Sim_hash& hash, const std::vector<T>& effects)
+{
+    hash.add(static_cast<int64_t>(effects.size()));
+    for (const auto& effect : effects) add_effect(hash, effect);
+}
+
+void add_item(Sim_hash& hash, const Armor& armor)
+{
+    hash.add(armor.name);
+    add_enum(hash, armor.socket);
+    add_enum(hash, armor.enchant.type);
+}
+
+void add_item(Sim_hash& hash, const Weapon& weapon)
+{
+    hash.add(weapon.name);
+    add_stats(hash, weapon.attributes);
+    add_stats(hash, weapon.special_stats);
+    hash.add(weapon.swing_speed).add(weapon.min_damage).add(weapon.max_damage);
+    add_enum(hash, weapon.weapon_socket);
+    add_enum(hash, weapon.type);
+    add_effects(hash, weapon.hit_effects);
+    add_enum(hash, weapon.set_name);
+    add_effects(hash, weapon.use_effects);
+    add_enum(hash, weapon.socket);
+    add_enum(hash, weapon.enchant.type);
+    hash.add(weapon.buff.name);
+}
+
+template <typename T>
+void write_value(std::ofstream& file, const T& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool read_value(std::ifstream& file, T& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+template <typename T>
+void write_vector(std::ofstream& file, const std::vector<T>& values)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    write_value(file, static_cast<uint64_t>(values.size()));
+    file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+template <typename T>
+bool read_vector(std::ifstream& file, std::vector<T>& values)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    uint64_t size{};
+    if (!read_value(file, size) || size > (1u << 30)) return false;
+    values.resize(size);
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(size * sizeof(T))));
+}
+
+void write_string(std::ofstream& file, const std::string& value)
+{
+    write_value(file, static_cast<uint64_t>(value.size()));
+    file.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+bool read_string(std::ifstream& file, std::string& value)
+{
+    uint64_t size{};
+    if (!read_value(file, size) || size > (1u << 16)) return false;
+    value.resize(size);
+    return static_cast<bool>(file.read(value.data(), static_cast<std::streamsize>(size)));
+}
+
+template <typename T>
+void write_map(std::ofstream& file, const std::unordered_map<std::string, T>& map)
+{
+    write_value(file, static_cast<uint64_t>(map.size()));
+    for (const auto& entry : map)
+    {
+        write_string(file, entry.first);
+        write_value(file, entry.second);
+    }
+}
+
+template <typename T>
+bool read_map(std::ifstream& file, std::unordered_map<std::string, T>& map)
+{
+    uint64_t size{};
+    if (!read_value(file, size) || size > (1u << 16)) return false;
+    for (uint64_t i = 0; i < size; ++i)
+    {
+        std::string key;
+        T value{};
+        if (!read_string(file, key) || !read_value(file, value)) return false;
+        map.emplace(std::move(key), value);
+    }
+    return true;
+}
+
+// a rough estimate of the memory an entry takes
+size_t size_of(const Sim_result& result)
+{
+    const size_t histogram_size = result.dps_histogram ? result.dps_histogram->counts().size() * sizeof(int) : 0;
+    return sizeof(Sim_result) + result.dps_samples.size() * sizeof(double) +
+           (result.aura_uptimes.size() + result.proc_data.size()) * 64 + histogram_size +
+           result.time_lapse.data().size() * sizeof(double);
+}
+} // namespace
+
+Sim_hash::Sim_hash() : hash_(fnv_offset_basis)
+{
+    add(static_cast<int64_t>(source_hash));
+}
+
+void Sim_hash::add_bytes(const void* data, size_t size)
+{
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash_ = (hash_ ^ bytes[i]) * fnv_prime;
+    }
+}
+
+Sim_hash& Sim_hash::add(int64_t value)
+{
+    add_bytes(&value, sizeof(value));
+    return *this;
+}
+
+Sim_hash& Sim_hash::add(double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    add_bytes(&bits, sizeof(bits));
+    return *this;
+}
+
+Sim_hash& Sim_hash::add(const std::string& value)
+{
+    add(static_cast<int64_t>(value.size()));
+    add_bytes(value.data(), value.size());
+    return *this;
+}
+
+Sim_hash& Sim_hash::add(const std::vector<double>& values)
+{
+    add(static_cast<int64_t>(values.size()));
+    for (const auto value : values) add(value);
+    return *this;
+}
+
+Sim_hash& Sim_hash::add(const StoppingRule& rule)
+{
+    return add(rule.parameters());
+}
+
+Sim_hash& Sim_hash::add(const Combat_simulator_config& config)
+{
+    add(config.n_batches).add(config.n_threads).add(config.stopping_rule).add(config.display_combat_debug);
+    add(config.seed).add(config.common_random_numbers).add(config.generic_rotation_kernel);
+    add(config.sim_time).add(config.time_lapse_resolution);
+    add(config.main_target_level).add(config.main_target_initial_armor_);
+    add(config.n_sunder_armor_stacks).add(config.exposed_armor).add(config.curse_of_recklessness_active);
+    add(config.faerie_fire_feral_active);
+    add(config.multi_target_mode_).add(config.number_of_extra_targets).add(config.extra_target_percentage);
+    add(config.extra_target_initial_armor_);
+    add(config.take_periodic_damage_).add(config.periodic_damage_amount_).add(config.periodic_damage_interval_);
+    add(config.essence_of_the_red_);
+    add(config.execute_phase_percentage_).add(config.initial_rage).add(config.sunder_armor_globals_);
+    add(config.solarians_sapphire_preshout).add(config.t2_set_preshout);
+    add(config.enable_bloodrage).add(config.enable_recklessness).add(config.enable_blood_fury);
+    add(config.enable_berserking).add(config.berserking_haste_).add(config.use_death_wish);
+    add(config.use_sweeping_strikes).add(config.enable_extra_bloodlust).add(config.extra_bloodlust_count_);
+    add(config.reverse_cooldown).add(config.enable_unleashed_rage).add(config.unleashed_rage_start_);
+    add(config.deep_wounds);
+
+    const auto& c = config.combat;
+    add(c.use_bloodthirst).add(c.use_bt_in_exec_phase).add(c.bt_whirlwind_cooldown_thresh);
+    add(c.use_mortal_strike).add(c.use_ms_in_exec_phase).add(c.ms_whirlwind_cooldown_thresh);
+    add(c.use_whirlwind).add(c.use_ww_in_exec_phase).add(c.whirlwind_rage_thresh).add(c.whirlwind_bt_cooldown_thresh);
+    add(c.use_slam).add(c.use_sl_in_exec_phase).add(c.slam_rage_thresh).add(c.slam_spam_max_time);
+    add(c.slam_spam_rage).add(c.slam_latency);
+    add(c.use_rampage).add(c.use_ra_in_exec_phase).add(c.rampage_use_thresh);
+    add(c.use_heroic_strike).add(c.use_hs_in_exec_phase).add(c.first_hit_heroic_strike);
+    add(c.heroic_strike_rage_thresh);
+    add(c.cleave_if_adds).add(c.cleave_rage_thresh);
+    add(c.use_overpower).add(c.overpower_rage_thresh).add(c.overpower_bt_cooldown_thresh);
+    add(c.overpower_ww_cooldown_thresh);
+    add(c.use_hamstring).add(c.hamstring_rage_thresh).add(c.hamstring_cd_thresh).add(c.dont_use_hm_when_ss);
+    add(c.use_sunder_armor).add(c.sunder_armor_rage_thresh).add(c.sunder_armor_cd_thresh);
+
+    const auto& d = config.dpr_settings;
+    add(d.compute_dpr_sl_).add(d.compute_dpr_ms_).add(d.compute_dpr_bt_).add(d.compute_dpr_op_);
+    add(d.compute_dpr_ww_).add(d.compute_dpr_ex_).add(d.compute_dpr_ha_).add(d.compute_dpr_hs_);
+    add(d.compute_dpr_cl_);
+    return *this;
+}
+
+Sim_hash& Sim_hash::add(const Character& character)
+{
+    add_enum(*this, character.race);
+    add(character.level);
+    add_bytes(&character.talents, sizeof(character.talents));
+
+    add_stats(*this, character.total_attributes);
+    add_stats(*this, character.total_special_stats);
+
+    add(static_cast<int64_t>(character.armor.size()));
+    for (const auto& armor : character.armor) add_item(*this, armor);
+    add(static_cast<int64_t>(character.weapons.size()));
+    for (const auto& weapon : character.weapons) add_item(*this, weapon);
+    add(static_cast<int64_t>(character.gems.size()));
+    for (const auto& gem : character.gems) add(gem.name);
+    add(static_cast<int64_t>(character.set_bonuses.size()));
+    for (const auto& set_bonus : character.set_bonuses)
+    {
+        add_enum(*this, set_bonus.set);
+        add(set_bonus.pieces);
+    }
+    add(static_cast<int64_t>(character.buffs.size()));
+    for (const auto& buff : character.buffs) add(buff.name);
+    add_effects(*this, character.use_effects);
+    return *this;
+}
+
+Result_cache::Result_cache(size_t capacity_bytes, std::string directory)
+    : capacity_bytes_(capacity_bytes), directory_(std::move(directory))
+{
+}
+
+Result_cache& Result_cache::shared()
+{
+    static Result_cache cache{size_t{64} << 20};
+    return cache;
+}
+
+std::shared_ptr<const Sim_result> Result_cache::find(uint64_t key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end())
+    {
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return it->second->result;
+    }
+    if (directory_.empty()) return nullptr;
+
+    auto result = read(key);
+    if (result) insert_in_memory(key, result);
+    return result;
+}
+
+std::shared_ptr<const Sim_result> Result_cache::insert(uint64_t key, Sim_result result)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!directory_.empty()) write(key, result);
+    auto shared_result = std::make_shared<const Sim_result>(std::move(result));
+    insert_in_memory(key, shared_result);
+    return shared_result;
+}
+
+void Result_cache::set_capacity(size_t capacity_bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_bytes_ = capacity_bytes;
+    insert_in_memory(0, nullptr);
+}
+
+void Result_cache::set_directory(std::string directory)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    directory_ = std::move(directory);
+}
+
+void Result_cache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+    size_bytes_ = 0;
+}
+
+// without a result this only evicts down to the capacity
+void Result_cache::insert_in_memory(uint64_t key, std::shared_ptr<const Sim_result> result)
+{
+    if (result)
+    {
+        auto it = index_.find(key);
+        if (it != index_.end())
+        {
+            size_bytes_ -= it->second->size;
+            entries_.erase(it->second);
+            index_.erase(it);
+        }
+        const auto size = size_of(*result);
+        entries_.push_front({key, std::move(result), size});
+        index_[key] = entries_.begin();
+        size_bytes_ += size;
+    }
+    while (size_bytes_ > capacity_bytes_ && !entries_.empty())
+    {
+        size_bytes_ -= entries_.back().size;
+        index_.erase(entries_.back().key);
+        entries_.pop_back();
+    }
+}
+
+std::string Result_cache::file_name(uint64_t key) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.simres", static_cast<unsigned long long>(key));
+    return directory_ + "/" + name;
+}
+
+std::shared_ptr<const Sim_result> Result_cache::read(uint64_t key) const
+{
+    std::ifstream file(file_name(key), std::ios::binary);
+    if (!file) return nullptr;
+
+    uint64_t magic{};
+    uint64_t file_key{};
+    if (!read_value(file, magic) || magic != file_magic || !read_value(file, file_key) || file_key != key)
+    {
+        return nullptr;
+    }
+
+    auto result = std::make_shared<Sim_result>();
+    int n_samples{};
+    double mean{};
+    double m2{};
+    double last_sample{};
+    if (!read_value(file, n_samples) || !read_value(file, mean) || !read_value(file, m2) ||
+        !read_value(file, last_sample) || !read_vector(file, result->dps_samples))
+    {
+        return nullptr;
+    }
+    result->dps = Distribution{n_samples, mean, m2, last_sample};
+    if (!read_value(file, result->damage_sources) || !read_map(file, result->aura_uptimes) ||
+        !read_map(file, result->proc_data))
+    {
+        return nullptr;
+    }
+
+    if (!read_value(file, result->flurry_uptime) || !read_value(file, result->hs_uptime) ||
+        !read_value(file, result->rampage_uptime) || !read_value(file, result->rage_lost_stance) ||
+        !read_value(file, result->rage_lost_capped) || !read_value(file, result->avg_rage_spent_executing))
+    {
+        return nullptr;
+    }
+
+    uint8_t has_histogram{};
+    if (!read_value(file, has_histogram)) return nullptr;
+    if (has_histogram)
+    {
+        double bucket_width{};
+        std::vector<int> counts;
+        int n_histogram_samples{};
+        double min{};
+        double max{};
+        if (!read_value(file, bucket_width) || !(bucket_width > 0) || !read_vector(file, counts) || counts.size() < 2 ||
+            !read_value(file, n_histogram_samples) || !read_value(file, min) || !read_value(file, max))
+        {
+            return nullptr;
+        }
+        result->dps_histogram.emplace(bucket_width, std::move(counts), n_histogram_samples, min, max);
+    }
+
+    int resolution{};
+    std::vector<double> time_lapse;
+    if (!read_value(file, resolution) || !read_vector(file, time_lapse) ||
+        time_lapse.size() % Damage_sources::n_sources != 0)
+    {
+        return nullptr;
+    }
+    result->time_lapse = Time_lapse{resolution, std::move(time_lapse)};
+    return result;
+}
+
+// written to a temporary file first, so a reader (of another process) never sees a partial result
+void Result_cache::write(uint64_t key, const Sim_result& result) const
+{
+    const auto name = file_name(key);
+    const auto temporary_name = name + ".tmp";
+    {
+        std::ofstream file(temporary_name, std::ios::binary | std::ios::trunc);
+        if (!file) return;
+
+        write_value(file, file_magic);
+        write_value(file, key);
+        write_value(file, result.dps.samples());
+        write_value(file, result.dps.mean());
+        write_value(file, result.dps.m2());
+        write_value(file, result.dps.last_sample());
+        write_vector(file, result.dps_samples);
+        write_value(file, result.damage_sources);
+        write_map(file, result.aura_uptimes);
+        write_map(file, result.proc_data);
+
+        write_value(file, result.flurry_uptime);
+        write_value(file, result.hs_uptime);
+        write_value(file, result.rampage_uptime);
+        write_value(file, result.rage_lost_stance);
+        write_value(file, result.rage_lost_capped);
+        write_value(file, result.avg_rage_spent_executing);
+
+        write_value(file, static_cast<uint8_t>(result.dps_histogram.has_value()));
+        if (result.dps_histogram)
+        {
+            write_value(file, result.dps_histogram->bucket_width());
+            write_vector(file, result.dps_histogram->counts());
+            write_value(file, result.dps_histogram->samples());
+            write_value(file, result.dps_histogram->min());
+            write_value(file, result.dps_histogram->max());
+        }
+
+        write_value(file, result.time_lapse.resolution());
+        write_vector(file, result.time_lapse.data());
+        if (!file) return;
+    }
+    std::rename(temporary_name.c_str(), name.c_str());
+}
@@ -0,0 +1,108 @@
+#include "logger.hpp"
+
+#include "string_helpers.hpp"
+
+namespace
+{
+const char* hit_source_name(Trace_event::Hit_source source)
+{
+    switch (source)
+    {
+    case Trace_event::Hit_source::main_hand:
+        return "Mainhand";
+    case Trace_event::Hit_source::off_hand:
+        return "Offhand";
+    case Trace_event::Hit_source::main_hand_ability:
+        return "Ability";
+    case Trace_event::Hit_source::off_hand_ability:
+        return "Offhand ability";
+    }
+    return "";
+}
+
+std::string format_hit(const Trace_event& event)
+{
+    const bool white = event.source == Trace_event::Hit_source::main_hand || event.source == Trace_event::Hit_source::off_hand;
+    const std::string source = hit_source_name(event.source);
+    const std::string damage = std::to_string(int(event.value)) + " damage.";
+    switch (event.hit_result)
+    {
+    case Hit_result::glancing:
+        return white ? source + " glancing hit for: " + damage : "BUG: " + source + " glanced for: " + damage;
+    case Hit_result::hit:
+        return source + (white ? " white hit for: " : " hit for: ") + damage;
+    case Hit_result::crit:
+        return source + " crit for: " + damage;
+    case Hit_result::dodge:
+        return source + (white ? " hit dodged" : " dodged");
+    case Hit_result::miss:
+        return source + (white ? " hit missed" : " missed");
+    case Hit_result::TBD:
+        // Should never happen
+        return "BUUUUUUUUUUGGGGGGGGG";
+    }
+    return "";
+}
+} // namespace
+
+void Logger::push_arg(const std::string& t)
+{
+    auto it = name_ids_.find(t);
+    if (it == name_ids_.end())
+    {
+        it = name_ids_.emplace(t, static_cast<uint32_t>(names_.size())).first;
+        names_.push_back(t);
+    }
+    Trace_arg arg{Trace_arg::Type::name, {}};
+    arg.name = it->second;
+    args_.push_back(arg);
+}
+
+std::string Logger::format_event(const Trace_event& event, const std::vector<Trace_arg>& args,
+                                 const std::vector<std::string>& names)
+{
+    std::string line = "Time: " + String_helpers::string_with_precision(event.time * 0.001, 3) + "s. ";
+    switch (event.kind)
+    {
+    case Trace_event::Kind::hit:
+        line += format_hit(event);
+        break;
+    case Trace_event::Kind::rage:
+        line += "Current rage: " + std::to_string(int(event.value));
+        break;
+    case Trace_event::Kind::message:
+        for (uint32_t i = event.first_arg; i < event.first_arg + event.n_args; ++i)
+        {
+            const auto& arg = args[i];
+            switch (arg.type)
+            {
+            case Trace_arg::Type::text:
+                line += arg.text;
+                break;
+            case Trace_arg::Type::name:
+                line += names[arg.name];
+                break;
+            case Trace_arg::Type::integer:
+                line += std::to_string(arg.integer);
+                break;
+            case Trace_arg::Type::real:
+                line += String_helpers::string_with_precision(arg.real, 3);
+                break;
+            }
+        }
+        break;
+    }
+    return line;
+}
+
+std::string Logger::get_debug_topic() const
+{
+    std::string debug_topic;
+    debug_topic.reserve(64 * events_.size());
+    for (const auto& event : events_)
+    {
+        debug_topic += format_event(event, args_, names_);
+        debug_topic += "<br>";
+    }
+    return debug_topic;
+}
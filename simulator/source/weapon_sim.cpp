@@ -22,3 +22,27 @@ Weapon_sim::Weapon_sim(const Weapon& weapon) :
         normalized_swing_speed = 2.4;
     }
 }
+
+void Weapon_sim::update_procs(const Weapon_sim* other_weapon)
+{
+    for (int i = static_cast<int>(procs.size()); i < static_cast<int>(hit_effects.size()); ++i)
+    {
+        const auto& hit_effect = hit_effects[i];
+
+        int linked = -1;
+        if (other_weapon)
+        {
+            for (size_t j = 0; j < other_weapon->hit_effects.size(); ++j)
+            {
+                if (other_weapon->hit_effects[j].name == hit_effect.name)
+                {
+                    linked = static_cast<int>(j);
+                    break;
+                }
+            }
+        }
+
+        auto probability = hit_effect.ppm > 0 ? hit_effect.ppm * swing_speed / 60 : hit_effect.probability;
+        procs.push_back({i, linked, probability, hit_effect.proc_type, hit_effect.name == "darkmoon_card_wrath", hit_effect.type});
+    }
+}
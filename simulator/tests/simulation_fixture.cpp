@@ -33,11 +33,21 @@ public:
     {
         config = get_config_with_everything_deactivated();
 
+        // results of earlier tests would answer the static entry points
+        Result_cache::shared().clear();
+
         auto wep = Weapon{"test_wep", {}, {}, 2.0, 100, 100, Weapon_socket::one_hand, Weapon_type::axe};
         character.equip_weapon(wep, wep);
 
-        Armory armory{};
-        armory.compute_total_stats(character);
+        Armory::shared().compute_total_stats(character);
+    }
+
+    // a run past Result_cache::shared(), the reference for what the static entry points return
+    static Sim_result run_uncached(const Combat_simulator_config& config, const Character& character)
+    {
+        Combat_simulator sim(config);
+        sim.simulate(character, false);
+        return sim.get_result();
     }
 
     void TearDown() override
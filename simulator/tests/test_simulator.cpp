@@ -1,10 +1,15 @@
 #include "Armory.hpp"
 #include "BinomialDistribution.hpp"
 #include "Combat_simulator.hpp"
+#include "Item_optimizer.hpp"
+#include "event_calendar.hpp"
+#include "stat_aggregator.hpp"
 #include "Statistics.hpp"
 #include "simulation_fixture.cpp"
+#include "task_pool.hpp"
 
 #include <chrono>
+#include <numeric>
 
 TEST_F(Sim_fixture, test_no_crit_equals_no_flurry_uptime)
 {
@@ -71,7 +76,37 @@ TEST_F(Sim_fixture, test_bloodthirst_count)
 
     auto distrib = sim.get_damage_distribution();
 
-    EXPECT_NEAR(distrib.bloodthirst_count, config.sim_time / 6.0 * config.n_batches, 1.0);
+    EXPECT_NEAR(distrib.count_of(Damage_source::bloodthirst), config.sim_time / 6.0 * config.n_batches, 1.0);
+}
+
+TEST_F(Sim_fixture, test_damage_sources_hit_results)
+{
+    character.talents.bloodthirst = 1;
+    config.combat.use_bloodthirst = true;
+    character.total_special_stats.critical_strike = 30;
+
+    Combat_simulator sim(config);
+    sim.simulate(character);
+
+    const auto& distrib = sim.get_damage_distribution();
+
+    // every white swing and bloodthirst rolls on the hit table, deep wounds ticks don't
+    for (const auto source : {Damage_source::white_mh, Damage_source::white_oh, Damage_source::bloodthirst})
+    {
+        EXPECT_GT(distrib.count_of(source), 0);
+        EXPECT_EQ(distrib.rolled_count_of(source), distrib.count_of(source));
+        EXPECT_GT(distrib.count_of(source, Hit_result::crit), 0);
+    }
+    EXPECT_GT(distrib.count_of(Damage_source::white_mh, Hit_result::glancing), 0);
+    EXPECT_EQ(distrib.count_of(Damage_source::bloodthirst, Hit_result::glancing), 0);
+    EXPECT_EQ(distrib.rolled_count_of(Damage_source::deep_wounds), 0);
+
+    Damage_sources twice = distrib;
+    twice += distrib;
+    EXPECT_DOUBLE_EQ(twice.sum_damage_sources(), 2 * distrib.sum_damage_sources());
+    EXPECT_EQ(twice.sum_counts(), 2 * distrib.sum_counts());
+    EXPECT_EQ(twice.count_of(Damage_source::white_mh, Hit_result::crit),
+              2 * distrib.count_of(Damage_source::white_mh, Hit_result::crit));
 }
 
 TEST_F(Sim_fixture, test_that_with_infinite_rage_all_hits_are_heroic_strike)
@@ -94,7 +129,7 @@ TEST_F(Sim_fixture, test_that_with_infinite_rage_all_hits_are_heroic_strike)
     auto hs_uptime = sim.get_hs_uptime();
     double expected_swings_per_simulation = (config.sim_time - 1.0) / character.weapons[0].swing_speed + 1;
     double tolerance = 1.0 / character.weapons[0].swing_speed;
-    EXPECT_NEAR(distrib.heroic_strike_count / double(config.n_batches), expected_swings_per_simulation, tolerance);
+    EXPECT_NEAR(distrib.count_of(Damage_source::heroic_strike) / double(config.n_batches), expected_swings_per_simulation, tolerance);
 
     EXPECT_FLOAT_EQ(hs_uptime, 1);
 }
@@ -164,8 +199,8 @@ TEST_F(Sim_fixture, test_hit_effects_extra_hit)
     // OH proc's trigger main hand swings
     expected_swings_mh += expected_procs_mh + expected_procs_oh;
 
-    EXPECT_NEAR(sources.white_mh_count, expected_swings_mh, 0.01 * expected_swings_mh);
-    EXPECT_NEAR(sources.white_oh_count, expected_swings_oh, 0.01 * expected_swings_oh);
+    EXPECT_NEAR(sources.count_of(Damage_source::white_mh), expected_swings_mh, 0.01 * expected_swings_mh);
+    EXPECT_NEAR(sources.count_of(Damage_source::white_oh), expected_swings_oh, 0.01 * expected_swings_oh);
 
     EXPECT_NEAR(proc_data["test_wep_mh"], expected_procs_mh, conf_interval_mh / 2);
     EXPECT_NEAR(proc_data["test_wep_oh"], expected_procs_oh, conf_interval_oh / 2);
@@ -211,8 +246,8 @@ TEST_F(Sim_fixture, test_hit_effects_icd)
     // OH proc's trigger main hand swings
     expected_swings_mh += expected_procs_mh + expected_procs_oh;
 
-    EXPECT_NEAR(sources.white_mh_count, expected_swings_mh, 0.01 * expected_swings_mh);
-    EXPECT_NEAR(sources.white_oh_count, expected_swings_oh, 0.01 * expected_swings_oh);
+    EXPECT_NEAR(sources.count_of(Damage_source::white_mh), expected_swings_mh, 0.01 * expected_swings_mh);
+    EXPECT_NEAR(sources.count_of(Damage_source::white_oh), expected_swings_oh, 0.01 * expected_swings_oh);
 
     EXPECT_NEAR(proc_data["test_wep_mh"], expected_procs_mh, conf_interval_mh / 2);
     EXPECT_NEAR(proc_data["test_wep_oh"], expected_procs_oh, conf_interval_oh / 2);
@@ -261,8 +296,8 @@ TEST_F(Sim_fixture, test_hit_effects_windfury_hit)
     // OH proc's trigger main hand swings
     expected_swings_mh += expected_procs_mh + expected_procs_oh;
 
-    EXPECT_NEAR(sources.white_mh_count, expected_swings_mh, 0.01 * expected_swings_mh);
-    EXPECT_NEAR(sources.white_oh_count, expected_swings_oh, 0.01 * expected_swings_oh);
+    EXPECT_NEAR(sources.count_of(Damage_source::white_mh), expected_swings_mh, 0.01 * expected_swings_mh);
+    EXPECT_NEAR(sources.count_of(Damage_source::white_oh), expected_swings_oh, 0.01 * expected_swings_oh);
 
     EXPECT_NEAR(proc_data["test_wep_mh"], expected_procs_mh, conf_interval_mh / 2);
     EXPECT_NEAR(proc_data["test_wep_oh"], expected_procs_oh, conf_interval_oh / 2);
@@ -307,8 +342,8 @@ TEST_F(Sim_fixture, test_hit_effects_sword_spec)
     // OH proc's trigger main hand swings
     expected_swings_mh += expected_procs_mh + expected_procs_oh;
 
-    EXPECT_NEAR(sources.white_mh_count, expected_swings_mh, 0.01 * expected_swings_mh);
-    EXPECT_NEAR(sources.white_oh_count, expected_swings_oh, 0.01 * expected_swings_oh);
+    EXPECT_NEAR(sources.count_of(Damage_source::white_mh), expected_swings_mh, 0.01 * expected_swings_mh);
+    EXPECT_NEAR(sources.count_of(Damage_source::white_oh), expected_swings_oh, 0.01 * expected_swings_oh);
 
     EXPECT_NEAR(proc_data["test_wep_mh"], expected_procs_mh, conf_interval_mh / 2);
     EXPECT_NEAR(proc_data["test_wep_oh"], expected_procs_oh, conf_interval_oh / 2);
@@ -354,10 +389,10 @@ TEST_F(Sim_fixture, test_hit_effects_physical_damage)
     expected_procs_mh += second_order_procs;
 
     double expected_total_procs = expected_procs_oh + expected_procs_mh;
-    EXPECT_NEAR(sources.white_mh_count, expected_swings_mh, 0.01 * expected_swings_mh);
-    EXPECT_NEAR(sources.white_oh_count, expected_swings_oh, 0.01 * expected_swings_oh);
+    EXPECT_NEAR(sources.count_of(Damage_source::white_mh), expected_swings_mh, 0.01 * expected_swings_mh);
+    EXPECT_NEAR(sources.count_of(Damage_source::white_oh), expected_swings_oh, 0.01 * expected_swings_oh);
 
-    EXPECT_NEAR(sources.item_hit_effects_count, expected_total_procs, 0.03 * expected_total_procs);
+    EXPECT_NEAR(sources.count_of(Damage_source::item_hit_effects), expected_total_procs, 0.03 * expected_total_procs);
 
     EXPECT_NEAR(proc_data["test_wep_mh"], expected_procs_mh, 0.03 * expected_procs_mh);
     EXPECT_NEAR(proc_data["test_wep_oh"], expected_procs_oh, 0.03 * expected_procs_oh);
@@ -400,10 +435,10 @@ TEST_F(Sim_fixture, test_hit_effects_magic_damage)
     double conf_interval_mh = bin_dist_mh.confidence_interval_width(0.99);
 
     double expected_total_procs = expected_procs_oh + expected_procs_mh;
-    EXPECT_NEAR(sources.white_mh_count, expected_swings_mh, 0.01 * expected_swings_mh);
-    EXPECT_NEAR(sources.white_oh_count, expected_swings_oh, 0.01 * expected_swings_oh);
+    EXPECT_NEAR(sources.count_of(Damage_source::white_mh), expected_swings_mh, 0.01 * expected_swings_mh);
+    EXPECT_NEAR(sources.count_of(Damage_source::white_oh), expected_swings_oh, 0.01 * expected_swings_oh);
 
-    EXPECT_NEAR(sources.item_hit_effects_count, expected_total_procs, 0.03 * expected_total_procs);
+    EXPECT_NEAR(sources.count_of(Damage_source::item_hit_effects), expected_total_procs, 0.03 * expected_total_procs);
 
     EXPECT_NEAR(proc_data["test_wep_mh"], expected_procs_mh, conf_interval_mh / 2);
     EXPECT_NEAR(proc_data["test_wep_oh"], expected_procs_oh, conf_interval_oh / 2);
@@ -439,10 +474,10 @@ TEST_F(Sim_fixture, test_hit_effects_stat_boost_short_duration)
     double dodge_chance = 6.5 / 100.0;
     double hit_chance = (1 - miss_chance - dodge_chance);
 
-    double expected_procs_oh = hit_chance * sources.white_oh_count * oh_proc_prob;
+    double expected_procs_oh = hit_chance * sources.count_of(Damage_source::white_oh) * oh_proc_prob;
     double expected_uptime_oh = expected_procs_oh * oh_proc_duration;
 
-    double expected_procs_mh = hit_chance * sources.white_mh_count * mh_proc_prob;
+    double expected_procs_mh = hit_chance * sources.count_of(Damage_source::white_mh) * mh_proc_prob;
     double expected_uptime_mh = expected_procs_mh * mh_proc_duration;
 
     EXPECT_NEAR(proc_data["test_wep_mh"], expected_procs_mh, 0.03 * expected_procs_mh);
@@ -484,14 +519,14 @@ TEST_F(Sim_fixture, test_hit_effects_stat_boost_long_duration)
     double dodge_chance = 6.5 / 100.0;
     double hit_chance = (1 - miss_chance - dodge_chance);
 
-    double expected_procs_oh = hit_chance * sources.white_oh_count * oh_proc_prob;
+    double expected_procs_oh = hit_chance * sources.count_of(Damage_source::white_oh) * oh_proc_prob;
     double expected_uptime_oh = expected_procs_oh * oh_proc_duration;
     double swings_during_uptime_oh = oh_proc_duration / character.weapons[1].swing_speed;
     double procs_during_uptime_oh = hit_chance * swings_during_uptime_oh * oh_proc_prob;
     double expected_procs_during_uptime_oh = expected_procs_oh * procs_during_uptime_oh;
     double overlap_duration_oh = expected_procs_during_uptime_oh * oh_proc_duration / 2;
 
-    double expected_procs_mh = hit_chance * sources.white_mh_count * mh_proc_prob;
+    double expected_procs_mh = hit_chance * sources.count_of(Damage_source::white_mh) * mh_proc_prob;
     double expected_uptime_mh = expected_procs_mh * mh_proc_duration;
     double swings_during_uptime_mh = mh_proc_duration / character.weapons[0].swing_speed;
     double procs_during_uptime_mh = hit_chance * swings_during_uptime_mh * mh_proc_prob;
@@ -566,8 +601,8 @@ TEST_F(Sim_fixture, test_deep_wounds)
 
     auto damage_sources = sim.get_damage_distribution();
 
-    EXPECT_GT(damage_sources.deep_wounds_count, 0);
-    EXPECT_NEAR(damage_sources.deep_wounds_damage / damage_sources.deep_wounds_count, dwTick, 0.01);
+    EXPECT_GT(damage_sources.count_of(Damage_source::deep_wounds), 0);
+    EXPECT_NEAR(damage_sources.damage_of(Damage_source::deep_wounds) / damage_sources.count_of(Damage_source::deep_wounds), dwTick, 0.01);
 }
 
 TEST_F(Sim_fixture, test_flurry_uptime)
@@ -600,8 +635,553 @@ TEST_F(Sim_fixture, test_flurry_uptime)
 
     auto dd = sim.get_damage_distribution();
 
-    EXPECT_NEAR(dd.white_oh_count / (config.sim_time / oh.swing_speed * haste), (1 - flurryUptime) + flurryUptime * flurryHaste, 0.0001);
-    EXPECT_NEAR((dd.white_mh_count + dd.heroic_strike_count) / (config.sim_time / mh.swing_speed * haste), (1 - flurryUptime) + flurryUptime * flurryHaste, 0.0001);
+    EXPECT_NEAR(dd.count_of(Damage_source::white_oh) / (config.sim_time / oh.swing_speed * haste), (1 - flurryUptime) + flurryUptime * flurryHaste, 0.0001);
+    EXPECT_NEAR((dd.count_of(Damage_source::white_mh) + dd.count_of(Damage_source::heroic_strike)) / (config.sim_time / mh.swing_speed * haste), (1 - flurryUptime) + flurryUptime * flurryHaste, 0.0001);
+}
+
+TEST_F(Sim_fixture, test_parallel_matches_sequential)
+{
+    config.sim_time = 120.0;
+    config.n_batches = 2000;
+
+    Hit_effect test_effect{"test_proc", Hit_effect::Type::stat_boost, {}, {10, 0, 100}, 0, 10, 0, 0.1};
+    character.weapons[0].hit_effects.push_back(test_effect);
+    character.talents.flurry = 5;
+    character.total_special_stats.critical_strike = 25;
+
+    Combat_simulator sequential(config);
+    sequential.simulate(character, true);
+
+    config.n_threads = 4;
+    Combat_simulator parallel(config);
+    parallel.simulate(character, true);
+
+    const auto& d_seq = sequential.get_dps_distribution();
+    const auto& d_par = parallel.get_dps_distribution();
+    EXPECT_EQ(d_par.samples(), config.n_batches);
+    double std_diff = std::sqrt(d_seq.var_of_the_mean() + d_par.var_of_the_mean());
+    EXPECT_NEAR(d_par.mean(), d_seq.mean(), 4 * std_diff);
+    EXPECT_NEAR(d_par.std(), d_seq.std(), 0.1 * d_seq.std());
+
+    EXPECT_NEAR(parallel.get_damage_distribution().count_of(Damage_source::white_mh),
+                sequential.get_damage_distribution().count_of(Damage_source::white_mh),
+                0.01 * sequential.get_damage_distribution().count_of(Damage_source::white_mh));
+    EXPECT_NEAR(parallel.get_flurry_uptime(), sequential.get_flurry_uptime(), 0.02);
+
+    auto procs_seq = sequential.get_proc_data().at("test_proc");
+    auto procs_par = parallel.get_proc_data().at("test_proc");
+    EXPECT_NEAR(procs_par, procs_seq, 0.05 * procs_seq);
+
+    auto uptime_seq = sequential.get_aura_uptimes_map().at("test_proc");
+    auto uptime_par = parallel.get_aura_uptimes_map().at("test_proc");
+    EXPECT_NEAR(uptime_par, uptime_seq, 0.05 * uptime_seq);
+
+    const auto& hist_y = parallel.get_hist_y();
+    EXPECT_EQ(std::accumulate(hist_y.begin(), hist_y.end(), 0), config.n_batches);
+
+    double time_lapse_total = 0;
+    for (size_t i = 0; i < Damage_sources::n_sources; i++)
+    {
+        time_lapse_total += parallel.get_damage_time_lapse().total(static_cast<Damage_source>(i));
+    }
+    EXPECT_NEAR(time_lapse_total, d_par.mean() * config.sim_time, 1e-6 * time_lapse_total);
+}
+
+TEST_F(Sim_fixture, test_time_lapse_resolution)
+{
+    config.sim_time = 60;
+    config.n_batches = 100;
+    config.time_lapse_resolution = 2;
+
+    Combat_simulator sim(config);
+    sim.simulate(character, true);
+
+    const auto& time_lapse = sim.get_damage_time_lapse();
+    EXPECT_EQ(time_lapse.resolution(), 2000);
+    EXPECT_EQ(time_lapse.n_buckets(), 31u);
+
+    const auto white_mh = time_lapse.series(Damage_source::white_mh);
+    ASSERT_EQ(white_mh.size(), 31u);
+    EXPECT_NEAR(std::accumulate(white_mh.begin(), white_mh.end(), 0.0),
+                sim.get_damage_distribution().damage_of(Damage_source::white_mh) / config.n_batches, 1e-6);
+    EXPECT_GT(white_mh[0], 0.0);
+}
+
+TEST_F(Sim_fixture, test_seed_reproducibility)
+{
+    config.n_batches = 200;
+
+    Combat_simulator sim1(config);
+    sim1.simulate(character);
+    Combat_simulator sim2(config);
+    sim2.simulate(character);
+    EXPECT_EQ(sim1.get_dps_distribution().mean(), sim2.get_dps_distribution().mean());
+
+    config.seed += 1;
+    Combat_simulator sim3(config);
+    sim3.simulate(character);
+    EXPECT_NE(sim1.get_dps_distribution().mean(), sim3.get_dps_distribution().mean());
+
+    config.n_threads = 3;
+    Combat_simulator parallel1(config);
+    parallel1.simulate(character);
+    Combat_simulator parallel2(config);
+    parallel2.simulate(character);
+    EXPECT_EQ(parallel1.get_dps_distribution().mean(), parallel2.get_dps_distribution().mean());
+    EXPECT_EQ(parallel1.get_dps_distribution().variance(), parallel2.get_dps_distribution().variance());
+}
+
+TEST_F(Sim_fixture, test_hit_aura_blackened_naaru_sliver)
+{
+    config.sim_time = 100;
+    config.n_batches = 50;
+
+    character.weapons[0].hit_effects.push_back(
+        {"blackened_naaru_sliver", Hit_effect::Type::blackened_naaru_sliver, {}, {}, 0, 20, 45, 1});
+
+    Combat_simulator sim(config);
+    sim.simulate(character);
+
+    // the aura enables a hit effect on both weapons, whose procs add stacks until the aura fades
+    const auto& procs = sim.get_proc_data();
+    EXPECT_GT(procs.at("blackened_naaru_sliver"), 0);
+    EXPECT_GT(procs.at("blackened_naaru_sliver_active"), procs.at("blackened_naaru_sliver"));
+
+    const auto& uptimes = sim.get_aura_uptimes_map();
+    EXPECT_GT(uptimes.at("blackened_naaru_sliver_active"), 0.0);
+    EXPECT_GT(uptimes.at("blackened_naaru_sliver_stacks"), 0.0);
+}
+
+TEST_F(Sim_fixture, test_common_random_numbers)
+{
+    config.n_batches = 500;
+    config.common_random_numbers = true;
+
+    Combat_simulator base(config);
+    base.simulate(character);
+    ASSERT_EQ(base.get_dps_samples().size(), 500);
+
+    // the iteration seeds don't depend on how the batches are split among threads
+    config.n_threads = 3;
+    Combat_simulator parallel(config);
+    parallel.simulate(character);
+    EXPECT_EQ(parallel.get_dps_samples(), base.get_dps_samples());
+
+    config.n_threads = 1;
+    character.total_special_stats.attack_power += 100;
+    Combat_simulator plus_ap(config);
+    plus_ap.simulate(character);
+
+    Distribution diff{};
+    for (size_t i = 0; i < base.get_dps_samples().size(); ++i)
+    {
+        diff.add_sample(plus_ap.get_dps_samples()[i] - base.get_dps_samples()[i]);
+    }
+    const auto& d0 = base.get_dps_distribution();
+    const auto& d1 = plus_ap.get_dps_distribution();
+    EXPECT_NEAR(diff.mean(), d1.mean() - d0.mean(), 1e-6);
+    EXPECT_GT(diff.mean(), 0.0);
+    EXPECT_LT(diff.std_of_the_mean(), 0.5 * std::sqrt(d0.var_of_the_mean() + d1.var_of_the_mean()));
+}
+
+TEST_F(Sim_fixture, test_stopping_rule)
+{
+    config.n_batches = 100000;
+    config.stopping_rule.with_precision(0.5).with_min_samples(100);
+
+    Combat_simulator sim(config);
+    sim.simulate(character);
+    const auto& dps = sim.get_dps_distribution();
+    EXPECT_GT(dps.samples(), 100);
+    EXPECT_LT(dps.samples(), config.n_batches);
+    EXPECT_LE(1.96 * dps.std_of_the_mean(), 0.501);
+
+    // the workers share the precision
+    config.n_threads = 2;
+    Combat_simulator parallel(config);
+    parallel.simulate(character);
+    const auto& parallel_dps = parallel.get_dps_distribution();
+    EXPECT_LT(parallel_dps.samples(), config.n_batches);
+    EXPECT_LE(1.96 * parallel_dps.std_of_the_mean(), 0.55);
+}
+
+TEST_F(Sim_fixture, test_simulate_characters)
+{
+    config.n_batches = 500;
+    config.common_random_numbers = true;
+
+    std::vector<Character> characters(3, character);
+    characters[1].total_special_stats.attack_power += 100;
+    characters[2].total_special_stats.critical_strike += 10;
+
+    Task_pool pool{2};
+    const auto distributions = Combat_simulator::simulate(config, characters, pool);
+    ASSERT_EQ(distributions.size(), characters.size());
+
+    // same as one character at a time
+    config.n_threads = 1;
+    for (size_t i = 0; i < characters.size(); ++i)
+    {
+        const auto dps = run_uncached(config, characters[i]).dps;
+        EXPECT_EQ(distributions[i].samples(), 500);
+        EXPECT_DOUBLE_EQ(distributions[i].mean(), dps.mean());
+    }
+    EXPECT_GT(distributions[1].mean(), distributions[0].mean());
+    EXPECT_GT(distributions[2].mean(), distributions[0].mean());
+}
+
+TEST_F(Sim_fixture, test_simulate_ablations)
+{
+    config.n_batches = 300;
+    config.common_random_numbers = true;
+    character.talents.bloodthirst = 1;
+    config.combat.use_bloodthirst = true;
+    config.combat.use_whirlwind = true;
+
+    std::vector<Combat_simulator_config::dpr_t> ablations(2);
+    ablations[0].compute_dpr_bt_ = true;
+    ablations[1].compute_dpr_ww_ = true;
+    const auto dps_lost = Combat_simulator::simulate_ablations(config, character, ablations);
+    ASSERT_EQ(dps_lost.size(), ablations.size());
+
+    // same as separate runs with the same random numbers
+    const auto dps = run_uncached(config, character).dps;
+    for (size_t i = 0; i < ablations.size(); ++i)
+    {
+        auto ablated_config = config;
+        ablated_config.dpr_settings = ablations[i];
+        const auto ablated_dps = run_uncached(ablated_config, character).dps;
+        EXPECT_EQ(dps_lost[i].samples(), 300);
+        EXPECT_NEAR(dps_lost[i].mean(), dps.mean() - ablated_dps.mean(), 1e-6);
+        EXPECT_GT(dps_lost[i].mean(), 0);
+    }
+}
+
+TEST_F(Sim_fixture, test_simulate_race)
+{
+    config.n_batches = 2000;
+    config.common_random_numbers = true;
+    const auto base_samples = Combat_simulator::simulate_result(config, character)->dps_samples;
+
+    std::vector<Character> candidates(3, character);
+    candidates[0].total_special_stats.attack_power += 300;
+    candidates[1].total_special_stats.attack_power -= 300;
+    candidates[2].total_special_stats.attack_power += 250;
+    // upgrades take all iterations unless they are behind
+    const auto rule = StoppingRule{2000, 200}.with_sign_test(0.999, 0, 2000);
+    const auto diffs = Combat_simulator::simulate_race(config, candidates, base_samples, rule);
+    ASSERT_EQ(diffs.size(), candidates.size());
+
+    // the iterations of separate runs with the same random numbers
+    int n_iterations = 0;
+    for (size_t i = 0; i < candidates.size(); ++i)
+    {
+        const auto samples = run_uncached(config, candidates[i]).dps_samples;
+        Distribution diff{};
+        for (int j = 0; j < diffs[i].samples(); ++j)
+        {
+            diff.add_sample(samples[j] - base_samples[j]);
+        }
+        EXPECT_NEAR(diffs[i].mean(), diff.mean(), 1e-6);
+        n_iterations += diffs[i].samples();
+    }
+    EXPECT_GT(diffs[0].mean(), diffs[2].mean());
+    EXPECT_GT(diffs[2].mean(), 0);
+    EXPECT_LT(diffs[1].mean(), 0);
+    EXPECT_EQ(diffs[0].samples(), config.n_batches);
+    EXPECT_LT(diffs[1].samples(), config.n_batches);
+    EXPECT_LT(diffs[2].samples(), config.n_batches);
+    EXPECT_LT(n_iterations, 2 * config.n_batches);
+}
+
+TEST_F(Sim_fixture, test_result_cache)
+{
+    config.n_batches = 200;
+    config.common_random_numbers = true;
+
+    // only identical inputs share a key (simulate_result adds whether the run logs data)
+    const auto key = Sim_hash{}.add(config).add(character).add(false).value();
+    EXPECT_EQ(Sim_hash{}.add(Combat_simulator_config{config}).add(Character{character}).add(false).value(), key);
+    auto other_config = config;
+    other_config.combat.use_whirlwind = !config.combat.use_whirlwind;
+    EXPECT_NE(Sim_hash{}.add(other_config).add(character).value(), key);
+    auto other_character = character;
+    other_character.total_special_stats.attack_power += 1;
+    EXPECT_NE(Sim_hash{}.add(config).add(other_character).value(), key);
+
+    // a repeated run is a lookup
+    Result_cache::shared().clear();
+    const auto result = Combat_simulator::simulate_result(config, character);
+    EXPECT_EQ(result->dps_samples.size(), 200u);
+    EXPECT_EQ(Result_cache::shared().find(key), result);
+    EXPECT_EQ(Combat_simulator::simulate_result(config, character), result);
+    EXPECT_FALSE(result->dps_histogram);
+
+    // a run which logs data (the main run of Sim_interface) is kept apart, with the histogram and the time lapse
+    const auto logged = Combat_simulator::simulate_result(config, character, true);
+    EXPECT_NE(logged, result);
+    EXPECT_EQ(Combat_simulator::simulate_result(config, character, true), logged);
+    ASSERT_TRUE(logged->dps_histogram);
+    EXPECT_EQ(logged->dps_histogram->samples(), 200);
+    EXPECT_GT(logged->time_lapse.n_buckets(), 0u);
+    EXPECT_EQ(logged->dps.mean(), result->dps.mean());
+
+    // the least recently used result is dropped
+    Result_cache cache{3 * sizeof(Sim_result)};
+    for (uint64_t k = 1; k <= 3; ++k) cache.insert(k, {});
+    EXPECT_TRUE(cache.find(1));
+    cache.insert(4, {});
+    EXPECT_TRUE(cache.find(1));
+    EXPECT_FALSE(cache.find(2));
+    EXPECT_TRUE(cache.find(4));
+
+    // results on disk outlive the cache which wrote them
+    const auto directory = testing::TempDir();
+    Result_cache{0, directory}.insert(key, *result);
+    const auto read = Result_cache{0, directory}.find(key);
+    ASSERT_TRUE(read);
+    EXPECT_EQ(read->dps.samples(), result->dps.samples());
+    EXPECT_EQ(read->dps.mean(), result->dps.mean());
+    EXPECT_EQ(read->dps.m2(), result->dps.m2());
+    EXPECT_EQ(read->dps_samples, result->dps_samples);
+    EXPECT_EQ(read->damage_sources.damage, result->damage_sources.damage);
+    EXPECT_EQ(read->damage_sources.hit_results, result->damage_sources.hit_results);
+    EXPECT_EQ(read->aura_uptimes, result->aura_uptimes);
+    EXPECT_EQ(read->proc_data, result->proc_data);
+    EXPECT_FALSE(read->dps_histogram);
+
+    const auto logged_key = Sim_hash{}.add(config).add(character).add(true).value();
+    Result_cache{0, directory}.insert(logged_key, *logged);
+    const auto read_logged = Result_cache{0, directory}.find(logged_key);
+    ASSERT_TRUE(read_logged);
+    EXPECT_EQ(read_logged->flurry_uptime, logged->flurry_uptime);
+    EXPECT_EQ(read_logged->rage_lost_capped, logged->rage_lost_capped);
+    EXPECT_EQ(read_logged->avg_rage_spent_executing, logged->avg_rage_spent_executing);
+    ASSERT_TRUE(read_logged->dps_histogram);
+    EXPECT_EQ(read_logged->dps_histogram->counts(), logged->dps_histogram->counts());
+    EXPECT_EQ(read_logged->dps_histogram->quantile(0.5), logged->dps_histogram->quantile(0.5));
+    EXPECT_EQ(read_logged->time_lapse.resolution(), logged->time_lapse.resolution());
+    EXPECT_EQ(read_logged->time_lapse.data(), logged->time_lapse.data());
+
+    for (const auto k : {key, logged_key})
+    {
+        std::ostringstream file_name;
+        file_name << directory << "/" << std::hex << std::setw(16) << std::setfill('0') << k << ".simres";
+        EXPECT_EQ(std::remove(file_name.str().c_str()), 0);
+    }
+}
+
+TEST_F(Sim_fixture, test_optimize_gear)
+{
+    config.n_batches = 50;
+
+    const auto& armory = Armory::shared();
+    for (auto socket : {Socket::head, Socket::ring, Socket::ring, Socket::trinket, Socket::trinket})
+    {
+        character.equip_armor(Armor::empty(socket));
+    }
+    armory.compute_total_stats(character);
+
+    // few enough items to try every setup
+    const std::vector<std::string> heads{"mask_of_the_deceiver", "cowl_of_beastly_rage", "warbringer_battle-helm"};
+    const std::vector<std::string> rings{"ring_of_reciprocity", "ring_of_a_thousand_marks", "mithril_band_of_the_unscarred",
+                                         "garonas_signet_ring"};
+    const std::vector<std::string> trinkets{"dragonspine_trophy", "bloodlust_brooch", "hourglass_of_the_unraveller"};
+    const std::vector<std::string> weapons{"spiteblade", "blinkstrike", "black_planar_edge", "gladiators_hacker"};
+    auto is_candidate = [](const std::vector<std::string>& names, const std::string& name) {
+        return std::find(names.begin(), names.end(), name) != names.end();
+    };
+    auto armor_filter = [&](const Armor& a) {
+        return !is_candidate(heads, a.name) && !is_candidate(rings, a.name) && !is_candidate(trinkets, a.name);
+    };
+    auto weapon_filter = [&](const Weapon& w) { return !is_candidate(weapons, w.name); };
+
+    Task_pool pool{2};
+    std::string debug_message;
+    const auto setups =
+        Item_optimizer::optimize_gear(armory, character, config, pool, 3, 100, debug_message, armor_filter, weapon_filter);
+    ASSERT_EQ(setups.size(), 3u);
+    EXPECT_GE(setups[0].dps.mean(), setups[1].dps.mean());
+    EXPECT_GE(setups[1].dps.mean(), setups[2].dps.mean());
+
+    std::vector<double> estimates{};
+    for (const auto& head : heads)
+    {
+        for (size_t r1 = 0; r1 < rings.size(); ++r1)
+        {
+            for (size_t r2 = r1 + 1; r2 < rings.size(); ++r2)
+            {
+                for (size_t t1 = 0; t1 < trinkets.size(); ++t1)
+                {
+                    for (size_t t2 = t1 + 1; t2 < trinkets.size(); ++t2)
+                    {
+                        for (const auto& mh : weapons)
+                        {
+                            for (const auto& oh : weapons)
+                            {
+                                auto c = character;
+                                Armory::change_armor(c.armor, armory.find_armor(Socket::head, head));
+                                Armory::change_armor(c.armor, armory.find_armor(Socket::ring, rings[r1]), true);
+                                Armory::change_armor(c.armor, armory.find_armor(Socket::ring, rings[r2]), false);
+                                Armory::change_armor(c.armor, armory.find_armor(Socket::trinket, trinkets[t1]), true);
+                                Armory::change_armor(c.armor, armory.find_armor(Socket::trinket, trinkets[t2]), false);
+                                Armory::change_weapon(c.weapons, armory.find_weapon(Weapon_socket::main_hand, mh), Socket::main_hand);
+                                Armory::change_weapon(c.weapons, armory.find_weapon(Weapon_socket::off_hand, oh), Socket::off_hand);
+                                armory.compute_total_stats(c);
+                                estimates.push_back(get_character_ap_equivalent(c.total_special_stats, c.weapons[0],
+                                                                                c.weapons[1], config.sim_time, c.use_effects));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // the pruned search finds the same best estimates as trying every setup
+    std::sort(estimates.begin(), estimates.end(), std::greater<>());
+    std::vector<double> found{};
+    for (const auto& setup : setups)
+    {
+        found.push_back(setup.ap_equivalent);
+    }
+    std::sort(found.begin(), found.end(), std::greater<>());
+    for (size_t i = 0; i < found.size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(found[i], estimates[i]);
+    }
+}
+
+TEST_F(Sim_fixture, test_combat_log_trace)
+{
+    config.n_batches = 1;
+    config.sim_time = 20;
+    config.display_combat_debug = true;
+
+    Combat_simulator sim(config);
+    sim.simulate(character);
+
+    const auto& log = sim.get_combat_log();
+    const auto& events = log.events();
+    ASSERT_FALSE(events.empty());
+
+    int n_hits = 0;
+    int n_rage = 0;
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        if (i > 0)
+        {
+            EXPECT_GE(events[i].time, events[i - 1].time);
+        }
+        n_hits += events[i].kind == Trace_event::Kind::hit;
+        n_rage += events[i].kind == Trace_event::Kind::rage;
+    }
+    EXPECT_GT(n_hits, 0);
+
+    // the html is only built on request, one line per event
+    const auto topic = sim.get_debug_topic();
+    size_t n_lines = 0;
+    for (size_t pos = topic.find("<br>"); pos != std::string::npos; pos = topic.find("<br>", pos + 1)) ++n_lines;
+    EXPECT_EQ(n_lines, events.size());
+    EXPECT_EQ(topic.rfind("Time: 0.000s. ", 0), 0);
+    EXPECT_NE(topic.find("Mainhand white hit for: "), std::string::npos);
+    if (n_rage > 0)
+    {
+        EXPECT_NE(topic.find("Current rage: "), std::string::npos);
+    }
+}
+
+TEST(Random_generator, test_uniform_and_streams)
+{
+    Random_generator rng{110000};
+    Random_generator rng_stream{110000, 1};
+
+    Distribution d{};
+    int n_equal = 0;
+    for (int i = 0; i < 100000; ++i)
+    {
+        double u = rng.uniform();
+        ASSERT_GE(u, 0.0);
+        ASSERT_LT(u, 1.0);
+        d.add_sample(u);
+        n_equal += u == rng_stream.uniform();
+    }
+    EXPECT_NEAR(d.mean(), 0.5, 0.005);
+    EXPECT_NEAR(d.variance(), 1.0 / 12, 0.001);
+    EXPECT_EQ(n_equal, 0);
+}
+
+TEST(Random_generator, test_stream_matches_generator_substreams)
+{
+    Random_stream stream{110000, 2};
+    Random_generator lane0{110000, 2 * Random_stream::n_lanes};
+    Random_generator lane1{110000, 2 * Random_stream::n_lanes + 1};
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(stream.uniform(), lane0.uniform());
+        EXPECT_EQ(stream.uniform(), lane1.uniform());
+        stream.uniform();
+        stream.uniform();
+    }
+}
+
+/*
+>> results on master (10^8 draws, counting draws below 0.5):
+scalar: took 235 ms
+block:  took 187 ms (WOW_SIMULATOR_NATIVE=ON, AVX2)
+block:  took 311 ms (default flags, plain loop over the lanes)
+*/
+TEST(Random_generator, benchmark_block_vs_scalar)
+{
+    constexpr int n = 100000000;
+
+    Random_generator generator{110000};
+    int n_below_scalar = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)
+    {
+        n_below_scalar += generator.uniform() < 0.5;
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "scalar: took " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms" << std::endl;
+
+    Random_stream stream{110000};
+    int n_below_block = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)
+    {
+        n_below_block += stream.uniform() < 0.5;
+    }
+    end = std::chrono::steady_clock::now();
+    std::cout << "block:  took " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms" << std::endl;
+
+    EXPECT_NEAR(n_below_scalar, n / 2, n / 1000);
+    EXPECT_NEAR(n_below_block, n / 2, n / 1000);
+}
+
+TEST(Event_calendar, test_next_after)
+{
+    Event_calendar<> calendar{};
+    EXPECT_EQ(calendar.next_after(0), Event_calendar<>::never);
+
+    const int swing = calendar.add_timer();
+    const int buff = calendar.add_timer();
+    calendar.schedule(swing, 2000);
+    calendar.schedule(buff, 1500);
+    EXPECT_EQ(calendar.next_after(0), 1500);
+
+    // due timers are skipped, the scan only looks ahead
+    EXPECT_EQ(calendar.next_after(1500), 2000);
+
+    calendar.cancel(swing);
+    EXPECT_EQ(calendar.next_after(1500), Event_calendar<>::never);
+
+    Event_calendar<std::array<int, 2>> fixed{};
+    fixed.schedule(1, 10);
+    EXPECT_EQ(fixed.next_after(-1), 10);
+    fixed.clear();
+    EXPECT_EQ(fixed.next_after(-1), Event_calendar<>::never);
 }
 
 void time_simulate(Combat_simulator& sim, const Character& character)
@@ -624,18 +1204,18 @@ void print_results(const std::string name, const Combat_simulator& sim, bool pri
     auto g = 60 * f;
 
     std::cout << std::fixed << std::setprecision(2);
-    std::cout << "white (mh)    = " << f * dd.white_mh_damage << " (" << g * dd.white_mh_count << "x)" << std::endl;
-    if (dd.white_oh_count > 0) std::cout << "white (oh)    = " << f * dd.white_oh_damage << " (" << g * dd.white_oh_count << "x)" << std::endl;
-    if (dd.mortal_strike_count > 0) std::cout << "mortal strike = " << f * dd.mortal_strike_damage << " (" << g * dd.mortal_strike_count << "x)" << std::endl;
-    if (dd.cleave_count > 0) std::cout << "cleave        = " << f * dd.cleave_damage << " (" << g * dd.cleave_count << "x)" << std::endl;
-    if (dd.bloodthirst_count > 0) std::cout << "bloodthirst   = " << f * dd.bloodthirst_damage << " (" << g * dd.bloodthirst_count << "x)" << std::endl;
-    if (dd.whirlwind_count > 0) std::cout << "whirlwind     = " << f * dd.whirlwind_damage << " (" << g * dd.whirlwind_count << "x)" << std::endl;
-    if (dd.slam_count > 0) std::cout << "slam          = " << f * dd.slam_damage << " (" << g * dd.slam_count << "x)" << std::endl;
-    if (dd.heroic_strike_count > 0) std::cout << "heroic strike = " << f * dd.heroic_strike_damage << " (" << g * dd.heroic_strike_count << "x)" << std::endl;
-    if (dd.execute_count > 0) std::cout << "execute       = " << f * dd.execute_damage << " (" << g * dd.execute_count << "x)" << std::endl;
-    if (dd.deep_wounds_count > 0) std::cout << "deep wounds   = " << f * dd.deep_wounds_damage << " (" << g * dd.deep_wounds_count << "x)" << std::endl;
-    if (dd.overpower_count > 0) std::cout << "overpower     = " << f * dd.overpower_damage << " (" << g * dd.overpower_count << "x)" << std::endl;
-    if (dd.item_hit_effects_count > 0) std::cout << "hit effects   = " << f * dd.item_hit_effects_damage << " (" << g * dd.item_hit_effects_count << "x)" << std::endl;
+    std::cout << "white (mh)    = " << f * dd.damage_of(Damage_source::white_mh) << " (" << g * dd.count_of(Damage_source::white_mh) << "x)" << std::endl;
+    if (dd.count_of(Damage_source::white_oh) > 0) std::cout << "white (oh)    = " << f * dd.damage_of(Damage_source::white_oh) << " (" << g * dd.count_of(Damage_source::white_oh) << "x)" << std::endl;
+    if (dd.count_of(Damage_source::mortal_strike) > 0) std::cout << "mortal strike = " << f * dd.damage_of(Damage_source::mortal_strike) << " (" << g * dd.count_of(Damage_source::mortal_strike) << "x)" << std::endl;
+    if (dd.count_of(Damage_source::cleave) > 0) std::cout << "cleave        = " << f * dd.damage_of(Damage_source::cleave) << " (" << g * dd.count_of(Damage_source::cleave) << "x)" << std::endl;
+    if (dd.count_of(Damage_source::bloodthirst) > 0) std::cout << "bloodthirst   = " << f * dd.damage_of(Damage_source::bloodthirst) << " (" << g * dd.count_of(Damage_source::bloodthirst) << "x)" << std::endl;
+    if (dd.count_of(Damage_source::whirlwind) > 0) std::cout << "whirlwind     = " << f * dd.damage_of(Damage_source::whirlwind) << " (" << g * dd.count_of(Damage_source::whirlwind) << "x)" << std::endl;
+    if (dd.count_of(Damage_source::slam) > 0) std::cout << "slam          = " << f * dd.damage_of(Damage_source::slam) << " (" << g * dd.count_of(Damage_source::slam) << "x)" << std::endl;
+    if (dd.count_of(Damage_source::heroic_strike) > 0) std::cout << "heroic strike = " << f * dd.damage_of(Damage_source::heroic_strike) << " (" << g * dd.count_of(Damage_source::heroic_strike) << "x)" << std::endl;
+    if (dd.count_of(Damage_source::execute) > 0) std::cout << "execute       = " << f * dd.damage_of(Damage_source::execute) << " (" << g * dd.count_of(Damage_source::execute) << "x)" << std::endl;
+    if (dd.count_of(Damage_source::deep_wounds) > 0) std::cout << "deep wounds   = " << f * dd.damage_of(Damage_source::deep_wounds) << " (" << g * dd.count_of(Damage_source::deep_wounds) << "x)" << std::endl;
+    if (dd.count_of(Damage_source::overpower) > 0) std::cout << "overpower     = " << f * dd.damage_of(Damage_source::overpower) << " (" << g * dd.count_of(Damage_source::overpower) << "x)" << std::endl;
+    if (dd.count_of(Damage_source::item_hit_effects) > 0) std::cout << "hit effects   = " << f * dd.damage_of(Damage_source::item_hit_effects) << " (" << g * dd.count_of(Damage_source::item_hit_effects) << "x)" << std::endl;
     std::cout << "----------------------" << std::endl;
     std::cout << "total         = " << f * dd.sum_damage_sources() << std::endl;
     std::cout << std::endl;
@@ -669,6 +1249,62 @@ total         = 761.00
 >> results on cleanup:
 took 1953 ms
 */
+TEST(Stat_aggregator, test_matches_special_stats)
+{
+    Special_stats start{25, 6, 3000};
+    start.haste = 0.1;
+    start.ap_multiplier = 0.1;
+    start.damage_mod_physical = 0.04;
+
+    Special_stats ap_buff{0, 0, 278};
+    Special_stats ap_multiplier_buff{};
+    ap_multiplier_buff.ap_multiplier = 0.1;
+    Special_stats flurry{};
+    flurry.attack_speed = 0.25;
+    Special_stats haste_buff{};
+    haste_buff.haste = 0.2;
+    Special_stats crit_buff{3, 0, 0};
+    crit_buff.damage_mod_physical = 0.02;
+
+    Stat_aggregator stats{start};
+    EXPECT_EQ(stats.take_changed(), Stat_aggregator::all_fields);
+
+    stats.add(ap_buff);
+    stats.add(ap_multiplier_buff);
+    stats.add(flurry);
+    stats.add(haste_buff);
+    stats.add(crit_buff);
+    const auto changed = stats.take_changed();
+    EXPECT_EQ(changed & Stat_aggregator::hit, 0u);
+    EXPECT_NE(changed & Stat_aggregator::haste, 0u);
+    EXPECT_NE(changed & Stat_aggregator::attack_power, 0u);
+    EXPECT_NE(changed & Stat_aggregator::hit_table_fields, 0u);
+
+    const auto expected = start + ap_buff + ap_multiplier_buff + flurry + haste_buff + crit_buff;
+    EXPECT_NEAR(stats.get().attack_power, expected.attack_power, 1e-9);
+    EXPECT_NEAR(stats.get().haste, expected.haste, 1e-12);
+    EXPECT_NEAR(stats.get().critical_strike, expected.critical_strike, 1e-12);
+    EXPECT_NEAR(stats.get().damage_mod_physical, expected.damage_mod_physical, 1e-12);
+
+    // flurry comes and goes many times during long fights, that shouldn't leave anything behind
+    for (int i = 0; i < 1000000; i++)
+    {
+        stats.remove(flurry);
+        stats.add(flurry);
+    }
+    stats.remove(flurry);
+    stats.remove(haste_buff);
+    stats.remove(ap_buff);
+    stats.remove(ap_multiplier_buff);
+    stats.remove(crit_buff);
+
+    EXPECT_EQ(stats.get().attack_power, start.attack_power);
+    EXPECT_EQ(stats.get().haste, start.haste);
+    EXPECT_EQ(stats.get().critical_strike, start.critical_strike);
+    EXPECT_EQ(stats.get().damage_mod_physical, start.damage_mod_physical);
+    EXPECT_EQ(stats.get().attack_speed, start.attack_speed);
+}
+
 TEST_F(Sim_fixture, test_arms)
 {
     config.sim_time = 5 * 60;
@@ -804,6 +1440,75 @@ total         = 1058.50
 >>> cleanup
 took 4586 ms
 */
+/*
+>> results on master (best of 6):
+fury (generic): took 518 ms
+fury (specialized): took 474 ms
+arms (generic): took 237 ms
+arms (specialized): took 234 ms
+*/
+TEST_F(Sim_fixture, benchmark_rotation_kernels)
+{
+    config.sim_time = 5 * 60;
+    config.n_batches = 10000;
+    config.main_target_initial_armor_ = 6200.0;
+    config.execute_phase_percentage_ = 20;
+    config.combat.use_heroic_strike = true;
+    config.combat.heroic_strike_rage_thresh = 60;
+    config.combat.use_whirlwind = true;
+
+    character.total_special_stats.attack_power = 2800;
+    character.total_special_stats.critical_strike = 35;
+    character.total_special_stats.hit = 3;
+    character.total_special_stats.haste = 0.05;
+    character.talents.flurry = 5;
+    character.talents.deep_wounds = 3;
+    character.talents.unbridled_wrath = 5;
+    config.deep_wounds = true;
+
+    double generic_dps{};
+    auto compare = [&](const std::string& name) {
+        for (bool generic : {true, false})
+        {
+            config.generic_rotation_kernel = generic;
+            Combat_simulator sim(config);
+            std::cout << name << (generic ? " (generic): " : " (specialized): ");
+            time_simulate(sim, character);
+            if (generic)
+            {
+                generic_dps = sim.get_dps_distribution().mean();
+            }
+            else
+            {
+                // same rolls, same decisions: the kernels must agree exactly
+                EXPECT_EQ(sim.get_dps_distribution().mean(), generic_dps);
+            }
+        }
+    };
+
+    character.equip_weapon(Weapon{"test_mh", {}, {}, 2.7, 270, 270, Weapon_socket::one_hand, Weapon_type::axe},
+                           Weapon{"test_oh", {}, {}, 2.6, 260, 260, Weapon_socket::one_hand, Weapon_type::sword});
+    character.talents.dual_wield_specialization = 5;
+    character.talents.bloodthirst = 1;
+    config.combat.use_bloodthirst = true;
+    config.combat.use_bt_in_exec_phase = true;
+    compare("fury");
+
+    character.equip_weapon(Weapon{"test_mh", {}, {}, 3.8, 500, 500, Weapon_socket::two_hand, Weapon_type::mace});
+    character.talents.bloodthirst = 0;
+    character.talents.mortal_strike = 1;
+    character.talents.improved_slam = 2;
+    config.combat.use_bloodthirst = false;
+    config.combat.use_mortal_strike = true;
+    config.combat.use_ms_in_exec_phase = true;
+    config.combat.use_slam = true;
+    config.combat.slam_rage_thresh = 15;
+    config.combat.slam_spam_rage = 100;
+    config.combat.slam_spam_max_time = 1500;
+    config.combat.slam_latency = 200;
+    compare("arms");
+}
+
 TEST_F(Sim_fixture, test_procs)
 {
     config.sim_time = 5 * 60;
@@ -819,7 +1524,7 @@ TEST_F(Sim_fixture, test_procs)
 
     auto doomplate_4pc = Hit_effect{"doomplate_4pc", Hit_effect::Type::stat_boost, {}, {0, 0, 160}, 0, 15, 0, 0.02, 0, 0, 1, 0};
 
-    Armory armory;
+    const auto& armory = Armory::shared();
 
     character.equip_armor(armory.find_armor(Socket::trinket, "badge_of_the_swarmguard"));
     character.equip_armor(armory.find_armor(Socket::trinket, "bloodlust_brooch"));
@@ -924,7 +1629,7 @@ TEST_F(Sim_fixture, base_stats)
         6.96, 6.99, 6.90, 7.11
     };
 
-    Armory armory;
+    const auto& armory = Armory::shared();
 
     for (std::vector<Race>::size_type i = 0; i < races.size(); ++i)
     {
@@ -974,7 +1679,7 @@ TEST_F(Sim_fixture, test_multi)
     character.talents.weapon_mastery = 2;
     character.talents.bloodthirst = 1;
 
-    srand(110000);
+    config.seed = 110000;
     auto start = std::chrono::steady_clock::now();
     const auto& single = Combat_simulator::simulate(config, character);
     auto end = std::chrono::steady_clock::now();
@@ -982,12 +1687,12 @@ TEST_F(Sim_fixture, test_multi)
 
     std::cout << single << std::endl;
 
-    srand(110000);
     start = std::chrono::steady_clock::now();
     config.n_batches = 250;
     Distribution multi{};
     for (auto i = 0; i < 100; ++i)
     {
+        config.seed = 110000 + i;
         multi.add(Combat_simulator::simulate(config, character));
     }
     end = std::chrono::steady_clock::now();
@@ -64,7 +64,7 @@ TEST(TestSuite, test_use_effect_ordering)
 
 TEST(TestSuite, test_use_effects)
 {
-    Armory armory;
+    const auto& armory = Armory::shared();
     auto use1 = armory.find_armor(Socket::trinket, "badge_of_the_swarmguard");
     auto use2 = armory.find_armor(Socket::trinket, "icon_of_unyielding_courage");
     auto use3 = armory.find_armor(Socket::chest, "bulwark_of_kings");
@@ -11,7 +11,7 @@
 TEST_F(Sim_fixture, test_via_config)
 {
     std::filesystem::path p;
-    for (auto pp = std::filesystem::current_path(); pp.has_parent_path(); pp = pp.parent_path())
+    for (auto pp = std::filesystem::current_path(); pp != pp.parent_path(); pp = pp.parent_path())
     {
         if (pp.filename() == "TBC_DPS_Warrior_Sim")
         {
@@ -186,4 +186,56 @@ TEST_F(Sim_fixture, test_via_config)
         }
     }
     */
-}
\ No newline at end of file
+}
+
+TEST_F(Sim_fixture, test_simulate_variants)
+{
+    const std::vector<std::string> armor{"warbringer_battle-helm", "choker_of_vile_intent", "warbringer_shoulderplates",
+                                         "vengeance_wrap", "warbringer_breastplate", "bladespire_warbands",
+                                         "gauntlets_of_martial_perfection", "girdle_of_the_endless_pit",
+                                         "skulkers_greaves", "ironstriders_of_urgency", "ring_of_a_thousand_marks",
+                                         "shapeshifters_signet", "bloodlust_brooch", "dragonspine_trophy",
+                                         "mamas_insurance"};
+    const std::vector<std::string> empty;
+
+    const std::vector<std::string> float_options{"fight_time_dd", "opponent_level_dd", "boss_armor_dd",
+                                                 "n_simulations_dd", "battle_squawk_dd"};
+    Sim_input base{{"human"}, armor, {"dragonmaw", "spiteblade"}, {"battle_shout"}, empty, empty, empty,
+                   {"battle_squawk"}, float_options, {60, 73, 7700, 300, 25}, empty, {}, empty, empty};
+
+    // deltas: a neck, an off hand (slot by slot), a two-hander (the whole list) and the buffs, which are parsed again
+    // with the options of base
+    std::vector<Sim_input> variants(4);
+    variants[0].armor.assign(armor.size(), "");
+    variants[0].armor[1] = "shattered_sun_pendant_of_might_scryers";
+    variants[1].weapons = {"", "dragonstrike"};
+    variants[2].weapons = {"lionheart_executioner"};
+    variants[3].buffs = {"battle_shout", "blessing_of_kings"};
+
+    // the same characters as full inputs
+    std::vector<Sim_input> full(variants.size(), base);
+    full[0].armor[1] = "shattered_sun_pendant_of_might_scryers";
+    full[1].weapons = {"dragonmaw", "dragonstrike"};
+    full[2].weapons = {"lionheart_executioner"};
+    full[3].buffs = {"battle_shout", "blessing_of_kings"};
+
+    Sim_interface sim_interface;
+    const auto distributions = sim_interface.simulate_variants(base, variants);
+    ASSERT_EQ(distributions.size(), variants.size());
+    for (size_t i = 0; i < variants.size(); ++i)
+    {
+        // run again, not looked up
+        Result_cache::shared().clear();
+        const auto expected = sim_interface.simulate_variants(full[i], {Sim_input{}});
+        ASSERT_EQ(expected.size(), 1);
+        EXPECT_EQ(distributions[i].samples(), 300);
+        EXPECT_DOUBLE_EQ(distributions[i].mean(), expected[0].mean());
+    }
+
+    Result_cache::shared().clear();
+    const auto unchanged = sim_interface.simulate_variants(base, {Sim_input{}});
+    for (size_t i = 0; i < variants.size(); ++i)
+    {
+        EXPECT_NE(distributions[i].mean(), unchanged[0].mean());
+    }
+}
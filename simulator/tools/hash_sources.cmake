@@ -0,0 +1,20 @@
+# writes OUTPUT, a translation unit defining Sim_hash::source_hash from the SHA256 of the files listed in SOURCE_LIST.
+# the file is only rewritten when the hash changes, so unchanged sources don't trigger a recompile
+file(STRINGS "${SOURCE_LIST}" sources)
+list(SORT sources)
+
+set(digests "")
+foreach (source IN LISTS sources)
+    file(SHA256 "${source}" digest)
+    string(APPEND digests "${digest}")
+endforeach ()
+string(SHA256 digest "${digests}")
+string(SUBSTRING "${digest}" 0 16 source_hash)
+
+set(content "// generated by simulator/tools/hash_sources.cmake, do not edit\n#include \"Result_cache.hpp\"\n\nconst uint64_t Sim_hash::source_hash = 0x${source_hash};\n")
+if (EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" old_content)
+endif ()
+if (NOT "${old_content}" STREQUAL "${content}")
+    file(WRITE "${OUTPUT}" "${content}")
+endif ()
@@ -8,6 +8,11 @@
 class Distribution
 {
 public:
+    Distribution() = default;
+
+    // a distribution with the given state, e.g. one read from a file
+    Distribution(int n_samples, double mean, double m2, double last_sample);
+
     void add_sample(double sample);
 
     void add(const Distribution& other);
@@ -23,6 +28,9 @@ public:
 
     [[nodiscard]] double last_sample() const { return last_sample_; }
 
+    // sum of the squared deviations from the mean
+    [[nodiscard]] double m2() const { return m2_; }
+
     [[nodiscard]] std::pair<double, double> confidence_interval(double quantile) const;
     [[nodiscard]] std::pair<double, double> confidence_interval_of_the_mean(double quantile) const;
 private:
@@ -0,0 +1,45 @@
+#ifndef WOW_SIMULATOR_HISTOGRAM_HPP
+#define WOW_SIMULATOR_HISTOGRAM_HPP
+
+#include <vector>
+
+// histogram of non-negative samples in fixed memory: n_buckets buckets of equal width, starting at 0. a sample beyond
+// the last bucket doubles the bucket width (merging neighboring buckets) until it fits, so any range is safe.
+// quantiles are interpolated within a bucket, i.e. they are off by less than a bucket width. histograms with the same
+// initial width can be merged, e.g. the ones of several threads.
+class Histogram
+{
+public:
+    explicit Histogram(double bucket_width = 1.0, int n_buckets = 1000);
+
+    // a histogram with the given state, e.g. one read from a file
+    Histogram(double bucket_width, std::vector<int> counts, int n_samples, double min, double max);
+
+    void add_sample(double sample);
+
+    void add(const Histogram& other);
+
+    [[nodiscard]] int samples() const { return n_samples_; }
+
+    [[nodiscard]] double bucket_width() const { return bucket_width_; }
+
+    // bucket i counts the samples in [i * bucket_width, (i + 1) * bucket_width)
+    [[nodiscard]] const std::vector<int>& counts() const { return counts_; }
+
+    // q in [0, 1], e.g. 0.5 for the median
+    [[nodiscard]] double quantile(double q) const;
+
+    [[nodiscard]] double min() const { return min_; }
+    [[nodiscard]] double max() const { return max_; }
+
+private:
+    void widen();
+
+    double bucket_width_;
+    std::vector<int> counts_;
+    int n_samples_{};
+    double min_{};
+    double max_{};
+};
+
+#endif // WOW_SIMULATOR_HISTOGRAM_HPP
@@ -0,0 +1,66 @@
+#ifndef WOW_SIMULATOR_STOPPINGRULE_HPP
+#define WOW_SIMULATOR_STOPPINGRULE_HPP
+
+#include "Distribution.hpp"
+
+#include <vector>
+
+// when to stop sampling, checked with the distribution of the samples so far (of dps, or of paired dps differences).
+// stops at max_samples, and from min_samples on once
+//  - the confidence interval of the mean is within +-precision (with_precision), or
+//  - the sign of the mean is known (with_sign_test). with an indifference > 0 this is Wald's sequential probability
+//    ratio test of mean = -indifference against mean = +indifference, with error rates of 1 - confidence each.
+//    otherwise the confidence interval of the mean has to exclude 0.
+// without either it takes exactly max_samples samples.
+class StoppingRule
+{
+public:
+    explicit StoppingRule(int max_samples = 0, int min_samples = 0);
+
+    StoppingRule& with_max_samples(int max_samples);
+
+    StoppingRule& with_min_samples(int min_samples);
+
+    // confidence is two-sided, e.g. 0.95
+    StoppingRule& with_precision(double precision, double confidence = 0.95);
+
+    // a positive mean is only accepted after min_samples_positive samples, e.g. if false upgrades are worse than
+    // missed ones
+    StoppingRule& with_sign_test(double confidence, double indifference = 0, int min_samples_positive = 0);
+
+    // the rule for each of n_parts samplers whose distributions are merged afterwards (max_samples is left to the
+    // caller). a sign test can't be decided part by part, so those parts take all their samples.
+    [[nodiscard]] StoppingRule split(int n_parts) const;
+
+    [[nodiscard]] bool done(const Distribution& d) const;
+
+    bool operator()(const Distribution& d) const { return done(d); }
+
+    // false if it always takes max_samples samples
+    [[nodiscard]] bool stops_early() const { return precision_ > 0 || sign_test_; }
+
+    [[nodiscard]] int max_samples() const { return max_samples_; }
+    [[nodiscard]] int min_samples() const { return min_samples_; }
+    [[nodiscard]] double precision() const { return precision_; }
+
+    // every parameter of the rule in a fixed order, e.g. to tell rules apart in a cache key
+    [[nodiscard]] std::vector<double> parameters() const;
+
+    // 1 if the sign test accepted a positive mean, -1 if a negative one, 0 if undecided
+    [[nodiscard]] int sign(const Distribution& d) const;
+
+private:
+    int max_samples_;
+    int min_samples_;
+
+    double precision_{};
+    double precision_quantile_{};
+
+    bool sign_test_{};
+    double sign_quantile_{};
+    double indifference_{};
+    double log_likelihood_bound_{};
+    int min_samples_positive_{};
+};
+
+#endif // WOW_SIMULATOR_STOPPINGRULE_HPP
@@ -3,6 +3,11 @@
 #include "Statistics.hpp"
 
 
+Distribution::Distribution(int n_samples, double mean, double m2, double last_sample)
+    : n_samples_(n_samples), mean_(mean), m2_(m2), last_sample_(last_sample)
+{
+}
+
 void Distribution::add_sample(const double sample)
 {
     last_sample_ = sample;
@@ -16,13 +21,21 @@ void Distribution::add_sample(const double sample)
 
 void Distribution::add(const Distribution& other)
 {
+    if (other.n_samples_ == 0) return;
+    if (n_samples_ == 0)
+    {
+        *this = other;
+        return;
+    }
     auto n = n_samples_ + other.n_samples_;
     auto mean = (mean_ * n_samples_ + other.mean_ * other.n_samples_) / n;
     auto delta = mean_ - other.mean_;
-    auto m2 = m2_ + other.m2_ + n_samples_ * other.n_samples_ * delta * delta / n;
+    // Chan et al. parallel variant of Welford, the sample count product can overflow an int
+    auto m2 = m2_ + other.m2_ + static_cast<double>(n_samples_) * other.n_samples_ * delta * delta / n;
     n_samples_ = n;
     mean_ = mean;
     m2_ = m2;
+    last_sample_ = other.last_sample_;
 }
 
 std::pair<double, double> Distribution::confidence_interval(double p_value) const
@@ -0,0 +1,80 @@
+#include "Histogram.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+Histogram::Histogram(double bucket_width, int n_buckets) : bucket_width_(bucket_width), counts_(n_buckets)
+{
+    assert(bucket_width > 0 && n_buckets > 1);
+}
+
+Histogram::Histogram(double bucket_width, std::vector<int> counts, int n_samples, double min, double max)
+    : bucket_width_(bucket_width), counts_(std::move(counts)), n_samples_(n_samples), min_(min), max_(max)
+{
+    assert(bucket_width > 0 && counts_.size() > 1);
+}
+
+void Histogram::add_sample(double sample)
+{
+    sample = std::max(sample, 0.0);
+    while (sample >= bucket_width_ * static_cast<double>(counts_.size()))
+    {
+        widen();
+    }
+    counts_[static_cast<size_t>(sample / bucket_width_)]++;
+
+    min_ = n_samples_ == 0 ? sample : std::min(min_, sample);
+    max_ = n_samples_ == 0 ? sample : std::max(max_, sample);
+    n_samples_++;
+}
+
+void Histogram::widen()
+{
+    // bucket i covers the old buckets 2i and 2i + 1
+    const size_t n = counts_.size();
+    for (size_t i = 0; i < n; ++i)
+    {
+        const size_t first = 2 * i;
+        counts_[i] = (first < n ? counts_[first] : 0) + (first + 1 < n ? counts_[first + 1] : 0);
+    }
+    bucket_width_ *= 2;
+}
+
+void Histogram::add(const Histogram& other)
+{
+    assert(other.counts_.size() == counts_.size());
+    if (other.n_samples_ == 0) return;
+
+    // both widths are the initial width times a power of two
+    Histogram rhs = other;
+    while (bucket_width_ < rhs.bucket_width_) widen();
+    while (rhs.bucket_width_ < bucket_width_) rhs.widen();
+
+    for (size_t i = 0; i < counts_.size(); ++i)
+    {
+        counts_[i] += rhs.counts_[i];
+    }
+    min_ = n_samples_ == 0 ? rhs.min_ : std::min(min_, rhs.min_);
+    max_ = n_samples_ == 0 ? rhs.max_ : std::max(max_, rhs.max_);
+    n_samples_ += rhs.n_samples_;
+}
+
+double Histogram::quantile(double q) const
+{
+    if (n_samples_ == 0) return 0.0;
+
+    const double rank = std::clamp(q, 0.0, 1.0) * n_samples_;
+    double cumulative = 0;
+    for (size_t i = 0; i < counts_.size(); ++i)
+    {
+        if (counts_[i] == 0) continue;
+        if (cumulative + counts_[i] >= rank)
+        {
+            const double value = bucket_width_ * (static_cast<double>(i) + (rank - cumulative) / counts_[i]);
+            return std::clamp(value, min_, max_);
+        }
+        cumulative += counts_[i];
+    }
+    return max_;
+}
@@ -0,0 +1,93 @@
+#include "StoppingRule.hpp"
+
+#include "Statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+double two_sided_quantile(double confidence)
+{
+    return Statistics::find_cdf_quantile(Statistics::get_two_sided_p_value(confidence), 0.01);
+}
+} // namespace
+
+StoppingRule::StoppingRule(int max_samples, int min_samples) : max_samples_(max_samples), min_samples_(min_samples) {}
+
+StoppingRule& StoppingRule::with_max_samples(int max_samples)
+{
+    max_samples_ = max_samples;
+    return *this;
+}
+
+StoppingRule& StoppingRule::with_min_samples(int min_samples)
+{
+    min_samples_ = min_samples;
+    return *this;
+}
+
+StoppingRule& StoppingRule::with_precision(double precision, double confidence)
+{
+    precision_ = precision;
+    precision_quantile_ = two_sided_quantile(confidence);
+    return *this;
+}
+
+StoppingRule& StoppingRule::with_sign_test(double confidence, double indifference, int min_samples_positive)
+{
+    sign_test_ = true;
+    sign_quantile_ = two_sided_quantile(confidence);
+    indifference_ = indifference;
+    // Wald's bound for equal error rates alpha = beta = 1 - confidence
+    log_likelihood_bound_ = std::log(confidence / (1 - confidence));
+    min_samples_positive_ = min_samples_positive;
+    return *this;
+}
+
+StoppingRule StoppingRule::split(int n_parts) const
+{
+    auto part = *this;
+    part.min_samples_ = min_samples_ / n_parts;
+    // the merged std of the mean is the one of a part over sqrt(n_parts)
+    part.precision_ = sign_test_ ? 0 : precision_ * std::sqrt(n_parts);
+    part.sign_test_ = false;
+    return part;
+}
+
+std::vector<double> StoppingRule::parameters() const
+{
+    return {static_cast<double>(max_samples_), static_cast<double>(min_samples_), precision_, precision_quantile_,
+            static_cast<double>(sign_test_), sign_quantile_, indifference_, log_likelihood_bound_,
+            static_cast<double>(min_samples_positive_)};
+}
+
+bool StoppingRule::done(const Distribution& d) const
+{
+    if (d.samples() >= max_samples_) return true;
+    // the spread is unknown before two samples
+    if (d.samples() < std::max(min_samples_, 2)) return false;
+    if (precision_ > 0 && precision_quantile_ * d.std_of_the_mean() <= precision_) return true;
+    return sign_test_ && sign(d) != 0;
+}
+
+int StoppingRule::sign(const Distribution& d) const
+{
+    if (!sign_test_ || d.samples() < 2) return 0;
+
+    int sign = 0;
+    if (indifference_ > 0)
+    {
+        // log likelihood ratio of N(+indifference, variance) against N(-indifference, variance) for all samples
+        const auto log_likelihood_ratio = 2 * indifference_ * d.samples() * d.mean() / d.variance();
+        if (log_likelihood_ratio >= log_likelihood_bound_) sign = 1;
+        if (log_likelihood_ratio <= -log_likelihood_bound_) sign = -1;
+    }
+    else
+    {
+        const auto half_width = sign_quantile_ * d.std_of_the_mean();
+        if (d.mean() > half_width) sign = 1;
+        if (d.mean() < -half_width) sign = -1;
+    }
+    return sign > 0 && d.samples() < min_samples_positive_ ? 0 : sign;
+}
@@ -0,0 +1,73 @@
+#include "Histogram.hpp"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+TEST(TestSuite, test_histogram_quantiles)
+{
+    std::default_random_engine generator{};
+    std::normal_distribution<double> nd(3000.0, 300.0);
+
+    Histogram histogram{20};
+    std::vector<double> samples;
+    for (int i = 0; i < 100000; ++i)
+    {
+        samples.push_back(nd(generator));
+        histogram.add_sample(samples.back());
+    }
+    std::sort(samples.begin(), samples.end());
+
+    for (double q : {0.05, 0.25, 0.5, 0.75, 0.95})
+    {
+        EXPECT_NEAR(histogram.quantile(q), samples[static_cast<size_t>(q * samples.size())], histogram.bucket_width());
+    }
+    EXPECT_DOUBLE_EQ(histogram.quantile(0), samples.front());
+    EXPECT_DOUBLE_EQ(histogram.quantile(1), samples.back());
+}
+
+TEST(TestSuite, test_histogram_widens)
+{
+    Histogram histogram{20, 1000};
+    histogram.add_sample(100);
+    histogram.add_sample(19999);
+    EXPECT_DOUBLE_EQ(histogram.bucket_width(), 20);
+
+    // beyond the last bucket
+    histogram.add_sample(45000);
+    EXPECT_DOUBLE_EQ(histogram.bucket_width(), 80);
+    EXPECT_EQ(histogram.counts().size(), 1000u);
+    EXPECT_EQ(std::accumulate(histogram.counts().begin(), histogram.counts().end(), 0), 3);
+    EXPECT_EQ(histogram.counts()[100 / 80], 1);
+    EXPECT_EQ(histogram.counts()[19999 / 80], 1);
+    EXPECT_EQ(histogram.counts()[45000 / 80], 1);
+    EXPECT_DOUBLE_EQ(histogram.max(), 45000);
+}
+
+TEST(TestSuite, test_histogram_merge)
+{
+    std::default_random_engine generator{};
+    std::uniform_real_distribution<double> low(0, 5000);
+    std::uniform_real_distribution<double> high(0, 50000);
+
+    Histogram all{20};
+    Histogram first{20};
+    Histogram second{20};
+    for (int i = 0; i < 10000; ++i)
+    {
+        const double a = low(generator);
+        const double b = high(generator);
+        first.add_sample(a);
+        second.add_sample(b);
+        all.add_sample(a);
+        all.add_sample(b);
+    }
+    EXPECT_LT(first.bucket_width(), second.bucket_width());
+
+    first.add(second);
+    EXPECT_EQ(first.samples(), all.samples());
+    EXPECT_EQ(first.bucket_width(), all.bucket_width());
+    EXPECT_EQ(first.counts(), all.counts());
+    EXPECT_DOUBLE_EQ(first.quantile(0.5), all.quantile(0.5));
+}
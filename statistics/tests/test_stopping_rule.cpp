@@ -0,0 +1,73 @@
+#include "StoppingRule.hpp"
+
+#include "gtest/gtest.h"
+#include <random>
+
+namespace
+{
+Distribution sample_until(const StoppingRule& rule, double mean, double std)
+{
+    std::default_random_engine generator{};
+    std::normal_distribution<double> nd(mean, std);
+
+    Distribution distribution{};
+    while (!rule(distribution))
+    {
+        distribution.add_sample(nd(generator));
+    }
+    return distribution;
+}
+} // namespace
+
+TEST(TestSuite, test_stopping_rule_fixed)
+{
+    StoppingRule rule{1000};
+    EXPECT_FALSE(rule.stops_early());
+    EXPECT_EQ(sample_until(rule, 3000, 300).samples(), 1000);
+    EXPECT_EQ(sample_until(StoppingRule{0}, 3000, 300).samples(), 0);
+}
+
+TEST(TestSuite, test_stopping_rule_precision)
+{
+    auto rule = StoppingRule{100000}.with_precision(5);
+    EXPECT_TRUE(rule.stops_early());
+
+    auto distribution = sample_until(rule, 3000, 300);
+    // (1.96 * 300 / 5)^2 samples
+    EXPECT_NEAR(distribution.samples(), 13830, 1000);
+    EXPECT_LE(1.96 * distribution.std_of_the_mean(), 5.01);
+
+    EXPECT_EQ(sample_until(rule.with_max_samples(5000), 3000, 300).samples(), 5000);
+}
+
+TEST(TestSuite, test_stopping_rule_sign_test)
+{
+    auto rule = StoppingRule{100000, 100}.with_sign_test(0.999);
+
+    auto upgrade = sample_until(rule, 10, 300);
+    EXPECT_LT(upgrade.samples(), 100000);
+    EXPECT_EQ(rule.sign(upgrade), 1);
+
+    auto downgrade = sample_until(rule, -10, 300);
+    EXPECT_LT(downgrade.samples(), 100000);
+    EXPECT_EQ(rule.sign(downgrade), -1);
+
+    // no difference at all is never decided
+    auto rule_positive = StoppingRule{5000, 100}.with_sign_test(0.999, 0, 20000);
+    EXPECT_EQ(sample_until(rule_positive, 0, 300).samples(), 5000);
+    EXPECT_EQ(sample_until(rule_positive, 50, 300).samples(), 5000);
+}
+
+TEST(TestSuite, test_stopping_rule_sprt)
+{
+    auto rule = StoppingRule{100000}.with_sign_test(0.99, 10);
+
+    auto upgrade = sample_until(rule, 10, 300);
+    EXPECT_EQ(rule.sign(upgrade), 1);
+    // the expected sample size is about log(99) * 300^2 / (2 * 10^2) ~ 2070
+    EXPECT_LT(upgrade.samples(), 10000);
+
+    auto downgrade = sample_until(rule, -10, 300);
+    EXPECT_EQ(rule.sign(downgrade), -1);
+    EXPECT_LT(downgrade.samples(), 10000);
+}
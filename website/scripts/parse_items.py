@@ -45,7 +45,7 @@ class Weapon_category:
 
 
 armory_location = os.path.abspath(
-    os.path.join(os.path.dirname(__file__), '..', '..', 'wow_library', 'include', 'Armory.hpp'))
+    os.path.join(os.path.dirname(__file__), '..', '..', 'wow_library', 'tools', 'item_table.cpp'))
 index_html_location = os.path.abspath(
     os.path.join(os.path.dirname(__file__), '..', 'index.html'))
 gems_js_location = os.path.abspath(
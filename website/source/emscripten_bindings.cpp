@@ -37,6 +37,7 @@ EMSCRIPTEN_BINDINGS(module)
         .field("dmg_sources", &Sim_output::dmg_sources)
         .field("time_lapse_names", &Sim_output::time_lapse_names)
         .field("damage_time_lapse", &Sim_output::damage_time_lapse)
+        .field("time_lapse_resolution", &Sim_output::time_lapse_resolution)
         .field("aura_uptimes", &Sim_output::aura_uptimes)
         .field("use_effect_order_string", &Sim_output::use_effect_order_string)
         .field("proc_counter", &Sim_output::proc_counter)
@@ -267,6 +267,13 @@ Character character_setup(const Armory& armory, const std::string& race, const s
                           const std::vector<std::string>& talent_string, const std::vector<int>& talent_val,
                           const std::vector<std::string>& ench_vec, const std::vector<std::string>& gem_vec);
 
+// with other values of the buffs than the armory's, e.g. the ones of a request
+Character character_setup(const Armory& armory, const Buffs& buffs, const std::string& race,
+                          const std::vector<std::string>& armor_vec, const std::vector<std::string>& weapons_vec,
+                          const std::vector<std::string>& buffs_vec, const std::vector<std::string>& talent_string,
+                          const std::vector<int>& talent_val, const std::vector<std::string>& ench_vec,
+                          const std::vector<std::string>& gem_vec);
+
 Race get_race(const std::string& race);
 
 Character get_character_of_race(const std::string& race);
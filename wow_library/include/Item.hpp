@@ -251,6 +251,7 @@ public:
     int procs{}; // statistics
 
     int combat_buff_idx{-1}; // "link" to combat buff
+    int hit_aura_idx{-1}; // "link" to hit aura (use effects which enable a hit effect for a while)
 };
 
 std::ostream& operator<<(std::ostream& os, const Hit_effect::Type& t);
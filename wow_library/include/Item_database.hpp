@@ -0,0 +1,31 @@
+#ifndef WOW_SIMULATOR_ITEM_DATABASE_HPP
+#define WOW_SIMULATOR_ITEM_DATABASE_HPP
+
+#include "Armory.hpp"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// the items of an armory (armor, weapons and set bonuses) in a compact binary file, so a new file updates the items
+// without a rebuild of the simulator. the file is written by write_item_database from tools/item_table.cpp, so editing
+// items still means rebuilding that tool. gems and buffs are looked up by name in the code and stay compiled in.
+// numbers are stored in the byte order of the machine, which is little endian for x86, arm and wasm alike
+class Item_database
+{
+public:
+    // bump it whenever the layout changes, files of another version are rejected
+    static constexpr uint32_t version = 1;
+
+    static void write(const Armory& armory, std::ostream& out);
+
+    // replaces the items of the armory with the ones in data. false (and the armory as it was) if data isn't a
+    // database of this version
+    [[nodiscard]] static bool read(const char* data, size_t size, Armory& armory);
+
+    // reads the file in place where it can be memory-mapped, otherwise (e.g. in the browser, where the file is fetched
+    // into the virtual file system) through a buffer
+    [[nodiscard]] static bool load(const std::string& path, Armory& armory);
+};
+
+#endif // WOW_SIMULATOR_ITEM_DATABASE_HPP
@@ -0,0 +1,72 @@
+#ifndef WOW_SIMULATOR_STAT_COMPOSITION_HPP
+#define WOW_SIMULATOR_STAT_COMPOSITION_HPP
+
+#include "Character.hpp"
+
+#include <array>
+
+// the sums behind the total stats of a character, kept up to date item by item. swapping an item takes it off and puts
+// the other one on, a few additions instead of a compute_total_stats which rebuilds the whole character. this is what
+// compute_total_stats itself is built on, so both give the same stats
+class Stat_composition
+{
+public:
+    // the base stats, talents and buffs of the character, without any gear
+    Stat_composition(const Armory& armory, const Character& character);
+
+    // the armor, weapons and gems the character wears
+    void add_items(const Character& character);
+
+    void add(const Armor& armor) { change(armor, 1); }
+    void remove(const Armor& armor) { change(armor, -1); }
+    void swap(const Armor& old_armor, const Armor& new_armor)
+    {
+        remove(old_armor);
+        add(new_armor);
+    }
+
+    void add(const Weapon& weapon) { change(weapon, 1); }
+    void remove(const Weapon& weapon) { change(weapon, -1); }
+    void swap(const Weapon& old_weapon, const Weapon& new_weapon)
+    {
+        remove(old_weapon);
+        add(new_weapon);
+    }
+
+    void add(const Gem& gem) { change(gem.attributes, gem.special_stats, 1); }
+    void remove(const Gem& gem) { change(gem.attributes, gem.special_stats, -1); }
+
+    [[nodiscard]] bool has_set_bonus(const Set_bonus& set_bonus) const;
+
+    [[nodiscard]] bool adds_braided_eternium_chain_buff() const
+    {
+        return n_braided_eternium_chains_ > 0 && !has_braided_eternium_chain_buff_;
+    }
+
+    // the ones compute_total_stats gives the character wearing the added items
+    void total_stats(Attributes& total_attributes, Special_stats& total_special_stats) const;
+
+    [[nodiscard]] Special_stats total_special_stats() const;
+
+private:
+    void change(const Armor& armor, int n);
+    void change(const Weapon& weapon, int n);
+    void change(const Attributes& attributes, const Special_stats& special_stats, int n);
+    void count_set(Set set, int n);
+
+    // one past the last set
+    static constexpr size_t n_sets = static_cast<size_t>(Set::the_twin_blades_of_azzinoth_non_demon) + 1;
+
+    const Armory& armory_;
+    Attributes attributes_{};
+    Special_stats special_stats_{};
+    Special_stats talent_special_stats_{};
+    int one_handed_weapon_specialization_{};
+    int two_handed_weapon_specialization_{};
+    int n_weapons_{};
+    std::array<int, n_sets> set_counts_{};
+    int n_braided_eternium_chains_{};
+    bool has_braided_eternium_chain_buff_{};
+};
+
+#endif // WOW_SIMULATOR_STAT_COMPOSITION_HPP
@@ -1,9 +1,20 @@
 #include "Armory.hpp"
 
 #include "Character.hpp"
+#include "Item_database.hpp"
+#include "Stat_composition.hpp"
 #include "find_values.hpp"
 #include "string_helpers.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <system_error>
+
 Attributes Armory::get_enchant_attributes(Socket socket, Enchant::Type type)
 {
     switch (socket)
@@ -225,6 +236,12 @@ Hit_effect Armory::enchant_hit_effect(Weapon& weapon, Enchant::Type type)
 void Armory::clean_weapon(Weapon& weapon) const
 {
     if (weapon.hit_effects.empty()) return;
+    // assigned from the armory's weapon without copying it, so the hit effects keep their buffer
+    if (const auto* original = indexed_weapon(weapon.weapon_socket, weapon.name))
+    {
+        weapon.hit_effects = original->hit_effects;
+        return;
+    }
     weapon.hit_effects = find_weapon(weapon.weapon_socket, weapon.name).hit_effects;
 }
 
@@ -248,35 +265,23 @@ void Armory::compute_total_stats(Character& character) const
         std::cerr << "invalid armor setup" << std::endl;
         assert(false);
     }
-    character.total_attributes = {};
-    character.total_special_stats = {};
-    character.set_bonuses = {};
+    // the effects are collected in the vectors the character already has, which keeps their capacity. the effects are
+    // still copied in (with their names), scans over many items use change_armor with a Stat_composition instead
+    character.set_bonuses.clear();
+    character.use_effects.clear();
     for (auto& wep : character.weapons)
     {
         clean_weapon(wep);
     }
 
-    auto total_attributes{character.base_attributes};
-    auto total_special_stats{character.base_special_stats};
-
-    std::vector<Use_effect> use_effects{};
-    std::unordered_map<Set, int> set_counts{};
+    Stat_composition composition{*this, character};
 
     for (const auto& armor : character.armor)
     {
-        total_attributes += armor.attributes;
-        total_special_stats += armor.special_stats;
-
-        if (armor.enchant.type != Enchant::Type::none)
-        {
-            total_attributes += get_enchant_attributes(armor.socket, armor.enchant.type);
-            total_special_stats += get_enchant_special_stats(armor.socket, armor.enchant.type);
-        }
-
-        set_counts[armor.set_name] += 1;
+        composition.add(armor);
         for (const auto& use_effect : armor.use_effects)
         {
-            use_effects.emplace_back(use_effect);
+            character.use_effects.emplace_back(use_effect);
         }
         for (const auto& hit_effect : armor.hit_effects)
         {
@@ -286,13 +291,10 @@ void Armory::compute_total_stats(Character& character) const
 
     for (auto& weapon : character.weapons)
     {
-        total_attributes += weapon.attributes;
-        total_special_stats += weapon.special_stats;
+        composition.add(weapon);
 
         if (weapon.enchant.type != Enchant::Type::none)
         {
-            total_attributes += get_enchant_attributes(weapon.socket, weapon.enchant.type);
-            total_special_stats += get_enchant_special_stats(weapon.socket, weapon.enchant.type);
             auto hit_effect = enchant_hit_effect(weapon, weapon.enchant.type);
             if (hit_effect.type != Hit_effect::Type::none)
             {
@@ -300,29 +302,20 @@ void Armory::compute_total_stats(Character& character) const
             }
         }
 
-        if (!weapon.buff.name.empty())
+        if (!weapon.buff.name.empty() && weapon.buff.hit_effect.type != Hit_effect::Type::none)
         {
-            total_attributes += weapon.buff.attributes;
-            total_special_stats += weapon.buff.special_stats;
-
-            if (weapon.buff.hit_effect.type != Hit_effect::Type::none)
-            {
-                weapon.hit_effects.emplace_back(weapon.buff.hit_effect);
-            }
+            weapon.hit_effects.emplace_back(weapon.buff.hit_effect);
         }
 
         for (const auto& use_effect : weapon.use_effects)
         {
-            use_effects.emplace_back(use_effect);
+            character.use_effects.emplace_back(use_effect);
         }
-
-        set_counts[weapon.set_name] += 1;
     }
 
     for (const auto& gem : character.gems)
     {
-        total_attributes += gem.attributes;
-        total_special_stats += gem.special_stats;
+        composition.add(gem);
 
         if (gem.hit_effect.type != Hit_effect::Type::none)
         {
@@ -332,10 +325,8 @@ void Armory::compute_total_stats(Character& character) const
 
     for (const auto& set_bonus : set_bonuses)
     {
-        if (set_counts[set_bonus.set] >= set_bonus.pieces)
+        if (composition.has_set_bonus(set_bonus))
         {
-            total_attributes += set_bonus.attributes;
-            total_special_stats += set_bonus.special_stats;
             if (set_bonus.hit_effect.type != Hit_effect::Type::none)
             {
                 add_hit_effect(set_bonus.hit_effect, character);
@@ -344,39 +335,21 @@ void Armory::compute_total_stats(Character& character) const
         }
     }
 
-    Special_stats talent_special_stats{};
-    talent_special_stats.critical_strike = character.talents.cruelty;
-    talent_special_stats.hit = character.talents.precision;
-    talent_special_stats.expertise = character.talents.defiance * 2;
-    talent_special_stats.ap_multiplier = character.talents.improved_berserker_stance * 0.02;
-    if (character.is_dual_wield())
-    {
-        talent_special_stats.damage_mod_physical = character.talents.one_handed_weapon_specialization * 0.02;
-    }
-    else
-    {
-        talent_special_stats.damage_mod_physical = character.talents.two_handed_weapon_specialization * 0.01;
-    }
-    total_special_stats += talent_special_stats;
-
     if (character.race == Race::draenei && !character.has_buff(buffs.heroic_presence))
     {
         character.add_buff(buffs.heroic_presence);
     }
 
-    if (character.has_item("braided_eternium_chain") && !character.has_buff(buffs.braided_eternium_chain))
+    if (composition.adds_braided_eternium_chain_buff())
     {
         character.add_buff(buffs.braided_eternium_chain);
     }
 
     for (const auto& buff : character.buffs)
     {
-        total_attributes += buff.attributes;
-        total_special_stats += buff.special_stats;
-
         for (const auto& use_effect : buff.use_effects)
         {
-            use_effects.emplace_back(use_effect);
+            character.use_effects.emplace_back(use_effect);
         }
 
         for (const auto& hit_effect : buff.hit_effects)
@@ -385,52 +358,22 @@ void Armory::compute_total_stats(Character& character) const
         }
     }
 
-    total_special_stats += {3, 0, 0}; // crit from berserker stance
-
-    total_special_stats += total_attributes.to_special_stats(total_special_stats);
-    character.total_attributes = total_attributes.multiply(total_special_stats);
-    character.total_special_stats = total_special_stats;
-
-    character.use_effects = use_effects;
+    composition.total_stats(character.total_attributes, character.total_special_stats);
 }
 
 bool Armory::check_if_armor_valid(const std::vector<Armor>& armor)
 {
-    std::vector<Socket> sockets;
-    bool one_ring{false};
-    bool one_trinket{false};
+    std::array<int, static_cast<size_t>(Socket::ranged) + 1> worn{};
     for (auto const& a : armor)
     {
-        for (auto const& socket : sockets)
+        const auto i = static_cast<size_t>(a.socket);
+        if (i >= worn.size()) continue;
+        const int allowed = (a.socket == Socket::ring || a.socket == Socket::trinket) ? 2 : 1;
+        if (++worn[i] > allowed)
         {
-            if (a.socket == socket)
-            {
-                if (a.socket == Socket::ring)
-                {
-                    if (a.socket == Socket::ring && one_ring)
-                    {
-                        std::cerr << "extra copy of " << a.socket << std::endl;
-                        return false;
-                    }
-                    one_ring = true;
-                }
-                else if (a.socket == Socket::trinket)
-                {
-                    if (a.socket == Socket::trinket && one_trinket)
-                    {
-                        std::cerr << "extra copy of " << a.socket << std::endl;
-                        return false;
-                    }
-                    one_trinket = true;
-                }
-                else
-                {
-                    std::cerr << "extra copy of " << a.socket << std::endl;
-                    return false;
-                }
-            }
+            std::cerr << "extra copy of " << a.socket << std::endl;
+            return false;
         }
-        sockets.emplace_back(a.socket);
     }
     return true;
 }
@@ -447,47 +390,112 @@ bool Armory::check_if_weapons_valid(std::vector<Weapon>& ws)
     }
 }
 
-void Armory::change_weapon(std::vector<Weapon>& current_weapons, const Weapon& equip_weapon, const Socket& socket)
+namespace
+{
+Weapon& weapon_in_slot(std::vector<Weapon>& current_weapons, const Weapon& equip_weapon, Socket socket)
 {
     // TODO fix twohanded -> dual wield item swap!
-    if (equip_weapon.weapon_socket == Weapon_socket::two_hand)
-    {
-        Weapon& current_wep = current_weapons[0];
-        Weapon weapon_copy = equip_weapon;
-        weapon_copy.buff = current_wep.buff;
-        weapon_copy.enchant = current_wep.enchant;
-        weapon_copy.socket = socket;
-        current_wep = weapon_copy;
-    }
-    else
-    {
-        Weapon& current_wep = (socket == Socket::main_hand) ? current_weapons[0] : current_weapons[1];
-        Weapon weapon_copy = equip_weapon;
-        weapon_copy.buff = current_wep.buff;
-        weapon_copy.enchant = current_wep.enchant;
-        weapon_copy.socket = socket;
-        current_wep = weapon_copy;
-    }
+    if (equip_weapon.weapon_socket == Weapon_socket::two_hand) return current_weapons[0];
+    return (socket == Socket::main_hand) ? current_weapons[0] : current_weapons[1];
 }
 
-void Armory::change_armor(std::vector<Armor>& armor_vec, const Armor& armor, bool first_misc_slot)
+Armor* armor_in_slot(std::vector<Armor>& armor_vec, Socket socket, bool first_misc_slot)
 {
-    auto socket = armor.socket;
     auto first_slot = (socket != Socket::ring && socket != Socket::trinket) || first_misc_slot;
     for (auto& armor_piece : armor_vec)
     {
         if (armor_piece.socket == socket)
         {
-            if (first_slot) {
-                // Reuse the same enchant
-                auto enchant = armor_piece.enchant;
-                armor_piece = armor;
-                armor_piece.enchant = enchant;
-                return;
-            }
+            if (first_slot) return &armor_piece;
             first_slot = true;
         }
     }
+    return nullptr;
+}
+
+// whether the armor changes more of the character than the sums of Stat_composition: its effects, a set bonus (which
+// can have a hit effect) or the buff of a braided eternium chain
+bool changes_effects(const Armor& armor)
+{
+    return !armor.hit_effects.empty() || !armor.use_effects.empty() || armor.set_name != Set::none ||
+           armor.name == "braided_eternium_chain";
+}
+} // namespace
+
+void Armory::change_weapon(std::vector<Weapon>& current_weapons, const Weapon& equip_weapon, const Socket& socket)
+{
+    Weapon& current_wep = weapon_in_slot(current_weapons, equip_weapon, socket);
+    Weapon weapon_copy = equip_weapon;
+    weapon_copy.buff = current_wep.buff;
+    weapon_copy.enchant = current_wep.enchant;
+    weapon_copy.socket = socket;
+    current_wep = weapon_copy;
+}
+
+void Armory::change_armor(std::vector<Armor>& armor_vec, const Armor& armor, bool first_misc_slot)
+{
+    if (auto* armor_piece = armor_in_slot(armor_vec, armor.socket, first_misc_slot))
+    {
+        // Reuse the same enchant
+        auto enchant = armor_piece->enchant;
+        *armor_piece = armor;
+        armor_piece->enchant = enchant;
+    }
+}
+
+void Armory::change_armor(Character& character, Stat_composition& composition, const Armor& armor,
+                          bool first_misc_slot) const
+{
+    auto* armor_piece = armor_in_slot(character.armor, armor.socket, first_misc_slot);
+    if (!armor_piece) return;
+
+    const bool recompute = changes_effects(*armor_piece) || changes_effects(armor);
+    composition.remove(*armor_piece);
+    auto enchant = armor_piece->enchant;
+    *armor_piece = armor;
+    armor_piece->enchant = enchant;
+    composition.add(*armor_piece);
+
+    if (recompute)
+    {
+        compute_total_stats(character);
+        return;
+    }
+    composition.total_stats(character.total_attributes, character.total_special_stats);
+}
+
+void Armory::change_weapon(Character& character, Stat_composition& composition, const Weapon& equip_weapon,
+                           Socket socket) const
+{
+    Weapon& current_wep = weapon_in_slot(character.weapons, equip_weapon, socket);
+
+    // the hit effects of a weapon are its own, those of its enchant and temporary buff (e.g. crusader depends on the
+    // swing speed) and those of the rest of the gear. without the first three they carry over
+    const auto* current_original = indexed_weapon(current_wep.weapon_socket, current_wep.name);
+    const bool own_effects = !current_original || !current_original->hit_effects.empty() ||
+                             !current_wep.use_effects.empty() || current_wep.set_name != Set::none ||
+                             !equip_weapon.hit_effects.empty() || !equip_weapon.use_effects.empty() ||
+                             equip_weapon.set_name != Set::none;
+    const bool enchant_effect =
+        enchant_hit_effect(current_wep, current_wep.enchant.type).type != Hit_effect::Type::none;
+    const bool buff_effect = !current_wep.buff.name.empty() && current_wep.buff.hit_effect.type != Hit_effect::Type::none;
+    const bool recompute = own_effects || enchant_effect || buff_effect;
+
+    composition.remove(current_wep);
+    Weapon weapon_copy = equip_weapon;
+    weapon_copy.buff = current_wep.buff;
+    weapon_copy.enchant = current_wep.enchant;
+    weapon_copy.socket = socket;
+    if (!recompute) weapon_copy.hit_effects = current_wep.hit_effects;
+    current_wep = std::move(weapon_copy);
+    composition.add(current_wep);
+
+    if (recompute)
+    {
+        compute_total_stats(character);
+        return;
+    }
+    composition.total_stats(character.total_attributes, character.total_special_stats);
 }
 
 std::vector<Weapon> Armory::get_weapon_in_socket(const Weapon_socket socket) const
@@ -607,6 +615,88 @@ std::unordered_map<std::string, const Weapon*> Armory::build_weapons_index() con
     return index;
 }
 
+Armory::Armory()
+{
+    index_items();
+}
+
+void Armory::index_items()
+{
+    armor_index_.clear();
+    one_hand_index_.clear();
+    two_hand_index_.clear();
+    for (const auto socket : {Socket::head, Socket::neck, Socket::shoulder, Socket::back, Socket::chest, Socket::wrist,
+                              Socket::hands, Socket::belt, Socket::legs, Socket::boots, Socket::ring, Socket::trinket,
+                              Socket::ranged})
+    {
+        auto& index = armor_index_[socket];
+        const auto& items = get_items_in_socket(socket);
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            // the first item of a name is the one which is found
+            index.emplace(items[i].name, i);
+        }
+    }
+
+    for (const auto by_type : {&Armory::swords_t, &Armory::axes_t, &Armory::maces_t, &Armory::daggers_t, &Armory::fists_t})
+    {
+        for (size_t i = 0; i < (this->*by_type).size(); ++i)
+        {
+            one_hand_index_.emplace((this->*by_type)[i].name, Weapon_position{by_type, i});
+        }
+    }
+    for (const auto by_type : {&Armory::two_handed_swords_t, &Armory::two_handed_axes_polearm_t, &Armory::two_handed_maces_t})
+    {
+        for (size_t i = 0; i < (this->*by_type).size(); ++i)
+        {
+            two_hand_index_.emplace((this->*by_type)[i].name, Weapon_position{by_type, i});
+        }
+    }
+}
+
+std::vector<std::string> Armory::item_database_paths()
+{
+    if (const char* path = std::getenv("WOW_SIMULATOR_ITEM_DATABASE")) return {path};
+
+    std::vector<std::string> paths;
+#if defined(__linux__) && defined(WOW_SIMULATOR_ITEM_DATABASE_INSTALL_DIR)
+    std::error_code error;
+    const auto executable = std::filesystem::read_symlink("/proc/self/exe", error);
+    if (!error)
+    {
+        const auto directory = executable.parent_path();
+        paths.push_back((directory / "items.bin").string());
+        paths.push_back((directory.parent_path() / WOW_SIMULATOR_ITEM_DATABASE_INSTALL_DIR / "items.bin").string());
+    }
+#endif
+    paths.emplace_back(WOW_SIMULATOR_ITEM_DATABASE);
+    return paths;
+}
+
+const Armory& Armory::shared()
+{
+    static const Armory armory = [] {
+        const auto paths = item_database_paths();
+        const auto path = std::find_if(paths.begin(), paths.end(), [](const std::string& p) {
+            return static_cast<bool>(std::ifstream(p, std::ios::binary));
+        });
+        if (path == paths.end())
+        {
+            std::string message = "no item database found, looked for";
+            for (const auto& p : paths) message += " " + p;
+            throw std::runtime_error(message);
+        }
+
+        Armory armory{};
+        if (!Item_database::load(*path, armory))
+        {
+            throw std::runtime_error("could not load the item database " + *path + " (of another version?)");
+        }
+        return armory;
+    }();
+    return armory;
+}
+
 Armor Armory::find_armor(const Socket socket, const std::string& name) const
 {
     if (name == "none") return Armor::empty(socket);
@@ -617,6 +707,15 @@ Armor Armory::find_armor(const Socket socket, const std::string& name) const
         assert(false);
         return Armor::empty(socket);
     }
+    const auto index = armor_index_.find(socket);
+    if (index != armor_index_.end())
+    {
+        const auto it = index->second.find(name);
+        if (it != index->second.end() && it->second < items.size() && items[it->second].name == name)
+        {
+            return items[it->second];
+        }
+    }
     for (const auto& item : items)
     {
         if (item.name == name)
@@ -629,10 +728,22 @@ Armor Armory::find_armor(const Socket socket, const std::string& name) const
     return Armor::empty(socket);
 }
 
+const Weapon* Armory::indexed_weapon(Weapon_socket socket, const std::string& name) const
+{
+    const auto& index = socket == Weapon_socket::two_hand ? two_hand_index_ : one_hand_index_;
+    const auto it = index.find(name);
+    if (it == index.end()) return nullptr;
+    const auto& [by_type, i] = it->second;
+    const auto& weapons = this->*by_type;
+    return i < weapons.size() && weapons[i].name == name ? &weapons[i] : nullptr;
+}
+
 Weapon Armory::find_weapon(Weapon_socket socket, const std::string& name) const
 {
     if (name == "none") return Weapon::empty(socket);
 
+    if (const auto* weapon = indexed_weapon(socket, name)) return *weapon;
+
     if (socket == Weapon_socket::two_hand)
     {
         for (const auto by_type : {&two_handed_swords_t, &two_handed_axes_polearm_t, &two_handed_maces_t})
@@ -1095,6 +1206,12 @@ void Armory::add_gems_to_character(Character& character, const std::vector<std::
 }
 
 void Armory::add_buffs_to_character(Character& character, const std::vector<std::string>& buffs_vec) const
+{
+    add_buffs_to_character(character, buffs_vec, buffs);
+}
+
+void Armory::add_buffs_to_character(Character& character, const std::vector<std::string>& buffs_vec,
+                                    const Buffs& buffs) const
 {
     if (String_helpers::find_string(buffs_vec, "fungal_bloom"))
     {
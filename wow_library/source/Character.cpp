@@ -50,6 +50,16 @@ Character character_setup(const Armory& armory, const std::string& race, const s
                           const std::vector<std::string>& weapons_vec, const std::vector<std::string>& buffs_vec,
                           const std::vector<std::string>& talent_string, const std::vector<int>& talent_val,
                           const std::vector<std::string>& ench_vec, const std::vector<std::string>& gem_vec)
+{
+    return character_setup(armory, armory.buffs, race, armor_vec, weapons_vec, buffs_vec, talent_string, talent_val,
+                           ench_vec, gem_vec);
+}
+
+Character character_setup(const Armory& armory, const Buffs& buffs, const std::string& race,
+                          const std::vector<std::string>& armor_vec, const std::vector<std::string>& weapons_vec,
+                          const std::vector<std::string>& buffs_vec, const std::vector<std::string>& talent_string,
+                          const std::vector<int>& talent_val, const std::vector<std::string>& ench_vec,
+                          const std::vector<std::string>& gem_vec)
 {
     auto character = get_character_of_race(race);
 
@@ -81,7 +91,7 @@ Character character_setup(const Armory& armory, const std::string& race, const s
 
     Armory::add_enchants_to_character(character, ench_vec);
     armory.add_gems_to_character(character, gem_vec);
-    armory.add_buffs_to_character(character, buffs_vec);
+    armory.add_buffs_to_character(character, buffs_vec, buffs);
     Armory::add_talents_to_character(character, talent_string, talent_val);
 
     armory.compute_total_stats(character);
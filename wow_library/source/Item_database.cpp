@@ -0,0 +1,361 @@
+#include "Item_database.hpp"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#define WOW_SIMULATOR_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// tells item databases apart from anything else
+constexpr uint64_t file_magic = 0x316d7469'6d697377; // "wsimitm1"
+
+// the item vectors, in the order of the file
+const std::array<std::vector<Armor> Armory::*, 13> armor_slots{
+    &Armory::helmet_t, &Armory::neck_t,  &Armory::shoulder_t, &Armory::back_t, &Armory::chest_t,
+    &Armory::wrists_t, &Armory::hands_t, &Armory::belt_t,     &Armory::legs_t, &Armory::boots_t,
+    &Armory::ring_t,   &Armory::trinket_t, &Armory::ranged_t};
+
+const std::array<std::vector<Weapon> Armory::*, 8> weapon_slots{
+    &Armory::swords_t,           &Armory::axes_t,
+    &Armory::daggers_t,          &Armory::maces_t,
+    &Armory::fists_t,            &Armory::two_handed_swords_t,
+    &Armory::two_handed_axes_polearm_t, &Armory::two_handed_maces_t};
+
+struct Writer
+{
+    static constexpr bool reading = false;
+
+    template <typename T>
+    void value(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template <typename T>
+    void enumeration(const T& value)
+    {
+        this->value(static_cast<int32_t>(value));
+    }
+
+    void string(const std::string& value)
+    {
+        this->value(static_cast<uint32_t>(value.size()));
+        out.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    template <typename T>
+    uint32_t size(const std::vector<T>& values)
+    {
+        const auto size = static_cast<uint32_t>(values.size());
+        value(size);
+        return size;
+    }
+
+    std::ostream& out;
+};
+
+// reads from memory, every read is checked against the end of the data
+struct Reader
+{
+    static constexpr bool reading = true;
+
+    template <typename T>
+    void value(T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (!take(sizeof(value))) return;
+        std::memcpy(&value, pos - sizeof(value), sizeof(value));
+    }
+
+    template <typename T>
+    void enumeration(T& value)
+    {
+        int32_t raw{};
+        this->value(raw);
+        value = static_cast<T>(raw);
+    }
+
+    void string(std::string& value)
+    {
+        uint32_t size{};
+        this->value(size);
+        if (!take(size)) return;
+        value.assign(pos - size, size);
+    }
+
+    // resizes values to the size in the data, each element a copy of empty
+    template <typename T>
+    uint32_t size(std::vector<T>& values, const T& empty)
+    {
+        uint32_t size{};
+        value(size);
+        // every element takes at least a byte, which rules out sizes of broken data
+        if (size > static_cast<size_t>(end - pos)) ok = false;
+        if (!ok) return 0;
+        values.assign(size, empty);
+        return size;
+    }
+
+    bool take(size_t n)
+    {
+        if (!ok || n > static_cast<size_t>(end - pos))
+        {
+            ok = false;
+            return false;
+        }
+        pos += n;
+        return true;
+    }
+
+    const char* pos;
+    const char* end;
+    bool ok{true};
+};
+
+// the fields of the items, the same for writing and reading. T is the item, const when writing
+
+template <typename Io, typename T>
+void transfer_stats(Io& io, T& attributes, std::enable_if_t<std::is_same_v<std::decay_t<T>, Attributes>>* = nullptr)
+{
+    io.value(attributes.strength);
+    io.value(attributes.agility);
+}
+
+template <typename Io, typename T>
+void transfer_stats(Io& io, T& s, std::enable_if_t<std::is_same_v<std::decay_t<T>, Special_stats>>* = nullptr)
+{
+    io.value(s.critical_strike);
+    io.value(s.hit);
+    io.value(s.attack_power);
+    io.value(s.bonus_attack_power);
+    io.value(s.haste);
+    io.value(s.damage_mod_physical);
+    io.value(s.stat_multiplier);
+    io.value(s.bonus_damage);
+    io.value(s.crit_multiplier);
+    io.value(s.spell_crit);
+    io.value(s.damage_mod_spell);
+    io.value(s.expertise);
+    io.value(s.sword_expertise);
+    io.value(s.mace_expertise);
+    io.value(s.axe_expertise);
+    io.value(s.gear_armor_pen);
+    io.value(s.ap_multiplier);
+    io.value(s.attack_speed);
+}
+
+// the definition of the effect, not its state during a run
+template <typename Io, typename T>
+void transfer_effect(Io& io, T& effect, std::enable_if_t<std::is_same_v<std::decay_t<T>, Hit_effect>>* = nullptr)
+{
+    io.string(effect.name);
+    io.enumeration(effect.type);
+    transfer_stats(io, effect.attribute_boost);
+    transfer_stats(io, effect.special_stats_boost);
+    io.value(effect.damage);
+    io.value(effect.duration);
+    io.value(effect.cooldown);
+    io.value(effect.probability);
+    io.value(effect.proc_type);
+    io.value(effect.max_charges);
+    io.value(effect.armor_reduction);
+    io.value(effect.ppm);
+    io.value(effect.affects_both_weapons);
+    io.value(effect.max_stacks);
+}
+
+template <typename Io, typename T>
+void transfer_effect(Io& io, T& effect, std::enable_if_t<std::is_same_v<std::decay_t<T>, Over_time_effect>>* = nullptr)
+{
+    io.string(effect.name);
+    transfer_stats(io, effect.special_stats);
+    io.value(effect.rage_gain);
+    io.value(effect.damage);
+    io.value(effect.interval);
+    io.value(effect.duration);
+}
+
+template <typename Io, typename T>
+void transfer_effects(Io& io, T& effects)
+{
+    uint32_t size{};
+    if constexpr (Io::reading)
+    {
+        size = io.size(effects, {});
+    }
+    else
+    {
+        size = io.size(effects);
+    }
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        transfer_effect(io, effects[i]);
+    }
+}
+
+template <typename Io, typename T>
+void transfer_effect(Io& io, T& effect, std::enable_if_t<std::is_same_v<std::decay_t<T>, Use_effect>>* = nullptr)
+{
+    io.string(effect.name);
+    io.enumeration(effect.effect_socket);
+    io.value(effect.rage_boost);
+    io.value(effect.duration);
+    io.value(effect.cooldown);
+    io.value(effect.triggers_gcd);
+    transfer_effects(io, effect.hit_effects);
+    transfer_effects(io, effect.over_time_effects);
+    transfer_effect(io, effect.combat_buff);
+}
+
+template <typename Io, typename T>
+void transfer_item(Io& io, T& armor, std::enable_if_t<std::is_same_v<std::decay_t<T>, Armor>>* = nullptr)
+{
+    io.string(armor.name);
+    transfer_stats(io, armor.attributes);
+    transfer_stats(io, armor.special_stats);
+    io.enumeration(armor.socket);
+    io.enumeration(armor.set_name);
+    transfer_effects(io, armor.hit_effects);
+    transfer_effects(io, armor.use_effects);
+}
+
+template <typename Io, typename T>
+void transfer_item(Io& io, T& weapon, std::enable_if_t<std::is_same_v<std::decay_t<T>, Weapon>>* = nullptr)
+{
+    io.string(weapon.name);
+    transfer_stats(io, weapon.attributes);
+    transfer_stats(io, weapon.special_stats);
+    io.value(weapon.swing_speed);
+    io.value(weapon.min_damage);
+    io.value(weapon.max_damage);
+    io.enumeration(weapon.weapon_socket);
+    io.enumeration(weapon.type);
+    transfer_effects(io, weapon.hit_effects);
+    io.enumeration(weapon.set_name);
+    transfer_effects(io, weapon.use_effects);
+    io.enumeration(weapon.socket);
+}
+
+template <typename Io, typename T>
+void transfer_item(Io& io, T& set_bonus, std::enable_if_t<std::is_same_v<std::decay_t<T>, Set_bonus>>* = nullptr)
+{
+    io.enumeration(set_bonus.set);
+    io.value(set_bonus.pieces);
+    io.string(set_bonus.name);
+    transfer_stats(io, set_bonus.attributes);
+    transfer_stats(io, set_bonus.special_stats);
+    transfer_effect(io, set_bonus.hit_effect);
+}
+
+// empty is what a read item starts from, the items have no default constructors
+template <typename Io, typename T, typename Item>
+void transfer_items(Io& io, T& items, const Item& empty)
+{
+    uint32_t size{};
+    if constexpr (Io::reading)
+    {
+        size = io.size(items, empty);
+    }
+    else
+    {
+        size = io.size(items);
+    }
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        transfer_item(io, items[i]);
+    }
+}
+} // namespace
+
+void Item_database::write(const Armory& armory, std::ostream& out)
+{
+    Writer writer{out};
+    writer.value(file_magic);
+    writer.value(version);
+    for (const auto slot : armor_slots)
+    {
+        transfer_items(writer, armory.*slot, Armor::empty(Socket::none));
+    }
+    for (const auto slot : weapon_slots)
+    {
+        transfer_items(writer, armory.*slot, Weapon::empty(Weapon_socket::one_hand));
+    }
+    transfer_items(writer, armory.set_bonuses, Set_bonus{Set::none, 0, ""});
+}
+
+bool Item_database::read(const char* data, size_t size, Armory& armory)
+{
+    Reader reader{data, data + size};
+    uint64_t magic{};
+    uint32_t file_version{};
+    reader.value(magic);
+    reader.value(file_version);
+    if (!reader.ok || magic != file_magic || file_version != version) return false;
+
+    // nothing changes before all of it is read
+    std::array<std::vector<Armor>, armor_slots.size()> armor;
+    std::array<std::vector<Weapon>, weapon_slots.size()> weapons;
+    std::vector<Set_bonus> set_bonuses;
+    for (auto& items : armor)
+    {
+        transfer_items(reader, items, Armor::empty(Socket::none));
+    }
+    for (auto& items : weapons)
+    {
+        transfer_items(reader, items, Weapon::empty(Weapon_socket::one_hand));
+    }
+    transfer_items(reader, set_bonuses, Set_bonus{Set::none, 0, ""});
+    if (!reader.ok || reader.pos != reader.end) return false;
+
+    for (size_t i = 0; i < armor_slots.size(); ++i)
+    {
+        armory.*armor_slots[i] = std::move(armor[i]);
+    }
+    for (size_t i = 0; i < weapon_slots.size(); ++i)
+    {
+        armory.*weapon_slots[i] = std::move(weapons[i]);
+    }
+    armory.set_bonuses = std::move(set_bonuses);
+    armory.index_items();
+    return true;
+}
+
+bool Item_database::load(const std::string& path, Armory& armory)
+{
+#ifdef WOW_SIMULATOR_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat file_stat
+    {
+    };
+    if (::fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    const auto size = static_cast<size_t>(file_stat.st_size);
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) return false;
+    const bool ok = read(static_cast<const char*>(data), size, armory);
+    ::munmap(data, size);
+    return ok;
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    const std::vector<char> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    return read(data.data(), data.size(), armory);
+#endif
+}
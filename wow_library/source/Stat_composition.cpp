@@ -0,0 +1,150 @@
+#include "Stat_composition.hpp"
+
+Stat_composition::Stat_composition(const Armory& armory, const Character& character)
+    : armory_(armory)
+    , attributes_(character.base_attributes)
+    , special_stats_(character.base_special_stats)
+    , one_handed_weapon_specialization_(character.talents.one_handed_weapon_specialization)
+    , two_handed_weapon_specialization_(character.talents.two_handed_weapon_specialization)
+{
+    talent_special_stats_.critical_strike = character.talents.cruelty;
+    talent_special_stats_.hit = character.talents.precision;
+    talent_special_stats_.expertise = character.talents.defiance * 2;
+    talent_special_stats_.ap_multiplier = character.talents.improved_berserker_stance * 0.02;
+
+    for (const auto& buff : character.buffs)
+    {
+        attributes_ += buff.attributes;
+        special_stats_ += buff.special_stats;
+    }
+    if (character.race == Race::draenei && !character.has_buff(armory.buffs.heroic_presence))
+    {
+        attributes_ += armory.buffs.heroic_presence.attributes;
+        special_stats_ += armory.buffs.heroic_presence.special_stats;
+    }
+    has_braided_eternium_chain_buff_ = character.has_buff(armory.buffs.braided_eternium_chain);
+
+    special_stats_ += {3, 0, 0}; // crit from berserker stance
+}
+
+void Stat_composition::add_items(const Character& character)
+{
+    for (const auto& armor : character.armor)
+    {
+        add(armor);
+    }
+    for (const auto& weapon : character.weapons)
+    {
+        add(weapon);
+    }
+    for (const auto& gem : character.gems)
+    {
+        add(gem);
+    }
+}
+
+void Stat_composition::change(const Armor& armor, int n)
+{
+    auto attributes = armor.attributes;
+    auto special_stats = armor.special_stats;
+    if (armor.enchant.type != Enchant::Type::none)
+    {
+        attributes += Armory::get_enchant_attributes(armor.socket, armor.enchant.type);
+        special_stats += Armory::get_enchant_special_stats(armor.socket, armor.enchant.type);
+    }
+    change(attributes, special_stats, n);
+
+    count_set(armor.set_name, n);
+    if (armor.name == "braided_eternium_chain") n_braided_eternium_chains_ += n;
+}
+
+void Stat_composition::change(const Weapon& weapon, int n)
+{
+    auto attributes = weapon.attributes;
+    auto special_stats = weapon.special_stats;
+    if (weapon.enchant.type != Enchant::Type::none)
+    {
+        attributes += Armory::get_enchant_attributes(weapon.socket, weapon.enchant.type);
+        special_stats += Armory::get_enchant_special_stats(weapon.socket, weapon.enchant.type);
+    }
+    if (!weapon.buff.name.empty())
+    {
+        attributes += weapon.buff.attributes;
+        special_stats += weapon.buff.special_stats;
+    }
+    change(attributes, special_stats, n);
+
+    count_set(weapon.set_name, n);
+    n_weapons_ += n;
+}
+
+void Stat_composition::change(const Attributes& attributes, const Special_stats& special_stats, int n)
+{
+    // taking off is the inverse of putting on, also for the multiplicative stats
+    if (n > 0)
+    {
+        attributes_ += attributes;
+        special_stats_ += special_stats;
+    }
+    else
+    {
+        attributes_ += attributes * -1;
+        special_stats_ -= special_stats;
+    }
+}
+
+void Stat_composition::count_set(Set set, int n)
+{
+    // items of unknown sets (e.g. from a newer item database) have no bonuses
+    const auto i = static_cast<size_t>(set);
+    if (i < set_counts_.size()) set_counts_[i] += n;
+}
+
+bool Stat_composition::has_set_bonus(const Set_bonus& set_bonus) const
+{
+    const auto i = static_cast<size_t>(set_bonus.set);
+    return i < set_counts_.size() && set_counts_[i] >= set_bonus.pieces;
+}
+
+void Stat_composition::total_stats(Attributes& total_attributes, Special_stats& total_special_stats) const
+{
+    total_attributes = attributes_;
+    total_special_stats = special_stats_;
+
+    for (const auto& set_bonus : armory_.set_bonuses)
+    {
+        if (has_set_bonus(set_bonus))
+        {
+            total_attributes += set_bonus.attributes;
+            total_special_stats += set_bonus.special_stats;
+        }
+    }
+
+    if (adds_braided_eternium_chain_buff())
+    {
+        total_attributes += armory_.buffs.braided_eternium_chain.attributes;
+        total_special_stats += armory_.buffs.braided_eternium_chain.special_stats;
+    }
+
+    auto talent_special_stats = talent_special_stats_;
+    if (n_weapons_ == 2)
+    {
+        talent_special_stats.damage_mod_physical = one_handed_weapon_specialization_ * 0.02;
+    }
+    else
+    {
+        talent_special_stats.damage_mod_physical = two_handed_weapon_specialization_ * 0.01;
+    }
+    total_special_stats += talent_special_stats;
+
+    total_special_stats += total_attributes.to_special_stats(total_special_stats);
+    total_attributes = total_attributes.multiply(total_special_stats);
+}
+
+Special_stats Stat_composition::total_special_stats() const
+{
+    Attributes total_attributes{};
+    Special_stats total_special_stats{};
+    total_stats(total_attributes, total_special_stats);
+    return total_special_stats;
+}
@@ -1,7 +1,16 @@
 #include "Armory.hpp"
+#include "Character.hpp"
+#include "Item_database.hpp"
+#include "Stat_composition.hpp"
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
 /*
 TEST(TestSuite, test_unused_special_stats)
 {
@@ -29,7 +38,10 @@ TEST(TestSuite, test_unused_special_stats)
 
 TEST(TestSuite, test_armory)
 {
-    Armory armory;
+    // the items come from the item database of the build
+    ASSERT_TRUE(Armory{}.fists_t.empty());
+    Armory armory = Armory::shared();
+    ASSERT_FALSE(armory.fists_t.empty());
 
     for (const auto& w : armory.get_weapon_in_socket(Weapon_socket::main_hand))
     {
@@ -71,4 +83,217 @@ TEST(TestSuite, test_armory)
         by_type->clear();
     }
     ASSERT_TRUE(armory.fists_t.empty());
-}
\ No newline at end of file
+}
+
+TEST(TestSuite, test_find_items)
+{
+    const auto& armory = Armory::shared();
+    ASSERT_EQ(&armory, &Armory::shared());
+
+    // the first item of each name, as a search through the socket would find it
+    for (const auto socket : {Socket::head, Socket::neck, Socket::shoulder, Socket::back, Socket::chest, Socket::wrist,
+                              Socket::hands, Socket::belt, Socket::legs, Socket::boots, Socket::ring, Socket::trinket,
+                              Socket::ranged})
+    {
+        const auto& items = armory.get_items_in_socket(socket);
+        for (const auto& item : items)
+        {
+            const auto first = std::find_if(items.begin(), items.end(), [&item](const Armor& a) { return a.name == item.name; });
+            const auto found = armory.find_armor(socket, item.name);
+            ASSERT_EQ(found.name, item.name);
+            ASSERT_EQ(found.special_stats.attack_power, first->special_stats.attack_power);
+        }
+    }
+    for (const auto weapon_socket : {Weapon_socket::main_hand, Weapon_socket::off_hand, Weapon_socket::two_hand})
+    {
+        for (const auto& weapon : armory.get_weapon_in_socket(weapon_socket))
+        {
+            ASSERT_EQ(armory.find_weapon(weapon_socket, weapon.name).name, weapon.name);
+        }
+    }
+    ASSERT_EQ(armory.find_armor(Socket::head, "none").name, Armor::empty(Socket::head).name);
+
+    // a copy finds the same items, also after its items changed
+    auto copy = armory;
+    ASSERT_EQ(copy.find_weapon(Weapon_socket::one_hand, "dragonstrike").name, "dragonstrike");
+    copy.maces_t.erase(copy.maces_t.begin());
+    ASSERT_EQ(copy.find_weapon(Weapon_socket::one_hand, "dragonstrike").name, "dragonstrike");
+    ASSERT_EQ(copy.find_weapon(Weapon_socket::one_hand, "dragonstrike").max_damage,
+              armory.find_weapon(Weapon_socket::one_hand, "dragonstrike").max_damage);
+}
+
+TEST(TestSuite, test_item_database)
+{
+    const auto& armory = Armory::shared();
+    std::stringstream stream;
+    Item_database::write(armory, stream);
+    const std::string data = stream.str();
+
+    Armory read{};
+    ASSERT_TRUE(Item_database::read(data.data(), data.size(), read));
+    ASSERT_FALSE(armory.trinket_t.empty());
+    ASSERT_EQ(read.trinket_t.size(), armory.trinket_t.size());
+    ASSERT_EQ(read.maces_t.size(), armory.maces_t.size());
+    ASSERT_EQ(read.set_bonuses.size(), armory.set_bonuses.size());
+
+    const auto brooch = read.find_armor(Socket::trinket, "bloodlust_brooch");
+    const auto expected_brooch = armory.find_armor(Socket::trinket, "bloodlust_brooch");
+    ASSERT_EQ(brooch.special_stats.attack_power, expected_brooch.special_stats.attack_power);
+    ASSERT_EQ(brooch.use_effects.size(), 1);
+    ASSERT_EQ(brooch.use_effects[0].combat_buff.special_stats_boost.attack_power,
+              expected_brooch.use_effects[0].combat_buff.special_stats_boost.attack_power);
+    ASSERT_EQ(brooch.use_effects[0].cooldown, expected_brooch.use_effects[0].cooldown);
+
+    const auto dragonstrike = read.find_weapon(Weapon_socket::one_hand, "dragonstrike");
+    const auto expected_dragonstrike = armory.find_weapon(Weapon_socket::one_hand, "dragonstrike");
+    ASSERT_EQ(dragonstrike.max_damage, expected_dragonstrike.max_damage);
+    ASSERT_EQ(dragonstrike.type, expected_dragonstrike.type);
+    ASSERT_EQ(dragonstrike.hit_effects.size(), expected_dragonstrike.hit_effects.size());
+    ASSERT_EQ(dragonstrike.hit_effects[0].ppm, expected_dragonstrike.hit_effects[0].ppm);
+
+    // broken data changes nothing
+    Armory unchanged = armory;
+    ASSERT_FALSE(Item_database::read(data.data(), data.size() - 1, unchanged));
+    ASSERT_FALSE(Item_database::read(data.data() + 1, data.size() - 1, unchanged));
+    ASSERT_EQ(unchanged.trinket_t.size(), armory.trinket_t.size());
+
+    const std::string path = testing::TempDir() + "test_item_database.bin";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << data;
+    }
+    Armory loaded{};
+    ASSERT_TRUE(Item_database::load(path, loaded));
+    ASSERT_EQ(loaded.swords_t.size(), armory.swords_t.size());
+    ASSERT_FALSE(Item_database::load(path + ".missing", loaded));
+    std::remove(path.c_str());
+
+    // the environment overrides every other place, the file of the build is the last resort
+    const char* environment = std::getenv("WOW_SIMULATOR_ITEM_DATABASE");
+    const std::string previous = environment ? environment : "";
+    setenv("WOW_SIMULATOR_ITEM_DATABASE", path.c_str(), 1);
+    EXPECT_EQ(Armory::item_database_paths(), std::vector<std::string>{path});
+    unsetenv("WOW_SIMULATOR_ITEM_DATABASE");
+    EXPECT_EQ(Armory::item_database_paths().back(), WOW_SIMULATOR_ITEM_DATABASE);
+    if (environment) setenv("WOW_SIMULATOR_ITEM_DATABASE", previous.c_str(), 1);
+}
+
+TEST(TestSuite, test_stat_composition)
+{
+    const auto& armory = Armory::shared();
+    Character character{Race::draenei, 70};
+    for (const auto socket : {Socket::head, Socket::neck, Socket::shoulder, Socket::back, Socket::chest, Socket::wrist,
+                              Socket::hands, Socket::belt, Socket::legs, Socket::boots, Socket::ring, Socket::ring,
+                              Socket::trinket, Socket::trinket, Socket::ranged})
+    {
+        character.equip_armor(Armor::empty(socket));
+    }
+    Armory::change_armor(character.armor, armory.find_armor(Socket::head, "ragesteel_helm"));
+    const auto dragonstrike = armory.find_weapon(Weapon_socket::one_hand, "dragonstrike");
+    character.equip_weapon(dragonstrike, dragonstrike);
+    character.add_buff(armory.buffs.blessing_of_kings);
+    character.talents.improved_berserker_stance = 5;
+    character.talents.one_handed_weapon_specialization = 5;
+    armory.compute_total_stats(character);
+
+    Stat_composition composition{armory, character};
+    for (const auto& armor : character.armor) composition.add(armor);
+    for (const auto& weapon : character.weapons) composition.add(weapon);
+
+    auto expect_same_stats = [&]() {
+        armory.compute_total_stats(character);
+        const auto special_stats = composition.total_special_stats();
+        EXPECT_NEAR(special_stats.attack_power, character.total_special_stats.attack_power, 1e-6);
+        EXPECT_NEAR(special_stats.critical_strike, character.total_special_stats.critical_strike, 1e-9);
+        EXPECT_NEAR(special_stats.hit, character.total_special_stats.hit, 1e-9);
+        EXPECT_NEAR(special_stats.damage_mod_physical, character.total_special_stats.damage_mod_physical, 1e-9);
+    };
+
+    // every neck (the braided eternium chain adds a buff) and then the second piece of ragesteel
+    const auto no_neck = Armor::empty(Socket::neck);
+    const Armor* worn = &no_neck;
+    for (const auto& neck : armory.get_items_in_socket(Socket::neck))
+    {
+        composition.swap(*worn, neck);
+        Armory::change_armor(character.armor, neck);
+        worn = &neck;
+        expect_same_stats();
+        character.buffs.erase(std::remove_if(character.buffs.begin(), character.buffs.end(),
+                                             [](const Buff& b) { return b.name == "braided_eternium_chain"; }),
+                              character.buffs.end());
+    }
+    const auto gloves = armory.find_armor(Socket::hands, "ragesteel_gloves");
+    ASSERT_FALSE(composition.has_set_bonus(armory.set_bonuses[0]));
+    composition.swap(Armor::empty(Socket::hands), gloves);
+    Armory::change_armor(character.armor, gloves);
+    ASSERT_TRUE(composition.has_set_bonus(armory.set_bonuses[0]));
+    expect_same_stats();
+    ASSERT_EQ(character.set_bonuses.size(), 1);
+
+    // a two-hander takes the other weapon specialization
+    composition.remove(character.weapons[0]);
+    composition.remove(character.weapons[1]);
+    character.weapons.pop_back();
+    Armory::change_weapon(character.weapons, armory.find_weapon(Weapon_socket::two_hand, "lionheart_executioner"),
+                          Socket::main_hand);
+    composition.add(character.weapons[0]);
+    expect_same_stats();
+}
+
+TEST(TestSuite, test_change_with_composition)
+{
+    const auto& armory = Armory::shared();
+    Character character{Race::human, 70};
+    for (const auto socket : {Socket::head, Socket::neck, Socket::shoulder, Socket::back, Socket::chest, Socket::wrist,
+                              Socket::hands, Socket::belt, Socket::legs, Socket::boots, Socket::ring, Socket::ring,
+                              Socket::trinket, Socket::trinket, Socket::ranged})
+    {
+        character.equip_armor(Armor::empty(socket));
+    }
+    const auto dragonstrike = armory.find_weapon(Weapon_socket::one_hand, "dragonstrike");
+    character.equip_weapon(dragonstrike, dragonstrike);
+    character.weapons[0].enchant = Enchant{Enchant::Type::mongoose};
+    character.add_buff(armory.buffs.battle_shout);
+    armory.compute_total_stats(character);
+
+    Stat_composition composition{armory, character};
+    composition.add_items(character);
+
+    // the same as dressing the character and computing it again, also where the items have effects
+    auto expect_same_character = [&]() {
+        auto computed = character;
+        armory.compute_total_stats(computed);
+        EXPECT_NEAR(character.total_special_stats.attack_power, computed.total_special_stats.attack_power, 1e-6);
+        EXPECT_NEAR(character.total_special_stats.critical_strike, computed.total_special_stats.critical_strike, 1e-9);
+        EXPECT_NEAR(character.total_special_stats.hit, computed.total_special_stats.hit, 1e-9);
+        EXPECT_NEAR(character.total_attributes.agility, computed.total_attributes.agility, 1e-6);
+        ASSERT_EQ(character.weapons.size(), computed.weapons.size());
+        for (size_t i = 0; i < character.weapons.size(); ++i)
+        {
+            EXPECT_EQ(character.weapons[i].hit_effects.size(), computed.weapons[i].hit_effects.size());
+        }
+        EXPECT_EQ(character.use_effects.size(), computed.use_effects.size());
+        EXPECT_EQ(character.set_bonuses.size(), computed.set_bonuses.size());
+    };
+
+    for (const auto& ring : armory.get_items_in_socket(Socket::ring))
+    {
+        armory.change_armor(character, composition, ring, false);
+        expect_same_character();
+    }
+    for (const auto& trinket : armory.get_items_in_socket(Socket::trinket))
+    {
+        armory.change_armor(character, composition, trinket, true);
+        expect_same_character();
+    }
+    for (const auto& weapon : armory.get_weapon_in_socket(Weapon_socket::off_hand))
+    {
+        armory.change_weapon(character, composition, weapon, Socket::off_hand);
+        expect_same_character();
+    }
+    for (const auto& weapon : armory.get_weapon_in_socket(Weapon_socket::main_hand))
+    {
+        armory.change_weapon(character, composition, weapon, Socket::main_hand);
+        expect_same_character();
+    }
+}
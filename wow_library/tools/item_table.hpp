@@ -0,0 +1,10 @@
+#ifndef WOW_SIMULATOR_ITEM_TABLE_HPP
+#define WOW_SIMULATOR_ITEM_TABLE_HPP
+
+#include "Armory.hpp"
+
+// the items as written to the item database (see write_item_database). edit them here, the simulator itself only
+// reads the database
+void add_item_table(Armory& armory);
+
+#endif // WOW_SIMULATOR_ITEM_TABLE_HPP
@@ -0,0 +1,27 @@
+#include "Item_database.hpp"
+#include "item_table.hpp"
+
+#include <fstream>
+#include <iostream>
+
+// writes the item table to the item database file, which the build puts where Armory::shared() reads it
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <item database file>\n";
+        return 1;
+    }
+
+    Armory armory{};
+    add_item_table(armory);
+
+    std::ofstream file(argv[1], std::ios::binary);
+    Item_database::write(armory, file);
+    if (!file)
+    {
+        std::cerr << "could not write " << argv[1] << "\n";
+        return 1;
+    }
+    return 0;
+}